@@ -40,10 +40,15 @@ namespace rhoban_ssl
 {
 namespace ai
 {
-AI::AI(std::string manager_name) : running_(true)
+AI::AI(std::string manager_name) : running_(true), orca_(ORCA_TIME_HORIZON, ai::Config::period)
 {
   initRobotBehaviors();
 
+  if (ai::Config::behavior_threads > 0)
+  {
+    behavior_pool_.reset(new WorkerPool(ai::Config::behavior_threads));
+  }
+
   manual_manager_ = manager::Factory::constructManager(manager::names::MANUAL);
 
   setManager(manager_name);
@@ -62,6 +67,7 @@ bool AI::runTask()
   {
     strategy_manager_->removeInvalidRobots();
     strategy_manager_->update();
+    strategy_manager_->refineCurrentStrategies(Data::get()->time.now(), ai::Config::refinement_budget);
     strategy_manager_->assignBehaviorToRobots(robot_behaviors_, Data::get()->time.now(), 0.0);
     updateRobots();
   }
@@ -78,14 +84,9 @@ float sign(float x)
   return -1.0;
 }
 
-void AI::preventCollision(int robot_id, Control& ctrl)
+bool AI::collisionIsDetected(int robot_id, const Control& ctrl)
 {
-  const data::Robot& robot = Data::get()->robots[Ally][robot_id];
-
   const Vector2d& ctrl_velocity = ctrl.linear_velocity;
-  if (robot.isActive() == false)
-    return;
-  Vector2d robot_velocity = robot.getMovement().linearVelocity(Data::get()->time.now());
 
   bool collision_is_detected = false;
 
@@ -126,7 +127,18 @@ void AI::preventCollision(int robot_id, Control& ctrl)
       }
   }
   */
-  if (collision_is_detected)
+  return collision_is_detected;
+}
+
+void AI::preventCollision(int robot_id, Control& ctrl)
+{
+  const data::Robot& robot = Data::get()->robots[Ally][robot_id];
+
+  if (robot.isActive() == false)
+    return;
+  Vector2d robot_velocity = robot.getMovement().linearVelocity(Data::get()->time.now());
+
+  if (collisionIsDetected(robot_id, ctrl))
   {
     double robot_velocity_norm = robot_velocity.norm();
     double velocity_increase = 0.0;
@@ -201,15 +213,34 @@ void AI::prepareToSendControl(int robot_id, Control& ctrl)
   if (Data::get()->robots[Ally][robot_id].isActive() == false)
     return;
 
-  preventCollision(robot_id, ctrl);
+  if (ai::Config::orca && orca_agent_of_robot_[robot_id] >= 0)
+  {
+    // The collision free velocity replaces the emergency brake
+    ctrl.linear_velocity = orca_velocities_[orca_agent_of_robot_[robot_id]];
+  }
+
+  if (ai::Config::control_rate > 0)
+  {
+    // The control loop brakes and changes the frame of the control at its own rate,
+    // with the freshest orientation of the robot.
+    Data::get()->shared_data.final_control_for_robots[robot_id].collision_is_detected =
+        !ai::Config::orca && collisionIsDetected(robot_id, ctrl);
+    return;
+  }
+
+  if (!ai::Config::orca)
+  {
+    preventCollision(robot_id, ctrl);
+  }
 
   //  if (Data::get()->referee.allyOnPositiveHalf())
   //  {
   //    ctrl.linear_velocity[0] *= -1;
   //    ctrl.angular_velocity += M_PI;
   //  }
-  ctrl.changeToRelativeControl(
-      Data::get()->robots[Ally][robot_id].getMovement().angularPosition(Data::get()->time.now()), ai::Config::period);
+  double actuation_time = Data::get()->latency.actuationTime(Data::get()->time.now());
+  ctrl.changeToRelativeControl(Data::get()->robots[Ally][robot_id].getMovement().angularPosition(actuation_time),
+                               ai::Config::period);
 }
 
 Control AI::getRobotControl(robot_behavior::RobotBehavior& robot_behavior, data::Robot& robot)
@@ -228,24 +259,22 @@ Control AI::getRobotControl(robot_behavior::RobotBehavior& robot_behavior, data:
 
 void AI::initRobotBehaviors()
 {
-  for (int k = 0; k < ai::Config::NB_OF_ROBOTS_BY_TEAM; k++)
+  for (std::shared_ptr<robot_behavior::RobotBehavior>& robot_behavior : robot_behaviors_)
   {
-    robot_behaviors_[k] = std::shared_ptr<robot_behavior::RobotBehavior>(new robot_behavior::DoNothing);
+    robot_behavior = std::shared_ptr<robot_behavior::RobotBehavior>(new robot_behavior::DoNothing);
   }
 }
 
 void AI::setManager(std::string managerName)
 {
   std::vector<int> robot_ids(robot_behaviors_.size());
-  uint i = 0;
-  for (auto elem : robot_behaviors_)
+  for (uint i = 0; i < robot_ids.size(); i++)
   {
-    robot_ids[i] = elem.first;
-    i++;
+    robot_ids[i] = i;
   }
 
   std::cout << "Setting the manager to: " << managerName << std::endl;
-  std::cout << "with : " << i << " robots" << std::endl;
+  std::cout << "with : " << robot_ids.size() << " robots" << std::endl;
   if (managerName == manager::names::MANUAL)
   {
     strategy_manager_ = manual_manager_;
@@ -258,6 +287,14 @@ void AI::setManager(std::string managerName)
   // Data::get()->robots[Ally][ai::Config::default_goalie_id].is_goalie = true;
   Data::get()->referee.teams_info->goalkeeper_number;
   strategy_manager_->declareTeamIds(robot_ids);
+
+  if (!ai::Config::prewarm_strategies.empty())
+  {
+    rhoban_utils::TimeStamp start = rhoban_utils::TimeStamp::now();
+    unsigned int nb_prewarmed = strategy_manager_->prewarmStrategies(ai::Config::prewarm_strategies);
+    std::cout << "Prewarmed " << nb_prewarmed << " strategies in "
+              << 1000 * diffSec(start, rhoban_utils::TimeStamp::now()) << " ms" << std::endl;
+  }
 }
 
 void AI::startManager()
@@ -284,32 +321,103 @@ void AI::stopStrategyManager()
   strategy_manager_->clearStrategyAssignement();
 }
 
+void AI::updateRobot(int robot_id, double time)
+{
+  const data::Ball& ball = Data::get()->ball;
+  SharedData::FinalControl& final_control = Data::get()->shared_data.final_control_for_robots[robot_id];
+
+  data::Robot& robot = Data::get()->robots[Ally][robot_id];
+  assert(robot.id == (uint)robot_id);
+  robot_behavior::RobotBehavior& robot_behavior = *robot_behaviors_[robot_id];
+  robot_behavior.update(time, robot, ball);
+  if (final_control.is_disabled_by_viewer)
+  {
+    final_control.control = Control::makeDesactivated();
+  }
+  else if (!final_control.is_manually_controled_by_viewer)
+  {
+    final_control.control = getRobotControl(robot_behavior, robot);
+  }
+}
+
 void AI::updateRobots()
 {
-  //  double time = Data::get()->ai_data.time;
-  data::Ball& ball = Data::get()->ball;
+  // the behaviors work on the state predicted when their commands will be executed
+  double time = Data::get()->latency.actuationTime(Data::get()->time.now());
+
+  if (behavior_pool_)
+  {
+    // Each job only writes the final control of its robot, so the controls are the same
+    // as the ones computed one after another.
+    behavior_pool_->run(ai::Config::NB_OF_ROBOTS_BY_TEAM, [this, time](unsigned int robot_id) {
+      updateRobot(robot_id, time);
+    });
+  }
+  else
+  {
+    for (int robot_id = 0; robot_id < ai::Config::NB_OF_ROBOTS_BY_TEAM; robot_id++)
+    {
+      updateRobot(robot_id, time);
+    }
+  }
+
+  // The controls of all the robots are known: they can avoid each other together.
+  if (ai::Config::orca)
+  {
+    computeOrcaVelocities();
+  }
 
   for (int robot_id = 0; robot_id < ai::Config::NB_OF_ROBOTS_BY_TEAM; robot_id++)
   {
     SharedData::FinalControl& final_control = Data::get()->shared_data.final_control_for_robots[robot_id];
+    if (!final_control.is_disabled_by_viewer && !final_control.is_manually_controled_by_viewer)
+    {
+      prepareToSendControl(robot_id, final_control.control);
+    }
+  }
+}
 
-    data::Robot& robot = Data::get()->robots[Ally][robot_id];
-    assert(robot.id == (uint)robot_id);
-    robot_behavior::RobotBehavior& robot_behavior = *(robot_behaviors_[robot_id]);
-    robot_behavior.update(Data::get()->time.now(), robot, ball);
-    if (final_control.is_disabled_by_viewer)
+void AI::computeOrcaVelocities()
+{
+  double time = Data::get()->latency.actuationTime(Data::get()->time.now());
+  orca_agents_.clear();
+  for (int robot_id = 0; robot_id < ai::Config::NB_OF_ROBOTS_BY_TEAM; robot_id++)
+  {
+    orca_agent_of_robot_[robot_id] = -1;
+  }
+
+  for (const std::pair<Team, data::Robot*>& elem : Data::get()->all_robots)
+  {
+    const data::Robot& robot = *elem.second;
+    if (not(robot.isActive()))
     {
-      final_control.control = Control::makeDesactivated();
+      continue;
     }
-    else if (!final_control.is_manually_controled_by_viewer)
+    control::Orca::Agent agent;
+    agent.position = robot.getMovement().linearPosition(time);
+    agent.velocity = robot.getMovement().linearVelocity(time);
+    agent.preferred_velocity = agent.velocity;
+    // Each robot takes half of the security distance
+    agent.radius = ai::Config::robot_radius + ai::Config::radius_security_for_collision / 2.0;
+    agent.max_velocity = ai::Config::translation_velocity_limit;
+    agent.cooperative = false;
+
+    if (elem.first == Ally)
     {
-      data::Robot& robot = Data::get()->robots[Ally][robot_id];
-
-      robot_behavior::RobotBehavior& robot_behavior = *(robot_behaviors_[robot_id]);
-      final_control.control = getRobotControl(robot_behavior, robot);
-      prepareToSendControl(robot_id, final_control.control);
+      const SharedData::FinalControl& final_control = Data::get()->shared_data.final_control_for_robots[robot.id];
+      const Control& ctrl = final_control.control;
+      if (!final_control.is_disabled_by_viewer && !final_control.is_manually_controled_by_viewer && ctrl.active &&
+          !ctrl.ignore)
+      {
+        agent.preferred_velocity = ctrl.linear_velocity;
+        agent.cooperative = true;
+        orca_agent_of_robot_[robot.id] = orca_agents_.size();
+      }
     }
+    orca_agents_.push_back(agent);
   }
+
+  orca_.computeVelocities(orca_agents_, orca_velocities_);
 }
 
 void AI::stop()
@@ -322,7 +430,7 @@ rhoban_ssl::annotations::Annotations AI::getRobotBehaviorAnnotations() const
   rhoban_ssl::annotations::Annotations annotations;
   for (int robot_id = 0; robot_id < ai::Config::NB_OF_ROBOTS_BY_TEAM; robot_id++)
   {
-    const robot_behavior::RobotBehavior& robot_behavior = *(robot_behaviors_.at(robot_id));
+    const robot_behavior::RobotBehavior& robot_behavior = *robot_behaviors_[robot_id];
     annotations.addAnnotations(robot_behavior.getAnnotations());
   }
   return annotations;
@@ -380,16 +488,22 @@ Json::Value AI::getAnnotations() const
   Json::Value json = Json::Value();
   annotations::Annotations annotations = annotations::Annotations();
 
-  annotations.addAnnotations(strategy_manager_->getAnnotations());
-  annotations.addAnnotations(getRobotBehaviorAnnotations());
+  collectAnnotations(annotations);
 
   json["annotations"] = annotations.toJson();
   return json;
 }
 
-std::string AI::getRobotBehaviorOf(uint robot_number)
+void AI::collectAnnotations(annotations::Annotations& annotations) const
+{
+  annotations.addAnnotations(strategy_manager_->getAnnotations());
+  annotations.addAnnotations(getRobotBehaviorAnnotations());
+}
+
+const std::string& AI::getRobotBehaviorOf(uint robot_number)
 {
-  return robot_behaviors_[int(robot_number)].get()->name;
+  assert(robot_number < robot_behaviors_.size());
+  return robot_behaviors_[robot_number]->name;
 }
 
 std::string AI::getStrategyOf(uint robot_number)
@@ -27,6 +27,9 @@
 #include <core/machine_state.h>
 #include <manager/manager.h>
 #include <annotations/annotations.h>
+#include <control/orca.h>
+#include <core/worker_pool.h>
+#include <memory>
 
 namespace rhoban_ssl
 {
@@ -116,13 +119,21 @@ public:
    */
   Json::Value getAnnotations() const;
 
+  /**
+   * @brief Appends the annotations of the manager and of the robot behaviors.
+   *
+   * Only the shapes pointers are copied, no json is built.
+   * @param annotations
+   */
+  void collectAnnotations(annotations::Annotations& annotations) const;
+
   /**
    * @brief Returns the name of the robotbehavior assigned to the robot with the number
    * given in parameter.
    * @param robot_number
    * @return the name of a robotbehavior.
    */
-  std::string getRobotBehaviorOf(uint robot_number);
+  const std::string& getRobotBehaviorOf(uint robot_number);
 
   /**
    * @brief Returns the strategy that chooses the robotBehavior of the robot with
@@ -165,16 +176,43 @@ private:
   std::shared_ptr<manager::Manager> strategy_manager_;
   std::shared_ptr<manager::Manager> manual_manager_;
 
-  std::map<int, std::shared_ptr<robot_behavior::RobotBehavior> > robot_behaviors_;
+  robot_behavior::RobotBehaviors robot_behaviors_;
+  // updates the behaviors concurrently, null if ai::Config::behavior_threads is 0
+  std::unique_ptr<WorkerPool> behavior_pool_;
+
+  // time (s) during which ORCA avoids the collisions
+  const double ORCA_TIME_HORIZON = 0.5;
+  control::Orca orca_;
+  std::vector<control::Orca::Agent> orca_agents_;
+  std::vector<Vector2d> orca_velocities_;
+  // index of the agent of each allied robot controlled by the ai, -1 if there is none
+  int orca_agent_of_robot_[ai::Config::NB_OF_ROBOTS_BY_TEAM];
 
   Control getRobotControl(robot_behavior::RobotBehavior& robot_behavior, data::Robot& robot);
 
   void initRobotBehaviors();
 
   void updateRobots();
+
+  /**
+   * @brief Updates the behavior of a robot and computes its control.
+   *
+   * It may run concurrently for different robots (see ai::Config::behavior_threads): it only writes
+   * the final control of the robot.
+   */
+  void updateRobot(int robot_id, double time);
   void prepareToSendControl(int robot_id, Control& control);
+  bool collisionIsDetected(int robot_id, const Control& ctrl);
   void preventCollision(int robot_id, Control& ctrl);
 
+  /**
+   * @brief Computes the collision free velocities of the allied robots controlled by the ai,
+   * from the velocities of their controls (ORCA, the opponents are obstacles that don't cooperate).
+   *
+   * It runs once per tick, before prepareToSendControl() which uses the new velocities.
+   */
+  void computeOrcaVelocities();
+
   rhoban_ssl::annotations::Annotations getRobotBehaviorAnnotations() const;
 
 public:
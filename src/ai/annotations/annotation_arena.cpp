@@ -0,0 +1,91 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "annotation_arena.h"
+
+namespace rhoban_ssl
+{
+namespace annotations
+{
+AnnotationArena::AnnotationArena() : free_(nullptr), nb_allocated_(0), nb_used_(0)
+{
+}
+
+AnnotationArena& AnnotationArena::get()
+{
+  // never destroyed: static annotations may release their chunks at exit.
+  static AnnotationArena* arena = new AnnotationArena();
+  return *arena;
+}
+
+ShapeChunk* AnnotationArena::acquire()
+{
+  ShapeChunk* chunk;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    nb_used_++;
+    if (free_ != nullptr)
+    {
+      chunk = free_;
+      free_ = chunk->next;
+    }
+    else
+    {
+      nb_allocated_++;
+      chunk = new ShapeChunk;
+    }
+  }
+  chunk->size = 0;
+  chunk->next = nullptr;
+  return chunk;
+}
+
+void AnnotationArena::release(ShapeChunk* first)
+{
+  if (first == nullptr)
+    return;
+
+  unsigned long nb_chunks = 1;
+  ShapeChunk* last = first;
+  while (last->next != nullptr)
+  {
+    last = last->next;
+    nb_chunks++;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  last->next = free_;
+  free_ = first;
+  nb_used_ -= nb_chunks;
+}
+
+unsigned long AnnotationArena::nbAllocatedChunks() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return nb_allocated_;
+}
+
+unsigned long AnnotationArena::nbUsedChunks() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return nb_used_;
+}
+
+}  // namespace annotations
+}  // namespace rhoban_ssl
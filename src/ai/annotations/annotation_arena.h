@@ -0,0 +1,83 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "shape_record.h"
+#include <mutex>
+
+namespace rhoban_ssl
+{
+namespace annotations
+{
+/**
+ * @brief A fixed size block of shapes, the annotations are chains of chunks.
+ */
+struct ShapeChunk
+{
+  static constexpr unsigned int CAPACITY = 32;
+
+  ShapeRecord records[CAPACITY];
+  unsigned int size;
+  ShapeChunk* next;
+};
+
+/**
+ * @brief The pool of chunks shared by all the annotations.
+ *
+ * The chunks released by the annotations (cleared or destroyed) are kept in a free list
+ * and reused by the next ones, so once the pool has grown to the number of shapes
+ * drawn in a tick, building the annotations of a tick does no allocation.
+ */
+class AnnotationArena
+{
+public:
+  static AnnotationArena& get();
+
+  /**
+   * @brief Returns an empty chunk.
+   */
+  ShapeChunk* acquire();
+
+  /**
+   * @brief Gives back a chain of chunks.
+   * @param first the first chunk of the chain (can be nullptr)
+   */
+  void release(ShapeChunk* first);
+
+  /**
+   * @brief Number of chunks allocated since the start.
+   */
+  unsigned long nbAllocatedChunks() const;
+
+  /**
+   * @brief Number of chunks used by the annotations.
+   */
+  unsigned long nbUsedChunks() const;
+
+private:
+  AnnotationArena();
+
+  mutable std::mutex mutex_;
+  ShapeChunk* free_;
+  unsigned long nb_allocated_;
+  unsigned long nb_used_;
+};
+
+}  // namespace annotations
+}  // namespace rhoban_ssl
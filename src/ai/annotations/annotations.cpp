@@ -21,44 +21,226 @@
 
 #include "annotations.h"
 #include <debug.h>
+#include <cassert>
+#include <cstring>
 
 namespace rhoban_ssl
 {
 namespace annotations
 {
-Annotations::Annotations() : json_(Json::arrayValue)
+namespace
 {
+Json::Value colorToJson(ColorId color)
+{
+  return Json::Value(ColorTable::name(color));
 }
 
-Json::Value Annotations::toJson()
+Json::Value recordToJson(const ShapeRecord& record)
 {
-  for (auto it = shapes_.begin(); it != shapes_.end(); it++)
+  Json::Value annotation;
+  const float* c = record.coordinates;
+  switch (record.type)
   {
-    json_.append((*it)->toJson());
+    case ShapeRecord::CIRCLE:
+      annotation["type"] = "circle";
+      annotation["circle"]["x"] = c[0];
+      annotation["circle"]["y"] = c[1];
+      annotation["circle"]["radius"] = record.radius;
+      annotation["fill_color"] = colorToJson(record.fill_color);
+      break;
+    case ShapeRecord::CROSS:
+      annotation["type"] = "cross";
+      annotation["origin"]["x"] = c[0];
+      annotation["origin"]["y"] = c[1];
+      break;
+    case ShapeRecord::ARROW:
+      annotation["type"] = "arrow";
+      annotation["origin"]["x"] = c[0];
+      annotation["origin"]["y"] = c[1];
+      annotation["end"]["x"] = c[2];
+      annotation["end"]["y"] = c[3];
+      break;
+    default:
+    {
+      annotation["type"] = "polygon";
+      Json::Value& points = annotation["points"];
+      points = Json::Value(Json::arrayValue);
+      for (uint i = 0; i < record.nb_points; ++i)
+      {
+        points[i]["x"] = c[2 * i];
+        points[i]["y"] = c[2 * i + 1];
+      }
+      annotation["fill_color"] = colorToJson(record.fill_color);
+    }
   }
-  return json_;
+  annotation["stroke_color"] = colorToJson(record.stroke_color);
+  annotation["dashed"] = record.dashed;
+  return annotation;
+}
+
+void recordToProtobuf(const ShapeRecord& record, viewer_proto::Annotation& annotation)
+{
+  static const viewer_proto::Annotation::Type types[] = { viewer_proto::Annotation::CIRCLE,
+                                                          viewer_proto::Annotation::CROSS,
+                                                          viewer_proto::Annotation::ARROW,
+                                                          viewer_proto::Annotation::POLYGON };
+  annotation.set_type(types[record.type]);
+  for (uint i = 0; i < 2u * record.nb_points; ++i)
+  {
+    annotation.add_points(record.coordinates[i]);
+  }
+  if (record.type == ShapeRecord::CIRCLE)
+  {
+    annotation.set_radius(record.radius);
+  }
+  if (record.type == ShapeRecord::CIRCLE || record.type == ShapeRecord::POLYGON)
+  {
+    annotation.set_fillcolor(ColorTable::name(record.fill_color));
+  }
+  annotation.set_strokecolor(ColorTable::name(record.stroke_color));
+  annotation.set_dashed(record.dashed);
+}
+}  // namespace
+
+Annotations::Annotations() : first_(nullptr), last_(nullptr), size_(0)
+{
+}
+
+Annotations::Annotations(const Annotations& other) : Annotations()
+{
+  addAnnotations(other);
+}
+
+Annotations::Annotations(Annotations&& other) : first_(other.first_), last_(other.last_), size_(other.size_)
+{
+  other.first_ = nullptr;
+  other.last_ = nullptr;
+  other.size_ = 0;
+}
+
+Annotations& Annotations::operator=(const Annotations& other)
+{
+  if (this != &other)
+  {
+    clear();
+    addAnnotations(other);
+  }
+  return *this;
+}
+
+Annotations& Annotations::operator=(Annotations&& other)
+{
+  if (this != &other)
+  {
+    AnnotationArena::get().release(first_);
+    first_ = other.first_;
+    last_ = other.last_;
+    size_ = other.size_;
+    other.first_ = nullptr;
+    other.last_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
 }
 
 Annotations::~Annotations()
 {
+  AnnotationArena::get().release(first_);
+}
+
+ShapeRecord& Annotations::append()
+{
+  if (last_ == nullptr || last_->size == ShapeChunk::CAPACITY)
+  {
+    ShapeChunk* chunk = AnnotationArena::get().acquire();
+    if (last_ == nullptr)
+      first_ = chunk;
+    else
+      last_->next = chunk;
+    last_ = chunk;
+  }
+  size_++;
+  return last_->records[last_->size++];
+}
+
+ShapeRecord& Annotations::add(ShapeRecord::Type type, const std::string& stroke_color, const std::string& fill_color,
+                              bool dashed)
+{
+  ShapeRecord& record = append();
+  std::memset(&record, 0, sizeof(ShapeRecord));
+  record.type = type;
+  record.dashed = dashed;
+  record.stroke_color = ColorTable::intern(stroke_color);
+  record.fill_color = ColorTable::intern(fill_color);
+  return record;
+}
+
+size_t Annotations::size() const
+{
+  return size_;
+}
+
+Json::Value Annotations::toJson() const
+{
+  Json::Value json(Json::arrayValue);
+  for (const ShapeChunk* chunk = first_; chunk != nullptr; chunk = chunk->next)
+  {
+    for (uint i = 0; i < chunk->size; ++i)
+    {
+      json.append(recordToJson(chunk->records[i]));
+    }
+  }
+  return json;
+}
+
+void Annotations::toProtobuf(viewer_proto::AnnotationsPacket& packet) const
+{
+  for (const ShapeChunk* chunk = first_; chunk != nullptr; chunk = chunk->next)
+  {
+    for (uint i = 0; i < chunk->size; ++i)
+    {
+      recordToProtobuf(chunk->records[i], *packet.add_annotation());
+    }
+  }
+}
+
+uint64_t Annotations::hash() const
+{
+  // the records are zeroed before being filled, so the padding bytes can be hashed.
+  uint64_t h = 14695981039346656037ULL;
+  for (const ShapeChunk* chunk = first_; chunk != nullptr; chunk = chunk->next)
+  {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(chunk->records);
+    for (size_t i = 0; i < chunk->size * sizeof(ShapeRecord); ++i)
+    {
+      h ^= bytes[i];
+      h *= 1099511628211ULL;
+    }
+  }
+  return h;
 }
 
 /*******************************************************************************************
  *                                      Circle                                             *
  *******************************************************************************************/
 
-void Annotations::addCircle(double x, double y, double r, std::string stroke_color, std::string fill_color, bool dashed)
+void Annotations::addCircle(double x, double y, double r, const std::string& stroke_color,
+                            const std::string& fill_color, bool dashed)
 {
-  shapes_.push_back(std::make_shared<shape::Circle>(x, y, r, stroke_color, fill_color, dashed));
+  ShapeRecord& record = add(ShapeRecord::CIRCLE, stroke_color, fill_color, dashed);
+  record.nb_points = 1;
+  record.coordinates[0] = x;
+  record.coordinates[1] = y;
+  record.radius = r;
 }
 
-void Annotations::addCircle(const rhoban_geometry::Point& origin, double r, std::string stroke_color,
-                            std::string fill_color, bool dashed)
+void Annotations::addCircle(const rhoban_geometry::Point& origin, double r, const std::string& stroke_color,
+                            const std::string& fill_color, bool dashed)
 {
-  shapes_.push_back(std::make_shared<shape::Circle>(origin, r, stroke_color, fill_color, dashed));
+  addCircle(origin.getX(), origin.getY(), r, stroke_color, fill_color, dashed);
 }
-void Annotations::addCircle(const Vector2d& origin, double r, std::string stroke_color, std::string fill_color,
-                            bool dashed)
+void Annotations::addCircle(const Vector2d& origin, double r, const std::string& stroke_color,
+                            const std::string& fill_color, bool dashed)
 {
   addCircle(origin.getX(), origin.getY(), r, stroke_color, fill_color, dashed);
 }
@@ -67,17 +249,20 @@ void Annotations::addCircle(const Vector2d& origin, double r, std::string stroke
  *                                      Cross                                              *
  *******************************************************************************************/
 
-void Annotations::addCross(double x, double y, std::string stroke_color, bool dashed)
+void Annotations::addCross(double x, double y, const std::string& stroke_color, bool dashed)
 {
-  shapes_.push_back(std::make_shared<shape::Cross>(x, y, stroke_color, dashed));
+  ShapeRecord& record = add(ShapeRecord::CROSS, stroke_color, "transparent", dashed);
+  record.nb_points = 1;
+  record.coordinates[0] = x;
+  record.coordinates[1] = y;
 }
 
-void Annotations::addCross(const rhoban_geometry::Point& position, std::string stroke_color, bool dashed)
+void Annotations::addCross(const rhoban_geometry::Point& position, const std::string& stroke_color, bool dashed)
 {
-  shapes_.push_back(std::make_shared<shape::Cross>(position, stroke_color, dashed));
+  addCross(position.getX(), position.getY(), stroke_color, dashed);
 }
 
-void Annotations::addCross(const Vector2d& position, std::string stroke_color, bool dashed)
+void Annotations::addCross(const Vector2d& position, const std::string& stroke_color, bool dashed)
 {
   addCross(position.getX(), position.getY(), stroke_color, dashed);
 }
@@ -86,28 +271,36 @@ void Annotations::addCross(const Vector2d& position, std::string stroke_color, b
  *                                      Arrow                                              *
  *******************************************************************************************/
 
-void Annotations::addArrow(double x, double y, double to_x, double to_y, std::string stroke_color, bool dashed)
+void Annotations::addArrow(double x, double y, double to_x, double to_y, const std::string& stroke_color,
+                           bool dashed)
 {
-  shapes_.push_back(std::make_shared<shape::Arrow>(x, y, to_x, to_y, stroke_color, dashed));
+  ShapeRecord& record = add(ShapeRecord::ARROW, stroke_color, "transparent", dashed);
+  record.nb_points = 2;
+  record.coordinates[0] = x;
+  record.coordinates[1] = y;
+  record.coordinates[2] = to_x;
+  record.coordinates[3] = to_y;
 }
 
 void Annotations::addArrow(const rhoban_geometry::Point& origin, const rhoban_geometry::Point& end,
-                           std::string stroke_color, bool dashed)
+                           const std::string& stroke_color, bool dashed)
 {
-  shapes_.push_back(std::make_shared<shape::Arrow>(origin, end, stroke_color, dashed));
+  addArrow(origin.getX(), origin.getY(), end.getX(), end.getY(), stroke_color, dashed);
 }
 
-void Annotations::addArrow(const Vector2d& origin, const Vector2d& end, std::string stroke_color, bool dashed)
+void Annotations::addArrow(const Vector2d& origin, const Vector2d& end, const std::string& stroke_color, bool dashed)
 {
   addArrow(origin.getX(), origin.getY(), end.getX(), end.getY(), stroke_color, dashed);
 }
 
-void Annotations::addArrow(const rhoban_geometry::Point& origin, const Vector2d& direction, std::string stroke_color, bool dashed)
+void Annotations::addArrow(const rhoban_geometry::Point& origin, const Vector2d& direction,
+                           const std::string& stroke_color, bool dashed)
 {
-  addArrow(origin.getX(), origin.getY(), origin.getX() + direction.getX(), origin.getY() + direction.getY(), stroke_color, dashed);
+  addArrow(origin.getX(), origin.getY(), origin.getX() + direction.getX(), origin.getY() + direction.getY(),
+           stroke_color, dashed);
 }
 
-void Annotations::addArrow(const rhoban_geometry::Segment& s, std::string color, bool dashed)
+void Annotations::addArrow(const rhoban_geometry::Segment& s, const std::string& color, bool dashed)
 {
   addArrow(s.A, s.B, color, dashed);
 }
@@ -116,26 +309,46 @@ void Annotations::addArrow(const rhoban_geometry::Segment& s, std::string color,
  *                                      Polygon                                            *
  *******************************************************************************************/
 
-void Annotations::addLine(rhoban_geometry::Point p1, rhoban_geometry::Point p2, std::string stroke_color, bool dashed)
+void Annotations::addLine(rhoban_geometry::Point p1, rhoban_geometry::Point p2, const std::string& stroke_color,
+                          bool dashed)
 {
-  std::shared_ptr<shape::Polygon> polygon(
-      new shape::Polygon(p1.getX(), p1.getY(), stroke_color, "transparent", dashed));
-  polygon->add_point(p2);
-  shapes_.push_back(polygon);
+  ShapeRecord& record = add(ShapeRecord::POLYGON, stroke_color, "transparent", dashed);
+  record.nb_points = 2;
+  record.coordinates[0] = p1.getX();
+  record.coordinates[1] = p1.getY();
+  record.coordinates[2] = p2.getX();
+  record.coordinates[3] = p2.getY();
 }
 
-void Annotations::addBox(Box box, std::string stroke_color, std::string fill_color, bool dashed)
+void Annotations::addBox(Box box, const std::string& stroke_color, const std::string& fill_color, bool dashed)
 {
-  std::shared_ptr<shape::Polygon> polygon(new shape::Polygon(box.getNE(), stroke_color, fill_color, dashed));
-  polygon->add_point(box.getNW());
-  polygon->add_point(box.getSW());
-  polygon->add_point(box.getSE());
-  shapes_.push_back(polygon);
+  ShapeRecord& record = add(ShapeRecord::POLYGON, stroke_color, fill_color, dashed);
+  const rhoban_geometry::Point corners[4] = { box.getNE(), box.getNW(), box.getSW(), box.getSE() };
+  record.nb_points = 4;
+  for (uint i = 0; i < 4; ++i)
+  {
+    record.coordinates[2 * i] = corners[i].getX();
+    record.coordinates[2 * i + 1] = corners[i].getY();
+  }
 }
 
 void Annotations::addPolygon(shape::Polygon polygon)
 {
-  shapes_.push_back(std::make_shared<shape::Polygon>(polygon));
+  const std::vector<std::shared_ptr<rhoban_geometry::Point>>& points = polygon.getPoints();
+  if (points.size() > ShapeRecord::MAX_POINTS)
+  {
+    DEBUG("polygon annotation of " << points.size() << " points truncated to " << ShapeRecord::MAX_POINTS
+                                   << " points");
+  }
+  assert(points.size() <= ShapeRecord::MAX_POINTS);
+
+  ShapeRecord& record = add(ShapeRecord::POLYGON, polygon.getStrokeColor(), polygon.getFillColor(), polygon.isDashed());
+  record.nb_points = std::min<size_t>(points.size(), ShapeRecord::MAX_POINTS);
+  for (uint i = 0; i < record.nb_points; ++i)
+  {
+    record.coordinates[2 * i] = points[i]->getX();
+    record.coordinates[2 * i + 1] = points[i]->getY();
+  }
 }
 
 /*******************************************************************************************
@@ -144,15 +357,24 @@ void Annotations::addPolygon(shape::Polygon polygon)
 
 void Annotations::addAnnotations(const Annotations& annotations)
 {
-  for (auto it = annotations.shapes_.begin(); it != annotations.shapes_.end(); it++)
+  // the size is read first, so that adding annotations to themselves terminates.
+  size_t nb_records = annotations.size_;
+  for (const ShapeChunk* chunk = annotations.first_; chunk != nullptr && nb_records > 0; chunk = chunk->next)
   {
-    shapes_.push_back((*it));
+    for (uint i = 0; i < chunk->size && nb_records > 0; ++i, --nb_records)
+    {
+      // memcpy keeps the zeroed padding used by hash().
+      std::memcpy(&append(), &chunk->records[i], sizeof(ShapeRecord));
+    }
   }
 }
 
 void Annotations::clear()
 {
-  shapes_.clear();
+  AnnotationArena::get().release(first_);
+  first_ = nullptr;
+  last_ = nullptr;
+  size_ = 0;
 }
 
 }  // namespace annotations
@@ -25,6 +25,7 @@
 #include <rhoban_geometry/segment.h>
 #include <math/box.h>
 #include "shape/shape.h"
+#include "annotation_arena.h"
 #include <memory>
 
 // Shape
@@ -37,10 +38,22 @@ namespace rhoban_ssl
 {
 namespace annotations
 {
+/**
+ * @brief The shapes drawn in the viewer.
+ *
+ * The shapes are stored as plain records (@see ShapeRecord) with interned colors,
+ * in chunks taken from the AnnotationArena: adding, merging and copying annotations
+ * do not allocate once the arena has enough chunks. The records are serialized
+ * directly in the viewer formats.
+ */
 class Annotations
 {
 public:
   Annotations();
+  Annotations(const Annotations& other);
+  Annotations(Annotations&& other);
+  Annotations& operator=(const Annotations& other);
+  Annotations& operator=(Annotations&& other);
 
   /*******************************************************************************************
    *                                      Circle                                             *
@@ -54,8 +67,8 @@ public:
    * @param stroke_color
    * @param dashed
    */
-  void addCircle(double x, double y, double r, std::string stroke_color = "white",
-                 std::string fill_color = "transparent", bool dashed = false);
+  void addCircle(double x, double y, double r, const std::string& stroke_color = "white",
+                 const std::string& fill_color = "transparent", bool dashed = false);
   /**
    * @brief addCircle
    * @param x
@@ -65,8 +78,8 @@ public:
    * @param stroke_color
    * @param dashed
    */
-  void addCircle(const rhoban_geometry::Point& origin, double r, std::string stroke_color = "white",
-                 std::string fill_color = "transparent", bool dashed = false);
+  void addCircle(const rhoban_geometry::Point& origin, double r, const std::string& stroke_color = "white",
+                 const std::string& fill_color = "transparent", bool dashed = false);
   /**
    * @brief addCircle
    * @param x
@@ -76,8 +89,8 @@ public:
    * @param stroke_color
    * @param dashed
    */
-  void addCircle(const Vector2d& origin, double r, std::string stroke_color = "white",
-                 std::string fill_color = "transparent", bool dashed = false);
+  void addCircle(const Vector2d& origin, double r, const std::string& stroke_color = "white",
+                 const std::string& fill_color = "transparent", bool dashed = false);
 
   /*******************************************************************************************
    *                                      Cross                                              *
@@ -89,21 +102,22 @@ public:
    * @param stroke_color
    * @param dashed
    */
-  void addCross(double x, double y, std::string stroke_color = "white", bool dashed = false);
+  void addCross(double x, double y, const std::string& stroke_color = "white", bool dashed = false);
   /**
    * @brief addCross
    * @param position
    * @param stroke_color
    * @param dashed
    */
-  void addCross(const rhoban_geometry::Point& position, std::string stroke_color = "white", bool dashed = false);
+  void addCross(const rhoban_geometry::Point& position, const std::string& stroke_color = "white",
+                bool dashed = false);
   /**
    * @brief addCross
    * @param position
    * @param stroke_color
    * @param dashed
    */
-  void addCross(const Vector2d& position, std::string stroke_color = "white", bool dashed = false);
+  void addCross(const Vector2d& position, const std::string& stroke_color = "white", bool dashed = false);
 
   /*******************************************************************************************
    *                                        Arrow                                            *
@@ -117,7 +131,8 @@ public:
    * @param stroke_color
    * @param dashed
    */
-  void addArrow(double x, double y, double to_x, double to_y, std::string stroke_color = "white", bool dashed = false);
+  void addArrow(double x, double y, double to_x, double to_y, const std::string& stroke_color = "white",
+                bool dashed = false);
   /**
    * @brief addArrow
    * @param origin
@@ -126,7 +141,7 @@ public:
    * @param dashed
    */
   void addArrow(const rhoban_geometry::Point& origin, const rhoban_geometry::Point& end,
-                std::string stroke_color = "white", bool dashed = false);
+                const std::string& stroke_color = "white", bool dashed = false);
   /**
    * @brief addArrow
    * @param origin
@@ -134,7 +149,8 @@ public:
    * @param stroke_color
    * @param dashed
    */
-  void addArrow(const Vector2d& origin, const Vector2d& end, std::string stroke_color = "white", bool dashed = false);
+  void addArrow(const Vector2d& origin, const Vector2d& end, const std::string& stroke_color = "white",
+                bool dashed = false);
 
 /**
    * @brief addArrow
@@ -143,9 +159,10 @@ public:
    * @param stroke_color
    * @param dashed
    */
-  void addArrow(const rhoban_geometry::Point& origin, const Vector2d& direction, std::string stroke_color, bool dashed);
+  void addArrow(const rhoban_geometry::Point& origin, const Vector2d& direction, const std::string& stroke_color,
+                bool dashed);
 
-  void addArrow(const rhoban_geometry::Segment& s, std::string stroke_color = "white", bool dashed = false);
+  void addArrow(const rhoban_geometry::Segment& s, const std::string& stroke_color = "white", bool dashed = false);
 
   /*******************************************************************************************
    *                                        Polygon                                          *
@@ -159,7 +176,7 @@ public:
    * @param fill_color
    * @param dashed
    */
-  void addLine(rhoban_geometry::Point p1, rhoban_geometry::Point p2, std::string stroke_color = "white",
+  void addLine(rhoban_geometry::Point p1, rhoban_geometry::Point p2, const std::string& stroke_color = "white",
                bool dashed = false);
 
   /**
@@ -169,11 +186,13 @@ public:
    * @param fill_color
    * @param dashed
    */
-  void addBox(Box box, std::string stroke_color = "white", std::string fill_color = "transparent", bool dashed = false);
+  void addBox(Box box, const std::string& stroke_color = "white", const std::string& fill_color = "transparent",
+              bool dashed = false);
 
   /**
    * @brief addPolygon
-   * @param polygon
+   * @param polygon at most ShapeRecord::MAX_POINTS points, the following ones are dropped
+   * (it asserts in debug builds)
    */
   void addPolygon(shape::Polygon polygon);
 
@@ -190,21 +209,44 @@ public:
    * @brief clear
    */
   void clear();
+  /**
+   * @brief Number of shapes.
+   */
+  size_t size() const;
   /**
    * @brief toJson
    * @return
    */
-  Json::Value toJson();
+  Json::Value toJson() const;
+  /**
+   * @brief toProtobuf
+   * @param packet the message that receives all the shapes
+   */
+  void toProtobuf(viewer_proto::AnnotationsPacket& packet) const;
+  /**
+   * @brief 64 bits FNV-1a hash of the shapes, equal annotations have the same hash.
+   */
+  uint64_t hash() const;
   /**
    * @brief Destructor
    */
   ~Annotations();
 
-protected:
-  std::vector<std::shared_ptr<shape::Shape>> shapes_;
-
 private:
-  Json::Value json_;
+  ShapeChunk* first_;
+  ShapeChunk* last_;
+  size_t size_;
+
+  /**
+   * @brief Returns a new uninitialized record at the end of the annotations.
+   */
+  ShapeRecord& append();
+
+  /**
+   * @brief Returns a new record at the end of the annotations.
+   */
+  ShapeRecord& add(ShapeRecord::Type type, const std::string& stroke_color, const std::string& fill_color,
+                   bool dashed);
 };
 }  // namespace annotations
 }  // namespace rhoban_ssl
@@ -56,6 +56,17 @@ Json::Value Arrow::toJson()
   return annotation;
 }
 
+void Arrow::toProtobuf(viewer_proto::Annotation& annotation)
+{
+  annotation.set_type(viewer_proto::Annotation::ARROW);
+  annotation.add_points(origin_.getX());
+  annotation.add_points(origin_.getY());
+  annotation.add_points(end_.getX());
+  annotation.add_points(end_.getY());
+  annotation.set_strokecolor(stroke_color_);
+  annotation.set_dashed(dashed_);
+}
+
 Arrow::~Arrow()
 {
 }
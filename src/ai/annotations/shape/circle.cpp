@@ -60,6 +60,17 @@ Json::Value Circle::toJson()
   return annotation;
 }
 
+void Circle::toProtobuf(viewer_proto::Annotation& annotation)
+{
+  annotation.set_type(viewer_proto::Annotation::CIRCLE);
+  annotation.add_points(circle_.getCenter().getX());
+  annotation.add_points(circle_.getCenter().getY());
+  annotation.set_radius(circle_.getRadius());
+  annotation.set_fillcolor(fill_color_);
+  annotation.set_strokecolor(stroke_color_);
+  annotation.set_dashed(dashed_);
+}
+
 Circle::~Circle()
 {
 }
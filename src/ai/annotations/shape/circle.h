@@ -76,6 +76,10 @@ public:
    * @see Shape
    */
   virtual Json::Value toJson();
+  /**
+   * @see Shape
+   */
+  virtual void toProtobuf(viewer_proto::Annotation& annotation);
   /**
    * @brief Destructor
    */
@@ -48,6 +48,15 @@ Json::Value Cross::toJson()
   return annotation;
 }
 
+void Cross::toProtobuf(viewer_proto::Annotation& annotation)
+{
+  annotation.set_type(viewer_proto::Annotation::CROSS);
+  annotation.add_points(center_.getX());
+  annotation.add_points(center_.getY());
+  annotation.set_strokecolor(stroke_color_);
+  annotation.set_dashed(dashed_);
+}
+
 Cross::~Cross()
 {
 }
@@ -68,6 +68,10 @@ public:
    * @see Shape
    */
   virtual Json::Value toJson();
+  /**
+   * @see Shape
+   */
+  virtual void toProtobuf(viewer_proto::Annotation& annotation);
   /**
    * @brief Destructor
    */
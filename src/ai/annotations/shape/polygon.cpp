@@ -47,6 +47,26 @@ void Polygon::add_point(rhoban_geometry::Point p)
   points_.push_back(std::make_shared<rhoban_geometry::Point>(p));
 }
 
+const std::vector<std::shared_ptr<rhoban_geometry::Point>>& Polygon::getPoints() const
+{
+  return points_;
+}
+
+const std::string& Polygon::getStrokeColor() const
+{
+  return stroke_color_;
+}
+
+const std::string& Polygon::getFillColor() const
+{
+  return fill_color_;
+}
+
+bool Polygon::isDashed() const
+{
+  return dashed_;
+}
+
 Json::Value Polygon::toJson()
 {
   Json::Value annotation;
@@ -69,6 +89,19 @@ Json::Value Polygon::toJson()
   return annotation;
 }
 
+void Polygon::toProtobuf(viewer_proto::Annotation& annotation)
+{
+  annotation.set_type(viewer_proto::Annotation::POLYGON);
+  for (auto it = points_.begin(); it != points_.end(); it++)
+  {
+    annotation.add_points((*it)->getX());
+    annotation.add_points((*it)->getY());
+  }
+  annotation.set_fillcolor(fill_color_);
+  annotation.set_strokecolor(stroke_color_);
+  annotation.set_dashed(dashed_);
+}
+
 Polygon::~Polygon()
 {
 }
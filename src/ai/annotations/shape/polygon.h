@@ -85,10 +85,19 @@ public:
    * @param p adding point
    */
   void add_point(rhoban_geometry::Point p);
+
+  const std::vector<std::shared_ptr<rhoban_geometry::Point>>& getPoints() const;
+  const std::string& getStrokeColor() const;
+  const std::string& getFillColor() const;
+  bool isDashed() const;
   /**
    * @see Shape
    */
   virtual Json::Value toJson();
+  /**
+   * @see Shape
+   */
+  virtual void toProtobuf(viewer_proto::Annotation& annotation);
   /**
    * @brief Destructor
    */
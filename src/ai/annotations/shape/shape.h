@@ -20,6 +20,7 @@
 #pragma once
 
 #include <json/json.h>
+#include <annotation_packet.pb.h>
 
 namespace rhoban_ssl
 {
@@ -32,6 +33,10 @@ class Shape
 public:
   Shape();
   virtual Json::Value toJson() = 0;
+  /**
+   * @brief Fills the protobuf message used by the binary viewer protocol.
+   */
+  virtual void toProtobuf(viewer_proto::Annotation& annotation) = 0;
   virtual ~Shape();
 };
 }  // namespace shape
@@ -0,0 +1,71 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "shape_record.h"
+
+namespace rhoban_ssl
+{
+namespace annotations
+{
+ColorTable::ColorTable() : size_(0)
+{
+  names_[0] = "white";
+  names_[1] = "transparent";
+  size_ = 2;
+}
+
+ColorTable& ColorTable::get()
+{
+  static ColorTable table;
+  return table;
+}
+
+ColorId ColorTable::intern(const std::string& color)
+{
+  ColorTable& table = get();
+
+  // the names are never modified once they are counted in size_.
+  unsigned int size = table.size_.load(std::memory_order_acquire);
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    if (table.names_[i] == color)
+      return static_cast<ColorId>(i);
+  }
+
+  std::lock_guard<std::mutex> lock(table.mutex_);
+  size = table.size_.load(std::memory_order_relaxed);
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    if (table.names_[i] == color)
+      return static_cast<ColorId>(i);
+  }
+  if (size == MAX_COLORS)
+    return 0;
+  table.names_[size] = color;
+  table.size_.store(size + 1, std::memory_order_release);
+  return static_cast<ColorId>(size);
+}
+
+const std::string& ColorTable::name(ColorId id)
+{
+  return get().names_[id];
+}
+
+}  // namespace annotations
+}  // namespace rhoban_ssl
@@ -0,0 +1,95 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace rhoban_ssl
+{
+namespace annotations
+{
+typedef uint16_t ColorId;
+
+/**
+ * @brief Interns the color names used by the annotations.
+ *
+ * A shape only stores the identifier of its colors. The names are never removed:
+ * a viewer uses a few dozens of colors.
+ *
+ * intern() can be called by any thread, name() can be called concurrently
+ * for the identifiers already returned.
+ */
+class ColorTable
+{
+public:
+  static constexpr unsigned int MAX_COLORS = 256;
+
+  /**
+   * @brief Returns the identifier of a color, adding it to the table if needed.
+   *
+   * When the table is full, the identifier of "white" is returned.
+   */
+  static ColorId intern(const std::string& color);
+
+  static const std::string& name(ColorId id);
+
+private:
+  static ColorTable& get();
+  ColorTable();
+
+  std::string names_[MAX_COLORS];
+  std::atomic<unsigned int> size_;
+  std::mutex mutex_;
+};
+
+/**
+ * @brief A shape of the annotations as a plain record (no allocation, copied with memcpy).
+ *
+ * The coordinates are stored as pairs (x, y):
+ *  - CIRCLE: the center, and the radius,
+ *  - CROSS: the center,
+ *  - ARROW: the origin then the end,
+ *  - POLYGON: up to MAX_POINTS points.
+ */
+struct ShapeRecord
+{
+  static constexpr unsigned int MAX_POINTS = 8;
+
+  enum Type : uint8_t
+  {
+    CIRCLE = 0,
+    CROSS,
+    ARROW,
+    POLYGON
+  };
+
+  uint8_t type;
+  uint8_t nb_points;
+  bool dashed;
+  ColorId stroke_color;
+  ColorId fill_color;
+  float radius;
+  float coordinates[2 * MAX_POINTS];
+};
+
+}  // namespace annotations
+}  // namespace rhoban_ssl
@@ -0,0 +1,125 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include "annotations.h"
+
+using namespace rhoban_ssl::annotations;
+
+TEST(test_annotations, json)
+{
+  Annotations annotations;
+  annotations.addCircle(1.0, 2.0, 0.5, "red", "blue", true);
+  annotations.addCross(-1.0, 0.25, "green");
+  annotations.addArrow(0.0, 0.0, 1.0, 1.0);
+  annotations.addLine(rhoban_geometry::Point(0, 0), rhoban_geometry::Point(2, 0), "orange");
+  EXPECT_EQ(annotations.size(), 4u);
+
+  Json::Value json = annotations.toJson();
+  EXPECT_EQ(json.size(), 4u);
+  EXPECT_EQ(json[0]["type"].asString(), "circle");
+  EXPECT_EQ(json[0]["circle"]["x"].asDouble(), 1.0);
+  EXPECT_EQ(json[0]["circle"]["radius"].asDouble(), 0.5);
+  EXPECT_EQ(json[0]["stroke_color"].asString(), "red");
+  EXPECT_EQ(json[0]["fill_color"].asString(), "blue");
+  EXPECT_TRUE(json[0]["dashed"].asBool());
+  EXPECT_EQ(json[1]["type"].asString(), "cross");
+  EXPECT_EQ(json[1]["origin"]["y"].asDouble(), 0.25);
+  EXPECT_EQ(json[2]["type"].asString(), "arrow");
+  EXPECT_EQ(json[2]["stroke_color"].asString(), "white");
+  EXPECT_EQ(json[3]["type"].asString(), "polygon");
+  EXPECT_EQ(json[3]["points"].size(), 2u);
+  EXPECT_EQ(json[3]["points"][1]["x"].asDouble(), 2.0);
+}
+
+TEST(test_annotations, merge_and_copy)
+{
+  Annotations a;
+  Annotations b;
+  for (int i = 0; i < 100; ++i)
+  {
+    a.addCross(i, 0.0, "red");
+    b.addCircle(0.0, i, 1.0);
+  }
+  Annotations merged;
+  merged.addAnnotations(a);
+  merged.addAnnotations(b);
+  EXPECT_EQ(merged.size(), 200u);
+
+  Annotations copy = merged;
+  EXPECT_EQ(copy.size(), 200u);
+  EXPECT_EQ(copy.hash(), merged.hash());
+  EXPECT_EQ(copy.toJson()[150]["circle"]["y"].asDouble(), 50.0);
+
+  copy.addAnnotations(copy);
+  EXPECT_EQ(copy.size(), 400u);
+
+  Annotations moved = std::move(copy);
+  EXPECT_EQ(moved.size(), 400u);
+  EXPECT_EQ(copy.size(), 0u);
+
+  moved.clear();
+  EXPECT_EQ(moved.size(), 0u);
+  EXPECT_EQ(moved.toJson().size(), 0u);
+}
+
+TEST(test_annotations, hash)
+{
+  Annotations a;
+  Annotations b;
+  a.addArrow(0.0, 0.0, 1.0, 1.0, "magenta", true);
+  b.addArrow(0.0, 0.0, 1.0, 1.0, "magenta", true);
+  EXPECT_EQ(a.hash(), b.hash());
+  b.clear();
+  b.addArrow(0.0, 0.0, 1.0, 1.0, "magenta", false);
+  EXPECT_NE(a.hash(), b.hash());
+}
+
+TEST(test_annotations, reuse_chunks)
+{
+  AnnotationArena& arena = AnnotationArena::get();
+  {
+    Annotations warmup;
+    for (int i = 0; i < 1000; ++i)
+      warmup.addCross(i, i);
+  }
+  unsigned long allocated = arena.nbAllocatedChunks();
+  for (int tick = 0; tick < 10; ++tick)
+  {
+    Annotations annotations;
+    for (int i = 0; i < 1000; ++i)
+      annotations.addCross(i, i);
+  }
+  EXPECT_EQ(arena.nbAllocatedChunks(), allocated);
+}
+
+TEST(test_annotations, colors)
+{
+  ColorId red = ColorTable::intern("red");
+  EXPECT_EQ(ColorTable::intern("red"), red);
+  EXPECT_EQ(ColorTable::name(red), "red");
+  EXPECT_NE(ColorTable::intern("cyan"), red);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
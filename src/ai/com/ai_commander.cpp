@@ -23,13 +23,19 @@
 #include <config.h>
 #include <data.h>
 
+#include <sstream>
 #include <unistd.h>
 
 namespace rhoban_ssl
 {
 namespace control
 {
-Commander::Commander() : real_(nullptr), sim_(nullptr)
+Commander::Commander(const std::string& radio_port)
+  : real_(nullptr)
+  , sim_(nullptr)
+  , start_time_(rhoban_utils::TimeStamp::now())
+  , next_metrics_time_(0.0)
+  , metrics_(nullptr)
 {
   if ((ai::Config::is_in_simulation) || (ai::Config::is_in_mixcontrol))
   {
@@ -40,7 +46,7 @@ Commander::Commander() : real_(nullptr), sim_(nullptr)
   {
     if (real_ == nullptr)
     {
-      real_ = new Master("/dev/ttyACM0", 1000000);
+      real_ = new Master(radio_port, 1000000);
       /*
        * COULD HELP BUT NOT FOR SURE:
       for (int rid = 0; rid < ai::Config::NB_OF_ROBOTS_BY_TEAM; ++rid)
@@ -49,6 +55,22 @@ Commander::Commander() : real_(nullptr), sim_(nullptr)
       */
       usleep(1000);
     }
+    if (!ai::Config::radio_metrics_file.empty())
+    {
+      metrics_ = new AsyncWriter(ai::Config::radio_metrics_file);
+      if (metrics_->good())
+      {
+        std::ostringstream header;
+        RadioTelemetry::writeCsvHeader(header);
+        metrics_->write(header.str());
+      }
+      else
+      {
+        DEBUG("can't open the radio metrics file " << ai::Config::radio_metrics_file);
+        delete metrics_;
+        metrics_ = nullptr;
+      }
+    }
   }
   if (Data::get()->commander != nullptr)
   {
@@ -62,10 +84,32 @@ Commander::~Commander()
   emergency();
   usleep(1000);
   if (sim_ != nullptr)
+  {
+    const SimClient::SendStats& stats = sim_->sendStats();
+    DEBUG("simulator packets: " << stats.packets << " sent, " << stats.packets_per_second << " packets/s, "
+                                << stats.bytes_per_second << " bytes/s, last packet " << stats.last_size << " bytes");
     delete sim_;
+  }
 
   if (real_ != nullptr)
+  {
+    Master::SendStats stats = real_->sendStats();
+    DEBUG("radio frames: " << stats.published << " published, " << stats.sent << " sent, " << stats.superseded
+                           << " superseded, send latency mean " << stats.meanLatency * 1000 << " ms, max "
+                           << stats.maxLatency * 1000 << " ms");
+    for (unsigned int id = 0; id < MAX_ROBOTS; id++)
+    {
+      RadioTelemetry::RobotStats link = real_->telemetry.robotStats(id);
+      if (link.commands > 0)
+      {
+        DEBUG("radio robot " << id << ": " << link.answers << " answers, " << link.missed << " missed ("
+                             << link.lossRate() * 100 << " %), rtt mean " << link.mean_rtt * 1000 << " ms, max "
+                             << link.max_rtt * 1000 << " ms");
+      }
+    }
     delete real_;
+  }
+  delete metrics_;
 
   assert(Data::get()->commander == this);
 
@@ -112,6 +156,7 @@ void Commander::emergency()
     final_control.control.active = false;
   }
 
+  std::lock_guard<std::mutex> lock(mutex_);
   this->stopAll();
   this->send();
 }
@@ -120,6 +165,7 @@ void Commander::moveBall(double x, double y, double vx, double vy)
 {
   if (ai::Config::is_in_simulation)
   {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (Data::get()->referee.allyOnPositiveHalf())
     {
       x *= -1;
@@ -148,6 +194,7 @@ void Commander::moveRobot(bool ally, int id, double x, double y, double theta)
     {
       yellow = false;
     }
+    std::lock_guard<std::mutex> lock(mutex_);
     sim_->moveRobot(yellow, id, x, y, theta * 180 / M_PI, turn_on);
   }
   else
@@ -156,15 +203,29 @@ void Commander::moveRobot(bool ally, int id, double x, double y, double theta)
   }
 }
 
-grSim_Packet Commander::convertToSimulationPacket(const Commander::Command& cmd)
+void Commander::addMusicPacket(int robot_id, const packet_music& music)
+{
+  if (real_ != nullptr)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    real_->addMusicPacket(robot_id, music);
+  }
+}
+
+bool Commander::hasRadio() const
 {
-  grSim_Packet packet;
-  packet.mutable_commands()->set_isteamyellow(!ai::Config::we_are_blue);
-  packet.mutable_commands()->set_timestamp(0.0);
+  return real_ != nullptr;
+}
 
-  double factor = cmd.enabled ? 1 : 0;
+RadioTelemetry::RobotStats Commander::radioStats(unsigned int robot_id)
+{
+  assert(real_ != nullptr);
+  return real_->telemetry.robotStats(robot_id);
+}
 
-  grSim_Robot_Command* simCommand = packet.mutable_commands()->add_robot_commands();
+void Commander::fillSimulationCommand(const Commander::Command& cmd, grSim_Robot_Command& sim_command)
+{
+  double factor = cmd.enabled ? 1 : 0;
 
   double kick_x = 0;
   double kick_y = 0;
@@ -185,16 +246,14 @@ grSim_Packet Commander::convertToSimulationPacket(const Commander::Command& cmd)
   }
 
   // Appending data
-  simCommand->set_id(cmd.robot_id);
-  simCommand->set_wheelsspeed(false);
-  simCommand->set_veltangent(cmd.x_speed * factor);
-  simCommand->set_velnormal(cmd.y_speed * factor);
-  simCommand->set_velangular(cmd.theta_speed * factor);
-  simCommand->set_kickspeedx(kick_x);
-  simCommand->set_kickspeedz(kick_y);
-  simCommand->set_spinner(cmd.enabled ? cmd.spin : false);
-
-  return packet;
+  sim_command.set_id(cmd.robot_id);
+  sim_command.set_wheelsspeed(false);
+  sim_command.set_veltangent(cmd.x_speed * factor);
+  sim_command.set_velnormal(cmd.y_speed * factor);
+  sim_command.set_velangular(cmd.theta_speed * factor);
+  sim_command.set_kickspeedx(kick_x);
+  sim_command.set_kickspeedz(kick_y);
+  sim_command.set_spinner(cmd.enabled ? cmd.spin : false);
 }
 
 packet_master Commander::convertToRobotPacket(const Commander::Command& cmd)
@@ -250,8 +309,20 @@ packet_master Commander::convertToRobotPacket(const Commander::Command& cmd)
   return packet;
 }
 
-void Commander::updateRobotsCommands()
+void Commander::prepareControls()
 {
+  if (!ai::Config::is_in_simulation)
+    updateElectronicInformations();
+
+  if (real_ != nullptr)
+    Data::get()->latency.setRadioRtt(real_->telemetry.smoothedRtt());
+
+  if (Data::get()->referee.getCurrentStateName() == "HALT")
+  {
+    Data::get()->shared_data.final_control_for_robots[Data::get()->referee.teams_info->goalkeeper_number].control =
+        Control::makeNull();
+  }
+
   for (uint robot_id = 0; robot_id < ai::Config::NB_OF_ROBOTS_BY_TEAM; ++robot_id)
   {
     Control& ctrl = Data::get()->shared_data.final_control_for_robots[robot_id].control;
@@ -277,6 +348,15 @@ void Commander::updateRobotsCommands()
     {
       ctrl.kick_power = 0.8f;
     }
+  }
+}
+
+void Commander::sendControls(const Control* controls)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (uint robot_id = 0; robot_id < ai::Config::NB_OF_ROBOTS_BY_TEAM; ++robot_id)
+  {
+    const Control& ctrl = controls[robot_id];
 
     if (robot_id >= 8)
     {                      // HACK - becaus hardware doesn't support more than 8 robots
@@ -326,6 +406,7 @@ void Commander::updateRobotsCommands()
       }
     }
   }
+  send();
 }
 
 void Commander::updateElectronicInformations()
@@ -335,18 +416,42 @@ void Commander::updateElectronicInformations()
     real_->updateRobot(id, Data::get()->robots[Ally][id].electronics);
     // DEBUG("update elec for " << id << " " << (int)Data::get()->robots[Ally][id].electronics.xpos);
   }
+
+  double time = diffSec(start_time_, rhoban_utils::TimeStamp::now());
+  for (unsigned int id = 0; id < MAX_ROBOTS; id++)
+  {
+    double age;
+    if (real_->robotPresence(id, age))
+    {
+      real_->telemetry.sampleStatus(id, time, age, Data::get()->robots[Ally][id].electronics);
+    }
+  }
+
+  if (metrics_ != nullptr && time >= next_metrics_time_)
+  {
+    std::ostringstream rows;
+    real_->telemetry.writeCsv(rows, time);
+    metrics_->write(rows.str());
+    next_metrics_time_ = time + METRICS_PERIOD;
+  }
 }
 
 void Commander::send()
 {
+  bool to_simulation = (ai::Config::is_in_simulation) || (ai::Config::is_in_mixcontrol);
+  bool to_robots = (ai::Config::is_in_simulation == false) || (ai::Config::is_in_mixcontrol);
+
+  // all the simulated robots are commanded with a single packet
+  if (to_simulation)
+    sim_->beginCommands(!ai::Config::we_are_blue);
+
   for (auto& cmd : commands_)
   {
-    if ((ai::Config::is_in_simulation) || (ai::Config::is_in_mixcontrol))
+    if (to_simulation)
     {
-      grSim_Packet packet = convertToSimulationPacket(cmd);
-      sim_->sendPacket(packet);
+      fillSimulationCommand(cmd, sim_->addCommand());
     }
-    if (((ai::Config::is_in_simulation == false) || (ai::Config::is_in_mixcontrol)))
+    if (to_robots)
     {
       struct packet_master packet = convertToRobotPacket(cmd);
       real_->addRobotPacket(cmd.robot_id, packet);
@@ -355,24 +460,22 @@ void Commander::send()
 
   commands_.clear();
 
+  if (to_simulation)
+    sim_->sendCommands();
   if (!ai::Config::is_in_simulation)
     real_->send();
 }
 
 bool Commander::runTask()
 {
-  if (!ai::Config::is_in_simulation)
-    updateElectronicInformations();
+  prepareControls();
 
-  if (Data::get()->referee.getCurrentStateName() == "HALT")
+  Control controls[ai::Config::NB_OF_ROBOTS_BY_TEAM];
+  for (uint robot_id = 0; robot_id < ai::Config::NB_OF_ROBOTS_BY_TEAM; ++robot_id)
   {
-    Data::get()->shared_data.final_control_for_robots[Data::get()->referee.teams_info->goalkeeper_number].control =
-        Control::makeNull();
+    controls[robot_id] = Data::get()->shared_data.final_control_for_robots[robot_id].control;
   }
-
-  updateRobotsCommands();
-
-  send();
+  sendControls(controls);
 
   return true;
 }
@@ -21,9 +21,13 @@
 #pragma once
 
 #include <stdint.h>
+#include <mutex>
 #include <Master.h>
 #include <SimClient.h>
 #include <execution_manager.h>
+#include <core/async_writer.h>
+
+class Control;
 
 namespace rhoban_ssl
 {
@@ -32,7 +36,11 @@ namespace control
 class Commander : public Task
 {
 public:
-  Commander();
+  /**
+   * @brief Constructor.
+   * @param radio_port the serial port of the radio, used when the robots are not simulated
+   */
+  Commander(const std::string& radio_port = "/dev/ttyACM0");
   ~Commander();
 
   /**
@@ -46,10 +54,29 @@ public:
    */
   void stopAll();
 
+  /**
+   * @brief Moves the ball in the simulator. It can be called from another thread than the control loop.
+   */
   void moveBall(double x, double y, double vx, double vy);
 
+  /**
+   * @brief Moves a robot in the simulator. It can be called from another thread than the control loop.
+   */
   void moveRobot(bool ally, int id, double x, double y, double theta);
 
+  /**
+   * @brief Queues a music packet for a robot, ignored without radio. It can be called from another thread than
+   * the control loop.
+   */
+  void addMusicPacket(int robot_id, const packet_music& music);
+
+  bool hasRadio() const;
+
+  /**
+   * @brief The statistics of the radio link with a robot, hasRadio() must be true.
+   */
+  RadioTelemetry::RobotStats radioStats(unsigned int robot_id);
+
   /**
    * @brief An emergency call stop all robots connected with the ai.
    *
@@ -61,6 +88,21 @@ public:
    */
   void emergency();
 
+  /**
+   * @brief Reads the statuses of the robots and applies the rules of the game on the final controls
+   * (stopped goalkeeper on halt, no kick without the ball, charge, indirect free kick power).
+   *
+   * It must be called by the strategy thread.
+   */
+  void prepareControls();
+
+  /**
+   * @brief Sends one control for each robot (ai::Config::NB_OF_ROBOTS_BY_TEAM controls).
+   *
+   * The controls must be relative to the robots. It can be called from another thread than the strategy.
+   */
+  void sendControls(const Control* controls);
+
   Master* real_;
 
 private:
@@ -82,11 +124,20 @@ private:
 
   std::vector<struct Command> commands_;
 
-  grSim_Packet convertToSimulationPacket(const Command& cmd);
+  // radio link statistics, written every METRICS_PERIOD seconds when ai::Config::radio_metrics_file is set
+  // (the file is written by the thread of the AsyncWriter, not by the control loop)
+  static constexpr double METRICS_PERIOD = 1.0;
+  rhoban_utils::TimeStamp start_time_;
+  double next_metrics_time_;
+  AsyncWriter* metrics_;
+
+  void fillSimulationCommand(const Command& cmd, grSim_Robot_Command& sim_command);
 
   struct packet_master convertToRobotPacket(const Command& cmd);
 
-  void updateRobotsCommands();
+  // serializes the sends of the control loop and the requests of the emergency stops and of the viewer
+  std::mutex mutex_;
+
   void updateElectronicInformations();
   void send();
 
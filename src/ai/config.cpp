@@ -23,7 +23,15 @@ bool Config::we_are_blue = true;
 bool Config::is_in_simulation = true;
 bool Config::is_in_mixcontrol = false;
 double Config::period = 0.01;
+double Config::control_rate = 0.0;
+bool Config::latency_compensation = false;
+double Config::actuation_delay = 0.0;
+bool Config::orca = false;
+int Config::behavior_threads = 0;
+double Config::refinement_budget = 0.002;
+std::vector<std::string> Config::prewarm_strategies;
 bool Config::ntpd_enable = false;
+std::string Config::radio_metrics_file = "";
 
 double Config::robot_radius = 0.09;
 double Config::ball_radius = 0.021375;
@@ -122,6 +130,10 @@ void Config::load(const std::string& config_path)
 
   enable_movement_with_integration = root["movement_prediction"]["enable_integration"].asBool();
 
+  latency_compensation = root["latency"]["compensation"].asBool();
+  actuation_delay = root["latency"]["actuation_delay"][is_in_simulation ? "simu" : "real"].asDouble();
+  assert(actuation_delay >= 0.0);
+
   if (is_in_simulation)
   {
     DEBUG("SIMULATION MODE ACTIVATED");
@@ -2,6 +2,8 @@
 
 #include <math/vector2d.h>
 #include <execution_manager.h>
+#include <string>
+#include <vector>
 
 namespace rhoban_ssl
 {
@@ -49,6 +51,20 @@ struct Config
   static bool is_in_simulation;
 
   static double period;
+  // rate (Hz) of the control loop thread sending the commands, 0 to send them in the strategy loop
+  static double control_rate;
+  // commands computed on the state predicted when they are executed (see control::LatencyModel)
+  static bool latency_compensation;
+  // delay (s) between the reception of a command by the robot and its effect, fitted offline
+  static double actuation_delay;
+  // velocities of the allied robots made collision free together (see control::Orca)
+  static bool orca;
+  // threads (in addition to the ai one) updating the behaviors of the robots, 0 to update them one after another
+  static int behavior_threads;
+  // time (s) given to the anytime refinement of the strategies at each tick (see Strategy::refine())
+  static double refinement_budget;
+  // strategies constructed when a manager is set rather than at their first use ("all" for all of them)
+  static std::vector<std::string> prewarm_strategies;
 
   static bool is_in_mixcontrol;
 
@@ -109,6 +125,9 @@ struct Config
 
   static bool ntpd_enable;
 
+  // csv file receiving the radio link statistics every second (none if empty)
+  static std::string radio_metrics_file;
+
   static void load(const std::string& config_path);
 };
 }  // namespace ai
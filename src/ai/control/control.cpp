@@ -156,42 +156,46 @@ LimitVelocities::LimitVelocities()
 {
 }
 
+void LimitVelocities::limit(const Kinematic& kinematic, Control& ctrl)
+{
+  Kinematic::WheelsSpeed wheels_speed =
+      kinematic.compute(ctrl.linear_velocity.getX(), ctrl.linear_velocity.getY(), ctrl.angular_velocity.value());
+
+  double lambda_1 = 1.0;
+  double lambda_2 = 1.0;
+  double lambda_3 = 1.0;
+  double lambda_4 = 1.0;
+
+  if (abs(wheels_speed.frontLeft) > ai::Config::max_wheel_speed)
+    lambda_1 = ai::Config::max_wheel_speed / abs(wheels_speed.frontLeft);
+  if (abs(wheels_speed.frontRight) > ai::Config::max_wheel_speed)
+    lambda_2 = ai::Config::max_wheel_speed / abs(wheels_speed.frontRight);
+  if (abs(wheels_speed.backLeft) > ai::Config::max_wheel_speed)
+    lambda_3 = ai::Config::max_wheel_speed / abs(wheels_speed.backLeft);
+  if (abs(wheels_speed.backRight) > ai::Config::max_wheel_speed)
+    lambda_4 = ai::Config::max_wheel_speed / abs(wheels_speed.backRight);
+
+  double lambda = std::min(lambda_1, lambda_2);
+  lambda = std::min(lambda, lambda_3);
+  lambda = std::min(lambda, lambda_4);
+
+  if (lambda < 1.0)
+  {
+    //      std::cerr << "WARNING: ROBOT " << i << " reached the wheel's speed limit! " << ctrl.linear_velocity.norm()
+    //                << std::endl;
+    ctrl.linear_velocity *= lambda;
+    ctrl.angular_velocity *= lambda;
+    //      std::cerr << "WARNING: ROBOT " << lambda << " reached the wheel's speed limit! " <<
+    //      ctrl.linear_velocity.norm()
+    //                << std::endl;
+  }
+}
+
 bool LimitVelocities::runTask()
 {
   for (uint i = 0; i < Data::get()->shared_data.final_control_for_robots.size(); ++i)
   {
-    Control& ctrl = Data::get()->shared_data.final_control_for_robots[i].control;
-    Kinematic::WheelsSpeed wheels_speed =
-        kinematic_.compute(ctrl.linear_velocity.getX(), ctrl.linear_velocity.getY(), ctrl.angular_velocity.value());
-
-    double lambda_1 = 1.0;
-    double lambda_2 = 1.0;
-    double lambda_3 = 1.0;
-    double lambda_4 = 1.0;
-
-    if (abs(wheels_speed.frontLeft) > ai::Config::max_wheel_speed)
-      lambda_1 = ai::Config::max_wheel_speed / abs(wheels_speed.frontLeft);
-    if (abs(wheels_speed.frontRight) > ai::Config::max_wheel_speed)
-      lambda_2 = ai::Config::max_wheel_speed / abs(wheels_speed.frontRight);
-    if (abs(wheels_speed.backLeft) > ai::Config::max_wheel_speed)
-      lambda_3 = ai::Config::max_wheel_speed / abs(wheels_speed.backLeft);
-    if (abs(wheels_speed.backRight) > ai::Config::max_wheel_speed)
-      lambda_4 = ai::Config::max_wheel_speed / abs(wheels_speed.backRight);
-
-    double lambda = std::min(lambda_1, lambda_2);
-    lambda = std::min(lambda, lambda_3);
-    lambda = std::min(lambda, lambda_4);
-
-    if (lambda < 1.0)
-    {
-      //      std::cerr << "WARNING: ROBOT " << i << " reached the wheel's speed limit! " << ctrl.linear_velocity.norm()
-      //                << std::endl;
-      ctrl.linear_velocity *= lambda;
-      ctrl.angular_velocity *= lambda;
-      //      std::cerr << "WARNING: ROBOT " << lambda << " reached the wheel's speed limit! " <<
-      //      ctrl.linear_velocity.norm()
-      //                << std::endl;
-    }
+    limit(kinematic_, Data::get()->shared_data.final_control_for_robots[i].control);
   }
   return true;
 }
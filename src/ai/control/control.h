@@ -89,6 +89,11 @@ private:
 public:
   LimitVelocities();
   bool runTask();
+
+  /**
+   * @brief Scales down the control so that no wheel exceeds ai::Config::max_wheel_speed.
+   */
+  static void limit(const Kinematic& kinematic, Control& ctrl);
 };
 
 }  // namespace control
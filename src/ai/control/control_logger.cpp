@@ -0,0 +1,59 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "control_logger.h"
+#include <data.h>
+#include <debug.h>
+
+namespace rhoban_ssl
+{
+namespace control
+{
+ControlLogger::ControlLogger(const std::string& path) : out_(path)
+{
+  if (!out_.good())
+  {
+    DEBUG("can't open the control log " << path);
+  }
+  out_ << "time,robot,command_speed,command_angular,measured_speed,measured_angular,vision_delay,radio_rtt"
+       << std::endl;
+}
+
+bool ControlLogger::runTask()
+{
+  if (!out_.good())
+    return false;
+
+  double time = Data::get()->time.now();
+  for (uint robot_id = 0; robot_id < ai::Config::NB_OF_ROBOTS_BY_TEAM; ++robot_id)
+  {
+    const data::Robot& robot = Data::get()->robots[Ally][robot_id];
+    const Control& ctrl = Data::get()->shared_data.final_control_for_robots[robot_id].control;
+    if (!robot.isActive() || ctrl.ignore || !ctrl.active)
+      continue;
+
+    out_ << time << "," << robot_id << "," << ctrl.linear_velocity.norm() << "," << ctrl.angular_velocity.value()
+         << "," << robot.getMovement().linearVelocity(time).norm() << ","
+         << robot.getMovement().angularVelocity(time).value() << "," << Data::get()->latency.visionDelay() << ","
+         << Data::get()->latency.radioRtt() << "\n";
+  }
+  return true;
+}
+
+}  // namespace control
+}  // namespace rhoban_ssl
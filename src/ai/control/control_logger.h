@@ -0,0 +1,46 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <execution_manager.h>
+#include <fstream>
+#include <string>
+
+namespace rhoban_ssl
+{
+namespace control
+{
+/**
+ * @brief Writes the commands of the ally robots and their measured velocities in a csv file,
+ * to fit the latencies offline with the fit_latency executable.
+ *
+ * The logged values do not depend on the frame of the controls: linear speed and angular velocity.
+ */
+class ControlLogger : public Task
+{
+public:
+  explicit ControlLogger(const std::string& path);
+  bool runTask() override;
+
+private:
+  std::ofstream out_;
+};
+
+}  // namespace control
+}  // namespace rhoban_ssl
@@ -0,0 +1,169 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "control_loop.h"
+#include <data.h>
+#include <debug.h>
+#include <chrono>
+
+namespace rhoban_ssl
+{
+namespace control
+{
+ControlLoop::ControlLoop(double rate)
+  : commander_(new Commander()), period_(1.0 / rate), setpoints_time_(0.0), has_setpoints_(false), running_(true)
+{
+  stats_ = { 0, 0, 0, 0.0 };
+  thread_ = new std::thread([this]() { this->run(); });
+}
+
+ControlLoop::~ControlLoop()
+{
+  running_ = false;
+  thread_->join();
+  delete thread_;
+
+  Stats loop = stats();
+  DEBUG("control loop: " << loop.iterations << " iterations for " << loop.publications << " strategy ticks, "
+                         << loop.overruns << " overruns, max lateness " << loop.max_lateness * 1000 << " ms");
+  delete commander_;
+}
+
+bool ControlLoop::runTask()
+{
+  commander_->prepareControls();
+
+  double time = Data::get()->time.now();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (uint robot_id = 0; robot_id < ai::Config::NB_OF_ROBOTS_BY_TEAM; ++robot_id)
+  {
+    const SharedData::FinalControl& final_control = Data::get()->shared_data.final_control_for_robots[robot_id];
+    const data::Robot& robot = Data::get()->robots[Ally][robot_id];
+    Setpoint& setpoint = setpoints_[robot_id];
+
+    setpoint.control = final_control.control;
+    setpoint.from_ai =
+        !final_control.is_disabled_by_viewer && !final_control.is_manually_controled_by_viewer && robot.isActive();
+    setpoint.collision_is_detected = setpoint.from_ai && final_control.collision_is_detected;
+    if (setpoint.from_ai)
+    {
+      setpoint.orientation = robot.getMovement().angularPosition(Data::get()->latency.actuationTime(time));
+      setpoint.velocity = robot.getMovement().linearVelocity(time);
+    }
+  }
+  setpoints_time_ = time;
+  has_setpoints_ = true;
+  stats_.publications++;
+  return true;
+}
+
+ControlLoop::Stats ControlLoop::stats()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+void ControlLoop::computeControl(const Setpoint& setpoint, double elapsed, Control& ctrl)
+{
+  ctrl = setpoint.control;
+
+  if (setpoint.from_ai)
+  {
+    if (setpoint.collision_is_detected)
+    {
+      // the robot decelerates from its velocity at the last tick, at the maximal acceleration
+      double velocity_norm = setpoint.velocity.norm();
+      if (velocity_norm > 0.01)
+      {
+        double velocity_increase =
+            1 - (elapsed + period_) * ai::Config::translation_acceleration_limit / velocity_norm;
+        if (velocity_increase < 0.0)
+        {
+          velocity_increase = 0.0;
+        }
+        ctrl.linear_velocity = setpoint.velocity * velocity_increase;
+      }
+    }
+
+    // the robot turned since the last tick
+    ContinuousAngle orientation = setpoint.orientation + ctrl.angular_velocity * elapsed;
+    ctrl.changeToRelativeControl(orientation, period_);
+  }
+
+  LimitVelocities::limit(kinematic_, ctrl);
+}
+
+void ControlLoop::run()
+{
+  auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(period_));
+  auto next = std::chrono::steady_clock::now();
+
+  Setpoint setpoints[ai::Config::NB_OF_ROBOTS_BY_TEAM];
+  Control controls[ai::Config::NB_OF_ROBOTS_BY_TEAM];
+
+  while (running_)
+  {
+    double setpoints_time;
+    bool has_setpoints;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      has_setpoints = has_setpoints_;
+      setpoints_time = setpoints_time_;
+      if (has_setpoints)
+      {
+        std::copy(setpoints_, setpoints_ + ai::Config::NB_OF_ROBOTS_BY_TEAM, setpoints);
+      }
+    }
+
+    if (has_setpoints)
+    {
+      double elapsed = std::max(0.0, Data::get()->time.now() - setpoints_time);
+      for (uint robot_id = 0; robot_id < ai::Config::NB_OF_ROBOTS_BY_TEAM; ++robot_id)
+      {
+        computeControl(setpoints[robot_id], elapsed, controls[robot_id]);
+      }
+      commander_->sendControls(controls);
+    }
+
+    next += period;
+    auto now = std::chrono::steady_clock::now();
+    double lateness = (now > next) ? std::chrono::duration<double>(now - next).count() : 0.0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stats_.iterations++;
+      if (lateness > period_)
+      {
+        stats_.overruns++;
+      }
+      stats_.max_lateness = std::max(stats_.max_lateness, lateness);
+    }
+
+    if (now > next)
+    {
+      // no burst of iterations to catch up
+      next = now;
+    }
+    else
+    {
+      std::this_thread::sleep_until(next);
+    }
+  }
+}
+
+}  // namespace control
+}  // namespace rhoban_ssl
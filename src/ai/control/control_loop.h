@@ -0,0 +1,104 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "control.h"
+#include "kinematic.h"
+#include <execution_manager.h>
+#include <com/ai_commander.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace rhoban_ssl
+{
+namespace control
+{
+/**
+ * @brief Sends the commands of the robots from its own thread, at a higher rate than the strategy.
+ *
+ * Each strategy tick (runTask) publishes the final controls, still in the absolute
+ * frame, with the orientation and the velocity of each robot. At each of its periods,
+ * the loop thread takes the last published setpoints and:
+ *  - brakes the robots that are going to collide,
+ *  - changes the controls to the frame of the robots, with the orientation
+ *    extrapolated to the current time,
+ *  - limits the wheels speeds,
+ *  - sends the commands.
+ *
+ * It replaces the LimitVelocities and Commander tasks when ai::Config::control_rate is set.
+ */
+class ControlLoop : public Task
+{
+public:
+  struct Stats
+  {
+    unsigned long publications;
+    unsigned long iterations;
+    // iterations that started more than one period late
+    unsigned long overruns;
+    // seconds
+    double max_lateness;
+  };
+
+  /**
+   * @brief Constructor, creates the Commander and launches the loop thread.
+   * @param rate the frequency (Hz) of the loop
+   */
+  explicit ControlLoop(double rate);
+
+  /**
+   * @brief Stops the loop thread, the Commander stops the robots.
+   */
+  ~ControlLoop();
+
+  bool runTask() override;
+
+  Stats stats();
+
+private:
+  struct Setpoint
+  {
+    Control control;
+    // the control comes from the ai (not from the viewer) and has to be braked and changed of frame
+    bool from_ai;
+    bool collision_is_detected;
+    ContinuousAngle orientation;
+    Vector2d velocity;
+  };
+
+  Commander* commander_;
+  Kinematic kinematic_;
+  double period_;
+
+  std::mutex mutex_;
+  Setpoint setpoints_[ai::Config::NB_OF_ROBOTS_BY_TEAM];
+  double setpoints_time_;
+  bool has_setpoints_;
+  Stats stats_;
+
+  std::atomic<bool> running_;
+  std::thread* thread_;
+
+  void run();
+  void computeControl(const Setpoint& setpoint, double elapsed, Control& ctrl);
+};
+
+}  // namespace control
+}  // namespace rhoban_ssl
@@ -0,0 +1,136 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "latency_model.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace rhoban_ssl
+{
+namespace control
+{
+namespace
+{
+// weight of a new frame in the vision delay of a camera
+constexpr double VISION_SMOOTHING = 0.1;
+// the delays above are considered as clock errors
+constexpr double MAX_VISION_DELAY = 0.5;
+}  // namespace
+
+LatencyModel::LatencyModel() : radio_rtt_(0.0)
+{
+  for (std::atomic<double>& delay : vision_delays_)
+  {
+    delay = 0.0;
+  }
+}
+
+void LatencyModel::addVisionSample(unsigned int camera_id, double delay)
+{
+  if (camera_id >= ai::Config::NB_CAMERAS || delay < 0.0 || delay > MAX_VISION_DELAY)
+    return;
+
+  // only the vision thread writes the delays
+  double previous = vision_delays_[camera_id];
+  vision_delays_[camera_id] = (previous > 0.0) ? previous + VISION_SMOOTHING * (delay - previous) : delay;
+}
+
+double LatencyModel::visionDelay(unsigned int camera_id) const
+{
+  return (camera_id < ai::Config::NB_CAMERAS) ? vision_delays_[camera_id].load() : 0.0;
+}
+
+double LatencyModel::visionDelay() const
+{
+  double sum = 0.0;
+  int nb_cameras = 0;
+  for (const std::atomic<double>& delay : vision_delays_)
+  {
+    if (delay > 0.0)
+    {
+      sum += delay;
+      nb_cameras++;
+    }
+  }
+  return (nb_cameras > 0) ? sum / nb_cameras : 0.0;
+}
+
+void LatencyModel::setRadioRtt(double rtt)
+{
+  radio_rtt_ = rtt;
+}
+
+double LatencyModel::radioRtt() const
+{
+  return radio_rtt_;
+}
+
+double LatencyModel::actuationDelay() const
+{
+  return radio_rtt_ / 2.0 + ai::Config::actuation_delay;
+}
+
+double LatencyModel::actuationTime(double time) const
+{
+  return ai::Config::latency_compensation ? time + actuationDelay() : time;
+}
+
+double LatencyModel::fitDelay(const std::vector<Sample>& commands, const std::vector<Sample>& observations,
+                              double max_delay, double step, double* error)
+{
+  double best_delay = 0.0;
+  double best_error = std::numeric_limits<double>::infinity();
+  if (commands.empty() || step <= 0.0)
+  {
+    if (error != nullptr)
+      *error = best_error;
+    return best_delay;
+  }
+
+  for (double delay = 0.0; delay <= max_delay + step / 2; delay += step)
+  {
+    double sum = 0.0;
+    unsigned long nb_samples = 0;
+    size_t command = 0;
+    for (const Sample& observation : observations)
+    {
+      double command_time = observation.time - delay;
+      if (command_time < commands.front().time)
+        continue;
+      // the last command sent before command_time (the observations are sorted)
+      while (command + 1 < commands.size() && commands[command + 1].time <= command_time)
+        command++;
+      double diff = observation.value - commands[command].value;
+      sum += diff * diff;
+      nb_samples++;
+    }
+    if (nb_samples > 0 && sum / nb_samples < best_error)
+    {
+      best_error = sum / nb_samples;
+      best_delay = delay;
+    }
+  }
+
+  if (error != nullptr)
+    *error = std::sqrt(best_error);
+  return best_delay;
+}
+
+}  // namespace control
+}  // namespace rhoban_ssl
@@ -0,0 +1,99 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <config.h>
+#include <atomic>
+#include <vector>
+
+namespace rhoban_ssl
+{
+namespace control
+{
+/**
+ * @brief Delays between the world and the commands of the robots.
+ *
+ * - the vision delay is the age of the last detection frame of each camera when
+ *   it is processed (its capture time is synchronized with the program time line),
+ * - the actuation delay is the time for a command to reach the motors: half the
+ *   radio round-trip time, plus ai::Config::actuation_delay fitted offline (see
+ *   fitDelay() and the fit_latency executable).
+ *
+ * When ai::Config::latency_compensation is set, the behaviors and the change of frame
+ * of the controls use the state of the robots predicted at actuationTime().
+ *
+ * The delays can be read from any thread.
+ */
+class LatencyModel
+{
+public:
+  struct Sample
+  {
+    double time;
+    double value;
+  };
+
+  LatencyModel();
+
+  void addVisionSample(unsigned int camera_id, double delay);
+
+  /**
+   * @brief Smoothed vision delay of a camera (seconds), 0 before its first frame.
+   */
+  double visionDelay(unsigned int camera_id) const;
+
+  /**
+   * @brief Mean of the vision delays of the cameras seen.
+   */
+  double visionDelay() const;
+
+  void setRadioRtt(double rtt);
+  double radioRtt() const;
+
+  /**
+   * @brief Delay between the send of a command and its execution by the robot (seconds).
+   */
+  double actuationDelay() const;
+
+  /**
+   * @brief The time at which a command sent at the given time is executed,
+   * or the given time if the latency compensation is disabled.
+   */
+  double actuationTime(double time) const;
+
+  /**
+   * @brief Finds the delay between a command and its observed effect.
+   *
+   * The commands are held constant between their samples. The result is the delay,
+   * between 0 and max_delay by steps of step, that minimizes the squared error
+   * between the observations and the delayed commands.
+   * @param commands the samples of the command, sorted by time
+   * @param observations the samples of the measured value, sorted by time
+   * @param error receives the root mean square error for the delay found
+   */
+  static double fitDelay(const std::vector<Sample>& commands, const std::vector<Sample>& observations,
+                         double max_delay, double step, double* error = nullptr);
+
+private:
+  std::atomic<double> vision_delays_[ai::Config::NB_CAMERAS];
+  std::atomic<double> radio_rtt_;
+};
+
+}  // namespace control
+}  // namespace rhoban_ssl
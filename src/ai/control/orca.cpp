@@ -0,0 +1,322 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "orca.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace rhoban_ssl
+{
+namespace control
+{
+namespace
+{
+constexpr double EPSILON = 1e-5;
+
+double det(const Vector2d& a, const Vector2d& b)
+{
+  return a[0] * b[1] - a[1] * b[0];
+}
+
+double dot(const Vector2d& a, const Vector2d& b)
+{
+  return a[0] * b[0] + a[1] * b[1];
+}
+}  // namespace
+
+Orca::Orca(double time_horizon, double time_step) : time_horizon_(time_horizon), time_step_(time_step), max_reach_(0.0)
+{
+}
+
+void Orca::findNeighbors(const std::vector<Agent>& agents, int agent)
+{
+  neighbors_.clear();
+  const Agent& a = agents[agent];
+  // Distance travelled by the agent during the horizon, plus its radius
+  double reach = time_horizon_ * a.max_velocity + a.radius;
+
+  // sorted_ is sorted along x: we sweep from the position of the agent in both directions
+  size_t index = rank_[agent];
+  double max_range = reach + max_reach_;
+  for (int direction = -1; direction <= 1; direction += 2)
+  {
+    for (long i = static_cast<long>(index) + direction; i >= 0 && i < static_cast<long>(sorted_.size()); i += direction)
+    {
+      const Agent& b = agents[sorted_[i]];
+      if (std::fabs(b.position[0] - a.position[0]) > max_range)
+      {
+        break;
+      }
+      double range = reach + time_horizon_ * b.max_velocity + b.radius;
+      double square_distance = (b.position - a.position).normSquare();
+      if (square_distance < range * range)
+      {
+        neighbors_.push_back(std::make_pair(square_distance, sorted_[i]));
+      }
+    }
+  }
+  if (neighbors_.size() > MAX_NEIGHBORS)
+  {
+    std::nth_element(neighbors_.begin(), neighbors_.begin() + MAX_NEIGHBORS, neighbors_.end());
+    neighbors_.resize(MAX_NEIGHBORS);
+  }
+  // The closest neighbors first: they are the most important constraints of the linear program
+  std::sort(neighbors_.begin(), neighbors_.end());
+}
+
+void Orca::computeLines(const std::vector<Agent>& agents, int agent)
+{
+  lines_.clear();
+  const Agent& a = agents[agent];
+  double inverse_time_horizon = 1.0 / time_horizon_;
+
+  for (const std::pair<double, int>& neighbor : neighbors_)
+  {
+    const Agent& b = agents[neighbor.second];
+    Vector2d relative_position = b.position - a.position;
+    Vector2d relative_velocity = a.velocity - b.velocity;
+    double square_distance = relative_position.normSquare();
+    double combined_radius = a.radius + b.radius;
+    double square_combined_radius = combined_radius * combined_radius;
+
+    Line line;
+    Vector2d u;
+    if (square_distance > square_combined_radius)
+    {
+      // No collision: w goes from the cut-off center to the relative velocity
+      Vector2d w = relative_velocity - relative_position * inverse_time_horizon;
+      double square_w = w.normSquare();
+      double dot_product = dot(w, relative_position);
+      if (dot_product < 0.0 && dot_product * dot_product > square_combined_radius * square_w)
+      {
+        // Projection on the cut-off circle
+        double w_length = std::sqrt(square_w);
+        Vector2d unit_w = w / w_length;
+        line.direction = Vector2d(unit_w[1], -unit_w[0]);
+        u = unit_w * (combined_radius * inverse_time_horizon - w_length);
+      }
+      else
+      {
+        // Projection on the legs of the cone
+        double leg = std::sqrt(square_distance - square_combined_radius);
+        if (det(relative_position, w) > 0.0)
+        {
+          line.direction = Vector2d(relative_position[0] * leg - relative_position[1] * combined_radius,
+                                    relative_position[0] * combined_radius + relative_position[1] * leg) /
+                           square_distance;
+        }
+        else
+        {
+          line.direction = -Vector2d(relative_position[0] * leg + relative_position[1] * combined_radius,
+                                     -relative_position[0] * combined_radius + relative_position[1] * leg) /
+                           square_distance;
+        }
+        u = line.direction * dot(relative_velocity, line.direction) - relative_velocity;
+      }
+    }
+    else
+    {
+      // Collision: the agents must be apart at the next step
+      double inverse_time_step = 1.0 / time_step_;
+      Vector2d w = relative_velocity - relative_position * inverse_time_step;
+      double w_length = w.norm();
+      Vector2d unit_w = w_length > 0.0 ? w / w_length : Vector2d(-1.0, 0.0);
+      line.direction = Vector2d(unit_w[1], -unit_w[0]);
+      u = unit_w * (combined_radius * inverse_time_step - w_length);
+    }
+
+    double responsibility = b.cooperative ? 0.5 : 1.0;
+    line.point = a.velocity + u * responsibility;
+    lines_.push_back(line);
+  }
+}
+
+bool Orca::linearProgram1(const std::vector<Line>& lines, size_t line, double radius, const Vector2d& optimum,
+                          bool direction_optimization, Vector2d& result)
+{
+  double dot_product = dot(lines[line].point, lines[line].direction);
+  double discriminant = dot_product * dot_product + radius * radius - lines[line].point.normSquare();
+  if (discriminant < 0.0)
+  {
+    // The maximal velocity disk doesn't reach the line
+    return false;
+  }
+  double sqrt_discriminant = std::sqrt(discriminant);
+  double t_left = -dot_product - sqrt_discriminant;
+  double t_right = -dot_product + sqrt_discriminant;
+
+  for (size_t i = 0; i < line; ++i)
+  {
+    double denominator = det(lines[line].direction, lines[i].direction);
+    double numerator = det(lines[i].direction, lines[line].point - lines[i].point);
+    if (std::fabs(denominator) <= EPSILON)
+    {
+      // Parallel lines
+      if (numerator < 0.0)
+      {
+        return false;
+      }
+      continue;
+    }
+    double t = numerator / denominator;
+    if (denominator >= 0.0)
+    {
+      t_right = std::min(t_right, t);
+    }
+    else
+    {
+      t_left = std::max(t_left, t);
+    }
+    if (t_left > t_right)
+    {
+      return false;
+    }
+  }
+
+  if (direction_optimization)
+  {
+    result = lines[line].point + lines[line].direction * (dot(optimum, lines[line].direction) > 0.0 ? t_right : t_left);
+  }
+  else
+  {
+    double t = dot(lines[line].direction, optimum - lines[line].point);
+    result = lines[line].point + lines[line].direction * std::min(t_right, std::max(t_left, t));
+  }
+  return true;
+}
+
+size_t Orca::linearProgram2(const std::vector<Line>& lines, double radius, const Vector2d& optimum,
+                            bool direction_optimization, Vector2d& result)
+{
+  if (direction_optimization)
+  {
+    // optimum is a unit direction
+    result = optimum * radius;
+  }
+  else if (optimum.normSquare() > radius * radius)
+  {
+    result = optimum * (radius / optimum.norm());
+  }
+  else
+  {
+    result = optimum;
+  }
+
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    if (det(lines[i].direction, lines[i].point - result) > 0.0)
+    {
+      // The result is not in the half-plane of the line
+      Vector2d previous = result;
+      if (!linearProgram1(lines, i, radius, optimum, direction_optimization, result))
+      {
+        result = previous;
+        return i;
+      }
+    }
+  }
+  return lines.size();
+}
+
+void Orca::linearProgram3(size_t begin_line, double radius, Vector2d& result)
+{
+  // Minimizes the maximal distance to the half-planes, from the first infeasible line
+  double distance = 0.0;
+  for (size_t i = begin_line; i < lines_.size(); ++i)
+  {
+    if (det(lines_[i].direction, lines_[i].point - result) <= distance)
+    {
+      continue;
+    }
+    projected_lines_.clear();
+    for (size_t j = 0; j < i; ++j)
+    {
+      Line line;
+      double determinant = det(lines_[i].direction, lines_[j].direction);
+      if (std::fabs(determinant) <= EPSILON)
+      {
+        if (dot(lines_[i].direction, lines_[j].direction) > 0.0)
+        {
+          // Same direction
+          continue;
+        }
+        line.point = (lines_[i].point + lines_[j].point) * 0.5;
+      }
+      else
+      {
+        line.point = lines_[i].point +
+                     lines_[i].direction * (det(lines_[j].direction, lines_[i].point - lines_[j].point) / determinant);
+      }
+      line.direction = normalized(lines_[j].direction - lines_[i].direction);
+      projected_lines_.push_back(line);
+    }
+
+    Vector2d previous = result;
+    if (linearProgram2(projected_lines_, radius, Vector2d(-lines_[i].direction[1], lines_[i].direction[0]), true,
+                       result) < projected_lines_.size())
+    {
+      // Should not happen: the result is already in this linear program, it is kept.
+      result = previous;
+    }
+    distance = det(lines_[i].direction, lines_[i].point - result);
+  }
+}
+
+void Orca::computeVelocities(const std::vector<Agent>& agents, std::vector<Vector2d>& velocities)
+{
+  velocities.resize(agents.size());
+  sorted_.resize(agents.size());
+  for (size_t i = 0; i < agents.size(); ++i)
+  {
+    sorted_[i] = i;
+  }
+  std::sort(sorted_.begin(), sorted_.end(),
+            [&](int i, int j) { return agents[i].position[0] < agents[j].position[0]; });
+  rank_.resize(agents.size());
+  max_reach_ = 0.0;
+  for (size_t k = 0; k < agents.size(); ++k)
+  {
+    rank_[sorted_[k]] = k;
+    max_reach_ = std::max(max_reach_, time_horizon_ * agents[k].max_velocity + agents[k].radius);
+  }
+
+  for (size_t i = 0; i < agents.size(); ++i)
+  {
+    const Agent& agent = agents[i];
+    if (!agent.cooperative)
+    {
+      velocities[i] = agent.velocity;
+      continue;
+    }
+    findNeighbors(agents, i);
+    computeLines(agents, i);
+
+    Vector2d result;
+    size_t failure = linearProgram2(lines_, agent.max_velocity, agent.preferred_velocity, false, result);
+    if (failure < lines_.size())
+    {
+      linearProgram3(failure, agent.max_velocity, result);
+    }
+    velocities[i] = result;
+  }
+}
+
+}  // namespace control
+}  // namespace rhoban_ssl
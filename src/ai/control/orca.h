@@ -0,0 +1,105 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <math/vector2d.h>
+#include <vector>
+#include <utility>
+
+namespace rhoban_ssl
+{
+namespace control
+{
+/**
+ * @brief Optimal Reciprocal Collision Avoidance ("Reciprocal n-body collision avoidance",
+ * van den Berg, Guy, Lin and Manocha) for all the robots at once.
+ *
+ * For each cooperative agent, each neighbor gives a half-plane of velocities that avoid the
+ * collision during the time horizon. The new velocity is the closest one to the preferred velocity
+ * in all the half-planes and in the disk of the maximal velocity, found by an incremental
+ * 2D linear program (or the velocity that violates the half-planes the least when they are infeasible).
+ *
+ * Cooperative agents take half of the avoidance of each other, the other agents (opponents,
+ * robots that are not controlled) are obstacles that keep their velocity: the cooperative
+ * agent takes the whole avoidance.
+ *
+ * The neighbors are found by sweeping the agents sorted along x, and only the MAX_NEIGHBORS
+ * closest ones are used, so the work per agent is bounded.
+ */
+class Orca
+{
+public:
+  static constexpr int MAX_NEIGHBORS = 8;
+
+  struct Agent
+  {
+    Vector2d position;
+    Vector2d velocity;
+    Vector2d preferred_velocity;
+    double radius;
+    double max_velocity;
+    // a cooperative agent gets a new velocity, the others are only obstacles
+    bool cooperative;
+  };
+
+private:
+  struct Line
+  {
+    Vector2d point;
+    Vector2d direction;
+  };
+
+  double time_horizon_;
+  double time_step_;
+
+  // indices of the agents sorted along x, and the position of each agent in it
+  std::vector<int> sorted_;
+  std::vector<size_t> rank_;
+  // maximal distance travelled by an agent during the horizon, plus its radius
+  double max_reach_;
+  std::vector<std::pair<double, int>> neighbors_;
+  std::vector<Line> lines_;
+  std::vector<Line> projected_lines_;
+
+  void findNeighbors(const std::vector<Agent>& agents, int agent);
+  void computeLines(const std::vector<Agent>& agents, int agent);
+
+  static bool linearProgram1(const std::vector<Line>& lines, size_t line, double radius, const Vector2d& optimum,
+                             bool direction_optimization, Vector2d& result);
+  static size_t linearProgram2(const std::vector<Line>& lines, double radius, const Vector2d& optimum,
+                               bool direction_optimization, Vector2d& result);
+  void linearProgram3(size_t begin_line, double radius, Vector2d& result);
+
+public:
+  /**
+   * @param time_horizon the collisions are avoided during this time (s)
+   * @param time_step the period of the commands (s), used when the agents already overlap
+   */
+  Orca(double time_horizon, double time_step);
+
+  /**
+   * @brief Computes the new velocity of each agent (the preferred velocity is kept if there is no agent around).
+   * @param agents all the agents
+   * @param velocities receives the velocities, in the order of the agents
+   */
+  void computeVelocities(const std::vector<Agent>& agents, std::vector<Vector2d>& velocities);
+};
+
+}  // namespace control
+}  // namespace rhoban_ssl
@@ -0,0 +1,73 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "latency_model.h"
+
+using namespace rhoban_ssl;
+
+TEST(test_latency_model, fit_delay)
+{
+  // steps of command every 0.2 s, observed 45 ms later with some noise
+  std::vector<control::LatencyModel::Sample> commands, observations;
+  for (int i = 0; i < 1000; ++i)
+  {
+    double t = i * 0.01;
+    double command = (i / 20) % 2 ? 1.0 : -1.0;
+    commands.push_back({ t, command });
+    double delayed = ((t - 0.045) >= 0 && int((t - 0.045) / 0.2 + 1e-9) % 2) ? 1.0 : -1.0;
+    observations.push_back({ t, delayed + 0.01 * std::sin(17.0 * t) });
+  }
+
+  double error;
+  double delay = control::LatencyModel::fitDelay(commands, observations, 0.2, 0.005, &error);
+  EXPECT_NEAR(delay, 0.045, 0.0051);
+  EXPECT_LT(error, 0.1);
+}
+
+TEST(test_latency_model, delays)
+{
+  control::LatencyModel latency;
+  EXPECT_DOUBLE_EQ(latency.visionDelay(), 0.0);
+
+  latency.addVisionSample(0, 0.02);
+  latency.addVisionSample(1, 0.04);
+  latency.addVisionSample(1, 3.0);  // clock error, ignored
+  EXPECT_DOUBLE_EQ(latency.visionDelay(1), 0.04);
+  EXPECT_DOUBLE_EQ(latency.visionDelay(), 0.03);
+
+  latency.setRadioRtt(0.01);
+  ai::Config::actuation_delay = 0.02;
+  EXPECT_DOUBLE_EQ(latency.actuationDelay(), 0.025);
+
+  ai::Config::latency_compensation = false;
+  EXPECT_DOUBLE_EQ(latency.actuationTime(1.0), 1.0);
+  ai::Config::latency_compensation = true;
+  EXPECT_DOUBLE_EQ(latency.actuationTime(1.0), 1.025);
+  ai::Config::latency_compensation = false;
+  ai::Config::actuation_delay = 0.0;
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <debug.h>
+#include "orca.h"
+#include <cmath>
+
+using namespace rhoban_ssl::control;
+
+namespace
+{
+const double RADIUS = 0.09;
+const double MAX_VELOCITY = 2.0;
+const double DT = 0.01;
+
+Orca::Agent agent(const Vector2d& position, const Vector2d& preferred_velocity, bool cooperative = true)
+{
+  return { position, preferred_velocity, preferred_velocity, RADIUS, MAX_VELOCITY, cooperative };
+}
+
+// Moves the agents to their goals and returns the minimal distance between two agents
+double simulate(std::vector<Orca::Agent>& agents, const std::vector<Vector2d>& goals, double duration)
+{
+  Orca orca(0.5, DT);
+  std::vector<Vector2d> velocities;
+  double min_distance = 1e9;
+  for (double t = 0; t < duration; t += DT)
+  {
+    for (size_t i = 0; i < agents.size(); ++i)
+    {
+      if (agents[i].cooperative)
+      {
+        Vector2d to_goal = goals[i] - agents[i].position;
+        double speed = std::min(MAX_VELOCITY, to_goal.norm() / 0.2);
+        agents[i].preferred_velocity = to_goal.norm() > 1e-9 ? to_goal * (speed / to_goal.norm()) : Vector2d(0, 0);
+      }
+    }
+    orca.computeVelocities(agents, velocities);
+    for (size_t i = 0; i < agents.size(); ++i)
+    {
+      agents[i].velocity = velocities[i];
+      agents[i].position += velocities[i] * DT;
+    }
+    for (size_t i = 0; i < agents.size(); ++i)
+    {
+      for (size_t j = i + 1; j < agents.size(); ++j)
+      {
+        min_distance = std::min(min_distance, (agents[i].position - agents[j].position).norm());
+      }
+    }
+  }
+  return min_distance;
+}
+}  // namespace
+
+TEST(test_orca, free_agent)
+{
+  Orca orca(0.5, DT);
+  std::vector<Orca::Agent> agents = { agent(Vector2d(0, 0), Vector2d(1.0, 0.5)),
+                                      agent(Vector2d(0, 0.5), Vector2d(3.0, 0.0)),
+                                      agent(Vector2d(5, 0), Vector2d(0.0, 1.0), false) };
+  agents[1].position = Vector2d(-4, 2);
+  std::vector<Vector2d> velocities;
+  orca.computeVelocities(agents, velocities);
+  ASSERT_EQ(velocities.size(), 3u);
+  EXPECT_NEAR((velocities[0] - Vector2d(1.0, 0.5)).norm(), 0.0, 1e-9);
+  // Limited to the maximal velocity
+  EXPECT_NEAR((velocities[1] - Vector2d(MAX_VELOCITY, 0.0)).norm(), 0.0, 1e-9);
+  // The non cooperative agent keeps its velocity
+  EXPECT_NEAR((velocities[2] - Vector2d(0.0, 1.0)).norm(), 0.0, 1e-9);
+}
+
+TEST(test_orca, crossing_agents)
+{
+  // Head-on: both agents avoid, on opposite sides
+  std::vector<Orca::Agent> agents = { agent(Vector2d(-1.5, 0.01), Vector2d(0, 0)),
+                                      agent(Vector2d(1.5, -0.01), Vector2d(0, 0)) };
+  std::vector<Vector2d> goals = { Vector2d(1.5, 0.0), Vector2d(-1.5, 0.0) };
+  EXPECT_GT(simulate(agents, goals, 4.0), 2 * RADIUS - 0.01);
+  EXPECT_LT((agents[0].position - goals[0]).norm(), 0.05);
+  EXPECT_LT((agents[1].position - goals[1]).norm(), 0.05);
+
+  // A static opponent: only the cooperative agent avoids
+  agents = { agent(Vector2d(-1.5, 0.01), Vector2d(0, 0)), agent(Vector2d(0.0, 0.0), Vector2d(0, 0), false) };
+  goals = { Vector2d(1.5, 0.0), Vector2d(0.0, 0.0) };
+  EXPECT_GT(simulate(agents, goals, 4.0), 2 * RADIUS - 0.01);
+  EXPECT_LT((agents[0].position - goals[0]).norm(), 0.05);
+  EXPECT_EQ(agents[1].position, Vector2d(0.0, 0.0));
+}
+
+TEST(test_orca, crowd)
+{
+  // Agents on a circle going to the opposite point (not exactly, a symmetric crowd is a deadlock)
+  std::vector<Orca::Agent> agents;
+  std::vector<Vector2d> goals;
+  int nb_agents = 16;
+  for (int i = 0; i < nb_agents; ++i)
+  {
+    double angle = 2 * M_PI * i / nb_agents;
+    Vector2d position(1.5 * std::cos(angle), 1.5 * std::sin(angle));
+    agents.push_back(agent(position, Vector2d(0, 0)));
+    goals.push_back(Vector2d(-1.5 * std::cos(angle + 0.05 * i), -1.5 * std::sin(angle + 0.05 * i)));
+  }
+  EXPECT_GT(simulate(agents, goals, 8.0), 2 * RADIUS - 0.02);
+  for (int i = 0; i < nb_agents; ++i)
+  {
+    EXPECT_LT((agents[i].position - goals[i]).norm(), 0.2);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
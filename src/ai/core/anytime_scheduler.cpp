@@ -0,0 +1,89 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "anytime_scheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+
+namespace rhoban_ssl
+{
+AnytimeScheduler::AnytimeScheduler() : next_(0)
+{
+  stats_ = { 0, 0, 0, 0.0, 0.0, 0.0, 0.0, false };
+}
+
+bool AnytimeScheduler::run(unsigned int nb_computations, const std::function<bool(unsigned int)>& step, double budget)
+{
+  typedef std::chrono::steady_clock Clock;
+  Clock::time_point start = Clock::now();
+
+  std::vector<bool> done(nb_computations, false);
+  unsigned int nb_done = 0;
+  unsigned int i = nb_computations > 0 ? next_ % nb_computations : 0;
+  double elapsed = 0.0;
+  while (nb_done < nb_computations)
+  {
+    if (!done[i])
+    {
+      stats_.nb_steps++;
+      if (!step(i))
+      {
+        done[i] = true;
+        nb_done++;
+      }
+      elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    i = (i + 1) % nb_computations;
+    if (elapsed >= budget)
+    {
+      break;
+    }
+  }
+  next_ = i;
+
+  bool pending = nb_done < nb_computations;
+  stats_.nb_ticks++;
+  if (pending)
+  {
+    stats_.nb_exhausted_ticks++;
+  }
+  stats_.last_duration = elapsed;
+  stats_.max_duration = std::max(stats_.max_duration, elapsed);
+  stats_.total_duration += elapsed;
+  stats_.budget = budget;
+  stats_.pending = pending;
+  return pending;
+}
+
+const AnytimeScheduler::Stats& AnytimeScheduler::stats() const
+{
+  return stats_;
+}
+
+void AnytimeScheduler::printStats(std::ostream& out) const
+{
+  double mean = stats_.nb_ticks > 0 ? stats_.total_duration / stats_.nb_ticks : 0.0;
+  out << "Anytime refinement: " << stats_.nb_steps << " steps in " << stats_.nb_ticks << " ticks, "
+      << stats_.nb_exhausted_ticks << " ticks out of budget (" << stats_.budget * 1000.0 << " ms), mean "
+      << std::setprecision(3) << mean * 1000.0 << " ms, max " << stats_.max_duration * 1000.0 << " ms" << std::endl;
+}
+
+}  // namespace rhoban_ssl
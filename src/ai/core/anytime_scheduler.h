@@ -0,0 +1,74 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <functional>
+#include <ostream>
+
+namespace rhoban_ssl
+{
+/**
+ * @brief Runs the refinement steps of several anytime computations in a time budget.
+ *
+ * Each computation improves its answer step by step and keeps the best answer found so
+ * far. At each tick, run() calls the steps of the computations that have work left in
+ * turn until the budget is spent: a step is never interrupted, so it must be short. The
+ * unfinished computations go on at the next tick, starting with the one that was next in
+ * turn so that none of them is starved.
+ */
+class AnytimeScheduler
+{
+public:
+  struct Stats
+  {
+    unsigned long nb_ticks;
+    unsigned long nb_steps;
+    // ticks that ended with work left because the budget was spent
+    unsigned long nb_exhausted_ticks;
+    // durations in seconds
+    double last_duration;
+    double max_duration;
+    double total_duration;
+    double budget;
+    // work was left at the end of the last tick
+    bool pending;
+  };
+
+private:
+  unsigned int next_;
+  Stats stats_;
+
+public:
+  AnytimeScheduler();
+
+  /**
+   * @brief Runs the steps in the budget.
+   * @param nb_computations the number of computations
+   * @param step runs one step of a computation, returns false if it has nothing left to refine
+   * @param budget in seconds, at least one step is run if there is work left
+   * @return true if work is left
+   */
+  bool run(unsigned int nb_computations, const std::function<bool(unsigned int)>& step, double budget);
+
+  const Stats& stats() const;
+  void printStats(std::ostream& out) const;
+};
+
+}  // namespace rhoban_ssl
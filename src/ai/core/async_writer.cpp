@@ -0,0 +1,86 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "async_writer.h"
+
+namespace rhoban_ssl
+{
+AsyncWriter::AsyncWriter(const std::string& path) : out_(path), running_(true)
+{
+  if (out_.good())
+  {
+    thread_ = std::thread(&AsyncWriter::run, this);
+  }
+}
+
+AsyncWriter::~AsyncWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  cond_.notify_one();
+  if (thread_.joinable())
+  {
+    thread_.join();
+  }
+}
+
+bool AsyncWriter::good() const
+{
+  return thread_.joinable();
+}
+
+void AsyncWriter::write(const std::string& text)
+{
+  if (!good())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ += text;
+  }
+  cond_.notify_one();
+}
+
+void AsyncWriter::run()
+{
+  std::string text;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true)
+  {
+    cond_.wait(lock, [this] { return !pending_.empty() || !running_; });
+    text.swap(pending_);
+    bool stopping = !running_;
+    lock.unlock();
+
+    out_ << text;
+    out_.flush();
+    text.clear();
+
+    lock.lock();
+    if (stopping && pending_.empty())
+    {
+      break;
+    }
+  }
+}
+
+}  // namespace rhoban_ssl
@@ -0,0 +1,75 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace rhoban_ssl
+{
+/**
+ * @brief Writes text in a file from its own thread.
+ *
+ * write() only appends the text to a buffer, the thread writes and flushes it,
+ * so the file I/O never blocks the caller (e.g. the control loop). The pending
+ * text is written when the writer is destroyed.
+ */
+class AsyncWriter
+{
+private:
+  std::ofstream out_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::string pending_;
+  bool running_;
+  std::thread thread_;
+
+  void run();
+
+public:
+  /**
+   * @brief Opens the file (truncated) and launches the thread if it is opened.
+   */
+  explicit AsyncWriter(const std::string& path);
+
+  /**
+   * @brief Writes the pending text, closes the file and joins the thread.
+   */
+  ~AsyncWriter();
+
+  AsyncWriter(const AsyncWriter&) = delete;
+  AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+  /**
+   * @brief Returns false if the file can't be opened.
+   */
+  bool good() const;
+
+  /**
+   * @brief Appends the text to the file later, never waits for the disk.
+   */
+  void write(const std::string& text);
+};
+
+}  // namespace rhoban_ssl
@@ -30,6 +30,8 @@
 #include <sstream>
 #include <functional>
 #include <fstream>
+#include <algorithm>
+#include <vector>
 
 namespace machine_state
 {
@@ -261,7 +263,45 @@ private:
   std::set<ID> init_states_set_;
   std::set<ID> current_states_set_;
 
-  std::list<MachineStateFollower<ID, STATE_DATA, EDGE_DATA>*> followers_;
+  std::vector<MachineStateFollower<ID, STATE_DATA, EDGE_DATA>*> followers_;
+
+  /*
+   * Tables used by run(), built by compile() from the maps above.
+   *
+   * The states are numbered in the order of their ids (the order of the sets of
+   * states), the edges out of the state s are edge_table_[first_edge_[s]] to
+   * edge_table_[first_edge_[s + 1] - 1], in the order they were added.
+   */
+  bool compiled_;
+  std::vector<ID> state_ids_;
+  std::vector<State_t*> state_table_;
+  std::vector<unsigned int> first_edge_;
+  std::vector<Edge_t*> edge_table_;
+  std::vector<unsigned int> edge_ends_;
+
+  // sorted numbers of the current states, the next states and the edges to run
+  std::vector<unsigned int> current_states_;
+  std::vector<unsigned int> next_states_;
+  std::vector<unsigned int> edges_to_run_;
+  std::vector<bool> is_next_state_;
+
+  void updateCurrentStates()
+  {
+    current_states_.clear();
+    for (const ID& id : current_states_set_)
+    {
+      current_states_.push_back(std::lower_bound(state_ids_.begin(), state_ids_.end(), id) - state_ids_.begin());
+    }
+  }
+
+  void updateCurrentStatesSet()
+  {
+    current_states_set_.clear();
+    for (unsigned int state : current_states_)
+    {
+      current_states_set_.insert(current_states_set_.end(), state_ids_[state]);
+    }
+  }
 
   bool debug_;
 
@@ -278,51 +318,67 @@ private:
     run_number_ += 1;
   }
 
-  std::set<ID> atomicRun()
+  /*
+   * Runs the current states and the edges whose condition is true,
+   * returns true if the current states changed.
+   */
+  bool atomicRun()
   {
     for (MachineStateFollower<ID, STATE_DATA, EDGE_DATA>* follower : followers_)
     {
       follower->atomicUpdate(state_data_, edge_data_, run_number_, atomic_run_number_);
     }
-    std::set<ID> new_states;
-    for (const ID& state_name : current_states_set_)
+    for (unsigned int state : current_states_)
     {
-      states_.at(state_name)->run(state_data_, run_number_, atomic_run_number_);
+      state_table_[state]->run(state_data_, run_number_, atomic_run_number_);
       for (MachineStateFollower<ID, STATE_DATA, EDGE_DATA>* follower : followers_)
       {
-        follower->stateRun(state_name, state_data_, edge_data_, run_number_, atomic_run_number_);
+        follower->stateRun(state_ids_[state], state_data_, edge_data_, run_number_, atomic_run_number_);
       }
     }
-    std::list<ID> edges_to_run;
-    for (const ID& state_name : current_states_set_)
+    edges_to_run_.clear();
+    next_states_.clear();
+    for (unsigned int state : current_states_)
     {
       bool move = false;
-      for (const ID& edge_name : adjacence_.at(state_name))
+      for (unsigned int e = first_edge_[state]; e < first_edge_[state + 1]; e++)
       {
-        std::shared_ptr<Edge_t>& edge = edges_.at(edge_name);
-        const std::shared_ptr<Edge_t>& const_edge = edges_.at(edge_name);
+        const Edge_t* const_edge = edge_table_[e];
         if (const_edge->condition(edge_data_, run_number_, atomic_run_number_))
         {
-          edges_to_run.push_back(edge_name);
-          new_states.insert(edge->end());
+          edges_to_run_.push_back(e);
+          if (!is_next_state_[edge_ends_[e]])
+          {
+            is_next_state_[edge_ends_[e]] = true;
+            next_states_.push_back(edge_ends_[e]);
+          }
           move = true;
         }
       }
-      if (not(move))
+      if (not(move) && !is_next_state_[state])
       {
-        new_states.insert(state_name);
+        is_next_state_[state] = true;
+        next_states_.push_back(state);
       }
     }
-    for (const ID& id : edges_to_run)
+    for (unsigned int e : edges_to_run_)
     {
-      edges_.at(id)->run(edge_data_, run_number_, atomic_run_number_);
+      edge_table_[e]->run(edge_data_, run_number_, atomic_run_number_);
       for (MachineStateFollower<ID, STATE_DATA, EDGE_DATA>* follower : followers_)
       {
-        follower->edgeRun(id, state_data_, edge_data_, run_number_, atomic_run_number_);
+        follower->edgeRun(edge_table_[e]->name(), state_data_, edge_data_, run_number_, atomic_run_number_);
       }
     }
+    for (unsigned int state : next_states_)
+    {
+      is_next_state_[state] = false;
+    }
+    std::sort(next_states_.begin(), next_states_.end());
     increaseAtomicRunNumber();
-    return new_states;
+
+    bool changed = (next_states_ != current_states_);
+    current_states_.swap(next_states_);
+    return changed;
   }
 
 public:
@@ -334,6 +390,7 @@ public:
 
     adjacence_[edge->origin()].push_back(edge->name());
     edges_[edge->name()] = edge;
+    compiled_ = false;
     return *this;
   }
 
@@ -356,6 +413,7 @@ public:
 
     adjacence_[state->name()] = std::list<ID>();
     states_[state->name()] = state;
+    compiled_ = false;
     return *this;
   }
 
@@ -388,6 +446,7 @@ public:
   MachineState(STATE_DATA& state_data, EDGE_DATA& edge_data)
     : state_data_(state_data)
     , edge_data_(edge_data)
+    , compiled_(false)
     , debug_(false)
     , run_number_(CLEAR_RUN_NUMBER)
     , atomic_run_number_(CLEAR_ATOMIC_RUN_NUMBER)
@@ -431,9 +490,53 @@ public:
     return stateNumber();
   }
 
+  /**
+   * @brief Freezes the states and the edges in the tables used by run().
+   *
+   * It is done by start() or run() when a state or an edge has been added since
+   * the last compilation, so calling it is only needed to do it in advance.
+   */
+  void compile()
+  {
+    state_ids_.clear();
+    state_table_.clear();
+    for (const std::pair<const ID, std::shared_ptr<State_t> >& state_asso : states_)
+    {
+      state_ids_.push_back(state_asso.first);
+      state_table_.push_back(state_asso.second.get());
+    }
+
+    first_edge_.clear();
+    edge_table_.clear();
+    edge_ends_.clear();
+    for (const ID& id : state_ids_)
+    {
+      first_edge_.push_back(edge_table_.size());
+      for (const ID& edge_name : adjacence_.at(id))
+      {
+        Edge_t* edge = edges_.at(edge_name).get();
+        edge_table_.push_back(edge);
+        edge_ends_.push_back(std::lower_bound(state_ids_.begin(), state_ids_.end(), edge->end()) - state_ids_.begin());
+      }
+    }
+    first_edge_.push_back(edge_table_.size());
+
+    is_next_state_.assign(state_ids_.size(), false);
+    current_states_.reserve(state_ids_.size());
+    next_states_.reserve(state_ids_.size());
+    edges_to_run_.reserve(edge_table_.size());
+    updateCurrentStates();
+    compiled_ = true;
+  }
+
   void start()
   {
+    if (!compiled_)
+    {
+      compile();
+    }
     current_states_set_ = init_states_set_;
+    updateCurrentStates();
     run_number_ = INIT_RUN_NUMBER;
     atomic_run_number_ = INIT_ATOMIC_RUN_NUMBER;
   }
@@ -449,12 +552,15 @@ public:
     {
       follower->update(state_data_, edge_data_, run_number_, atomic_run_number_);
     }
-    std::set<ID> old_states;
-    do
+    if (!compiled_)
+    {
+      compile();
+    }
+    // the set is only rebuilt when the states change, currentStates() stays valid in the callbacks
+    while (atomicRun())
     {
-      old_states = current_states_set_;
-      current_states_set_ = atomicRun();
-    } while (old_states != current_states_set_);
+      updateCurrentStatesSet();
+    }
 
     increaseRunNumber();
     return current_states_set_;
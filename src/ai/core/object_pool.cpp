@@ -0,0 +1,77 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "object_pool.h"
+#include <cassert>
+#include <new>
+
+namespace rhoban_ssl
+{
+namespace detail
+{
+BlockStorage::BlockStorage() : block_size_(0)
+{
+}
+
+BlockStorage::~BlockStorage()
+{
+  assert(free_blocks_.size() == blocks_.size());
+  for (void* block : blocks_)
+  {
+    ::operator delete(block);
+  }
+}
+
+void* BlockStorage::take(std::size_t size)
+{
+  if (block_size_ == 0)
+  {
+    block_size_ = size;
+  }
+  assert(size == block_size_);
+
+  if (free_blocks_.empty())
+  {
+    blocks_.push_back(::operator new(block_size_));
+    // reserving here keeps give() from allocating
+    free_blocks_.reserve(blocks_.size());
+    return blocks_.back();
+  }
+  void* block = free_blocks_.back();
+  free_blocks_.pop_back();
+  return block;
+}
+
+void BlockStorage::give(void* block)
+{
+  free_blocks_.push_back(block);
+}
+
+std::size_t BlockStorage::nbBlocks() const
+{
+  return blocks_.size();
+}
+
+std::size_t BlockStorage::nbFreeBlocks() const
+{
+  return free_blocks_.size();
+}
+
+}  // namespace detail
+}  // namespace rhoban_ssl
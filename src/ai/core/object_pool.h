@@ -0,0 +1,157 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace rhoban_ssl
+{
+namespace detail
+{
+/**
+ * @brief Blocks of memory of one size recycled through a free list.
+ *
+ * The size of the blocks is set by the first allocation. The blocks go back
+ * to the heap when the storage is destroyed.
+ */
+class BlockStorage
+{
+private:
+  std::size_t block_size_;
+  std::vector<void*> blocks_;
+  std::vector<void*> free_blocks_;
+
+public:
+  BlockStorage();
+  ~BlockStorage();
+
+  BlockStorage(const BlockStorage&) = delete;
+  BlockStorage& operator=(const BlockStorage&) = delete;
+
+  void* take(std::size_t size);
+  void give(void* block);
+
+  std::size_t nbBlocks() const;
+  std::size_t nbFreeBlocks() const;
+};
+
+/**
+ * @brief Allocator taking its memory from a BlockStorage.
+ *
+ * Each copy shares the storage, so the storage lives as long as an object
+ * allocated in it.
+ */
+template <typename T>
+class PoolAllocator
+{
+public:
+  typedef T value_type;
+
+  std::shared_ptr<BlockStorage> storage;
+
+  explicit PoolAllocator(const std::shared_ptr<BlockStorage>& storage) : storage(storage)
+  {
+  }
+
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& other) : storage(other.storage)
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(storage->take(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, std::size_t)
+  {
+    storage->give(p);
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>& a, const PoolAllocator<U>& b)
+{
+  return a.storage == b.storage;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>& a, const PoolAllocator<U>& b)
+{
+  return a.storage != b.storage;
+}
+}  // namespace detail
+
+/**
+ * @brief A pool of objects of one type handed out as shared pointers.
+ *
+ * make() constructs the object and its reference counter in one block. When the
+ * last shared pointer is destroyed, the object is destroyed and its block goes
+ * back to the pool: the next make() constructs a fresh object in it instead of
+ * allocating. In steady state, creating and dropping objects does not touch the heap
+ * (except for the allocations done by the objects themselves).
+ *
+ * The pool can be destroyed before the objects it made. It is not thread safe:
+ * the objects must be made and released by one thread.
+ */
+template <typename T>
+class ObjectPool
+{
+private:
+  std::shared_ptr<detail::BlockStorage> storage_;
+
+public:
+  ObjectPool() : storage_(std::make_shared<detail::BlockStorage>())
+  {
+  }
+
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  /**
+   * @brief Constructs a T with the arguments in a free block of the pool.
+   */
+  template <typename... Args>
+  std::shared_ptr<T> make(Args&&... args)
+  {
+    return std::allocate_shared<T>(detail::PoolAllocator<T>(storage_), std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Number of blocks allocated on the heap since the construction of the pool.
+   */
+  std::size_t nbBlocks() const
+  {
+    return storage_->nbBlocks();
+  }
+
+  /**
+   * @brief Number of blocks that are not used by an object.
+   */
+  std::size_t nbFreeBlocks() const
+  {
+    return storage_->nbFreeBlocks();
+  }
+};
+
+}  // namespace rhoban_ssl
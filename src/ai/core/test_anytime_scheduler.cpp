@@ -0,0 +1,90 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include "anytime_scheduler.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace rhoban_ssl;
+
+TEST(test_anytime_scheduler, finishes_in_budget)
+{
+  AnytimeScheduler scheduler;
+  // each computation needs 3 steps
+  std::vector<int> steps_left = { 3, 3, 3 };
+  bool pending = scheduler.run(3,
+                               [&](unsigned int i) {
+                                 if (steps_left[i] == 0)
+                                 {
+                                   return false;
+                                 }
+                                 steps_left[i]--;
+                                 return true;
+                               },
+                               1.0);
+  EXPECT_FALSE(pending);
+  EXPECT_EQ(steps_left, std::vector<int>({ 0, 0, 0 }));
+  EXPECT_EQ(scheduler.stats().nb_ticks, 1);
+  EXPECT_EQ(scheduler.stats().nb_exhausted_ticks, 0);
+  // 3 steps of refinement and 1 to say that it is finished
+  EXPECT_EQ(scheduler.stats().nb_steps, 12);
+}
+
+TEST(test_anytime_scheduler, continues_at_the_next_tick)
+{
+  AnytimeScheduler scheduler;
+  std::vector<int> nb_steps = { 0, 0 };
+  auto step = [&](unsigned int i) {
+    nb_steps[i]++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    return true;
+  };
+
+  // the budget is spent after one step, the computations take turns
+  for (int tick = 0; tick < 4; tick++)
+  {
+    EXPECT_TRUE(scheduler.run(2, step, 0.001));
+  }
+  EXPECT_EQ(nb_steps, std::vector<int>({ 2, 2 }));
+  EXPECT_EQ(scheduler.stats().nb_exhausted_ticks, 4);
+  EXPECT_TRUE(scheduler.stats().pending);
+  EXPECT_GE(scheduler.stats().max_duration, 0.002);
+
+  // with a larger budget, more steps by tick
+  scheduler.run(2, step, 0.015);
+  EXPECT_GE(nb_steps[0] + nb_steps[1], 4 + 6);
+}
+
+TEST(test_anytime_scheduler, nothing_to_do)
+{
+  AnytimeScheduler scheduler;
+  EXPECT_FALSE(scheduler.run(0, [](unsigned int) { return true; }, 0.001));
+  EXPECT_FALSE(scheduler.run(2, [](unsigned int) { return false; }, 0.001));
+  EXPECT_EQ(scheduler.stats().nb_steps, 2);
+  EXPECT_FALSE(scheduler.stats().pending);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
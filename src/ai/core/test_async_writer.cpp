@@ -0,0 +1,68 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include "async_writer.h"
+#include <cstdio>
+#include <sstream>
+
+using namespace rhoban_ssl;
+
+namespace
+{
+std::string readFile(const std::string& path)
+{
+  std::ifstream in(path);
+  std::ostringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+}  // namespace
+
+TEST(test_async_writer, writes_everything_in_order)
+{
+  std::string path = "/tmp/test_async_writer.txt";
+  std::string expected;
+  {
+    AsyncWriter writer(path);
+    EXPECT_TRUE(writer.good());
+    for (int i = 0; i < 1000; i++)
+    {
+      std::string line = std::to_string(i) + "\n";
+      writer.write(line);
+      expected += line;
+    }
+  }
+  EXPECT_EQ(readFile(path), expected);
+  std::remove(path.c_str());
+}
+
+TEST(test_async_writer, file_that_cant_be_opened)
+{
+  AsyncWriter writer("/nonexistent_directory/file.txt");
+  EXPECT_FALSE(writer.good());
+  writer.write("ignored");
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
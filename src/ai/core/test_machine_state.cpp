@@ -909,6 +909,63 @@ TEST(test_machine_state, rising_edge)
   }
 }
 
+TEST(test_machine_state, edges_to_the_same_state)
+{
+  {
+    std::ostringstream data;
+
+    msi_int::MachineState machine(data, data);
+
+    machine.addState(1);
+    machine.addState(2);
+    machine.addState(3);
+
+    machine.addEdge(1, 1, 3);
+    machine.addEdge(2, 2, 3);
+    machine.addEdge(3, 1, 3);
+
+    machine.addInitState({ 1, 2 });
+
+    machine.start();
+
+    machine.run();
+
+    EXPECT_TRUE(machine.currentStates() == std::set<int>({ 3 }));
+  }
+}
+
+TEST(test_machine_state, states_added_after_the_start)
+{
+  {
+    std::ostringstream data;
+
+    msi_int::MachineState machine(data, data);
+
+    machine.addState(1);
+    machine.addState(3);
+    machine.addEdge(1, 1, 3, [](const std::ostream& data, unsigned int run_number,
+                                unsigned int atomic_run_number) { return false; });
+    machine.addInitState(1);
+
+    machine.compile();
+    machine.start();
+    machine.run();
+
+    EXPECT_TRUE(machine.currentStates() == std::set<int>({ 1 }));
+
+    // the machine is compiled again, and the state 2 is numbered between 1 and 3
+    machine.addState(2);
+    machine.addEdge(2, 1, 2);
+    machine.addEdge(3, 2, 3);
+
+    machine.run();
+
+    EXPECT_TRUE(machine.currentStates() == std::set<int>({ 3 }));
+    EXPECT_TRUE(machine.isActive(3));
+    EXPECT_FALSE(machine.isActive(1));
+  }
+}
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,112 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include "object_pool.h"
+#include <string>
+
+using namespace rhoban_ssl;
+
+namespace
+{
+struct Counted
+{
+  static int nb_alive;
+  std::string label;
+  int value;
+
+  Counted(const std::string& label, int value) : label(label), value(value)
+  {
+    nb_alive++;
+  }
+  ~Counted()
+  {
+    nb_alive--;
+  }
+};
+int Counted::nb_alive = 0;
+}  // namespace
+
+TEST(test_object_pool, constructs_the_objects)
+{
+  ObjectPool<Counted> pool;
+  std::shared_ptr<Counted> a = pool.make("a", 1);
+  std::shared_ptr<Counted> b = pool.make("b", 2);
+  EXPECT_EQ(a->label, "a");
+  EXPECT_EQ(a->value, 1);
+  EXPECT_EQ(b->label, "b");
+  EXPECT_EQ(b->value, 2);
+  EXPECT_EQ(Counted::nb_alive, 2);
+  EXPECT_EQ(pool.nbBlocks(), 2u);
+  EXPECT_EQ(pool.nbFreeBlocks(), 0u);
+}
+
+TEST(test_object_pool, reuses_the_released_blocks)
+{
+  ObjectPool<Counted> pool;
+  std::shared_ptr<Counted> a = pool.make("a", 1);
+  Counted* address = a.get();
+  a.reset();
+  EXPECT_EQ(Counted::nb_alive, 0);
+  EXPECT_EQ(pool.nbFreeBlocks(), 1u);
+
+  // a fresh object in the same block
+  std::shared_ptr<Counted> b = pool.make("b", 2);
+  EXPECT_EQ(b.get(), address);
+  EXPECT_EQ(b->label, "b");
+  EXPECT_EQ(b->value, 2);
+  EXPECT_EQ(pool.nbBlocks(), 1u);
+
+  for (int i = 0; i < 100; i++)
+  {
+    b = pool.make("c", i);
+  }
+  EXPECT_EQ(b->value, 99);
+  EXPECT_EQ(pool.nbBlocks(), 2u);
+  EXPECT_EQ(Counted::nb_alive, 1);
+}
+
+TEST(test_object_pool, objects_outlive_the_pool)
+{
+  std::shared_ptr<Counted> a;
+  {
+    ObjectPool<Counted> pool;
+    a = pool.make("a", 1);
+  }
+  EXPECT_EQ(a->label, "a");
+  a.reset();
+  EXPECT_EQ(Counted::nb_alive, 0);
+}
+
+TEST(test_object_pool, shared_as_a_base_class)
+{
+  ObjectPool<Counted> pool;
+  std::shared_ptr<void> base = pool.make("a", 1);
+  EXPECT_EQ(Counted::nb_alive, 1);
+  base.reset();
+  EXPECT_EQ(Counted::nb_alive, 0);
+  EXPECT_EQ(pool.nbFreeBlocks(), 1u);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,90 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include "worker_pool.h"
+#include <stdexcept>
+
+using namespace rhoban_ssl;
+
+TEST(test_worker_pool, runs_each_job_once)
+{
+  for (unsigned int nb_threads = 0; nb_threads <= 3; nb_threads++)
+  {
+    WorkerPool pool(nb_threads);
+    EXPECT_EQ(pool.nbThreads(), nb_threads);
+    for (unsigned int nb_jobs = 0; nb_jobs <= 16; nb_jobs++)
+    {
+      std::vector<int> counts(nb_jobs, 0);
+      pool.run(nb_jobs, [&](unsigned int i) { counts[i]++; });
+      EXPECT_EQ(counts, std::vector<int>(nb_jobs, 1));
+    }
+  }
+}
+
+TEST(test_worker_pool, same_results_as_a_loop)
+{
+  WorkerPool pool(3);
+  std::vector<double> sequential(8);
+  std::vector<double> parallel(8);
+  std::function<double(unsigned int)> f = [](unsigned int i) {
+    double x = 0.0;
+    for (unsigned int k = 0; k < 10000 * (i + 1); k++)
+    {
+      x += 1.0 / (k + 1);
+    }
+    return x;
+  };
+  for (unsigned int i = 0; i < 8; i++)
+  {
+    sequential[i] = f(i);
+  }
+  for (int repetition = 0; repetition < 100; repetition++)
+  {
+    pool.run(8, [&](unsigned int i) { parallel[i] = f(i); });
+    EXPECT_EQ(parallel, sequential);
+  }
+}
+
+TEST(test_worker_pool, exception)
+{
+  WorkerPool pool(2);
+  std::vector<int> counts(8, 0);
+  EXPECT_THROW(pool.run(8,
+                        [&](unsigned int i) {
+                          counts[i]++;
+                          if (i == 3)
+                          {
+                            throw std::runtime_error("job 3");
+                          }
+                        }),
+               std::runtime_error);
+  EXPECT_EQ(counts, std::vector<int>(8, 1));
+
+  // The pool can still be used
+  pool.run(8, [&](unsigned int i) { counts[i]++; });
+  EXPECT_EQ(counts, std::vector<int>(8, 2));
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "worker_pool.h"
+
+namespace rhoban_ssl
+{
+WorkerPool::WorkerPool(unsigned int nb_threads)
+  : running_(true), generation_(0), nb_busy_(0), job_(nullptr), nb_jobs_(0), next_job_(0)
+{
+  for (unsigned int i = 0; i < nb_threads; ++i)
+  {
+    threads_.push_back(std::thread([this]() { work(); }));
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+  }
+  start_.notify_all();
+  for (std::thread& thread : threads_)
+  {
+    thread.join();
+  }
+}
+
+unsigned int WorkerPool::nbThreads() const
+{
+  return threads_.size();
+}
+
+void WorkerPool::takeJobs()
+{
+  for (unsigned int i = next_job_++; i < nb_jobs_; i = next_job_++)
+  {
+    try
+    {
+      (*job_)(i);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!exception_)
+      {
+        exception_ = std::current_exception();
+      }
+    }
+  }
+}
+
+void WorkerPool::work()
+{
+  unsigned long generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [&]() { return !running_ || generation_ != generation; });
+      if (!running_)
+      {
+        return;
+      }
+      generation = generation_;
+    }
+
+    takeJobs();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--nb_busy_ == 0)
+    {
+      done_.notify_one();
+    }
+  }
+}
+
+void WorkerPool::run(unsigned int nb_jobs, const std::function<void(unsigned int)>& job)
+{
+  if (threads_.empty() || nb_jobs <= 1)
+  {
+    for (unsigned int i = 0; i < nb_jobs; ++i)
+    {
+      job(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &job;
+    nb_jobs_ = nb_jobs;
+    next_job_ = 0;
+    nb_busy_ = threads_.size();
+    generation_++;
+  }
+  start_.notify_all();
+
+  takeJobs();
+
+  std::exception_ptr exception;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return nb_busy_ == 0; });
+    job_ = nullptr;
+    std::swap(exception, exception_);
+  }
+  if (exception)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+}  // namespace rhoban_ssl
@@ -0,0 +1,84 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rhoban_ssl
+{
+/**
+ * @brief A small set of persistent threads running the jobs 0 to nb_jobs - 1 of a function.
+ *
+ * run() returns when all the jobs are done, the calling thread takes jobs too. The jobs are
+ * distributed on the fly, so a job must only write its own outputs: the results must not
+ * depend on the thread that ran it.
+ */
+class WorkerPool
+{
+private:
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable done_;
+  bool running_;
+  // incremented for each call to run(), wakes up the workers
+  unsigned long generation_;
+  // workers that have not finished the current call
+  unsigned int nb_busy_;
+
+  const std::function<void(unsigned int)>* job_;
+  unsigned int nb_jobs_;
+  std::atomic<unsigned int> next_job_;
+  std::exception_ptr exception_;
+
+  void work();
+  void takeJobs();
+
+public:
+  /**
+   * @brief Constructor, launches the threads.
+   * @param nb_threads the number of threads in addition to the one calling run()
+   */
+  explicit WorkerPool(unsigned int nb_threads);
+
+  /**
+   * @brief Stops and joins the threads.
+   */
+  ~WorkerPool();
+
+  /**
+   * @brief Runs job(0) to job(nb_jobs - 1) and waits for them.
+   *
+   * If a job throws an exception, the other jobs are still run and the first exception is
+   * thrown again by run().
+   */
+  void run(unsigned int nb_jobs, const std::function<void(unsigned int)>& job);
+
+  unsigned int nbThreads() const;
+};
+
+}  // namespace rhoban_ssl
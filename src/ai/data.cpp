@@ -24,7 +24,10 @@
 namespace rhoban_ssl
 {
 SharedData::FinalControl::FinalControl()
-  : hardware_is_responding(false), is_disabled_by_viewer(false), is_manually_controled_by_viewer(true)
+  : hardware_is_responding(false)
+  , is_disabled_by_viewer(false)
+  , is_manually_controled_by_viewer(true)
+  , collision_is_detected(false)
 {
   control.active = false;
   control.ignore = true;
@@ -35,6 +38,7 @@ SharedData::FinalControl::FinalControl(const FinalControl& control)
   , is_disabled_by_viewer(control.is_disabled_by_viewer)
   , is_manually_controled_by_viewer(control.is_manually_controled_by_viewer)
   , control(control.control)
+  , collision_is_detected(control.collision_is_detected)
 {
 }
 
@@ -22,11 +22,14 @@
 #include <vision/vision_data.h>
 #include <mutex>
 #include <control/control.h>
+#include <control/latency_model.h>
 #include "data/robot.h"
 #include "data/ball.h"
 #include "data/field.h"
 #include "data/ai_data.h"
 #include "data/referee.h"
+#include "data/tick_cache.h"
+#include "data/value_maps.h"
 
 namespace rhoban_ssl
 {
@@ -47,6 +50,7 @@ struct SharedData
     bool is_manually_controled_by_viewer;  // Write acces for viewer only
     Control control;  // Write access for viewer when is_manually_controled_by_viewer is set to true
                       // Write access for Ai
+    bool collision_is_detected;  // Write access for Ai, only used by the control loop
     FinalControl();
     FinalControl(const FinalControl& control);
   };
@@ -98,8 +102,11 @@ public:
   control::Commander* commander;
 
   Time time;
+  control::LatencyModel latency;
 
   SharedData shared_data;
+  data::TickCache tick_cache;
+  data::ValueMaps value_maps;
   // TODO refacto
   //  DataForViewer data_for_viewer_;
 
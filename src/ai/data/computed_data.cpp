@@ -19,6 +19,7 @@
 #include "computed_data.h"
 #include <config.h>
 #include "physic/collision.h"
+#include <iostream>
 
 namespace rhoban_ssl
 {
@@ -91,6 +92,42 @@ bool CollisionComputing::runTask()
   return true;
 }
 
+TickCacheComputing::TickCacheComputing(int print_every_n_loop) : print_every_n_loop_(print_every_n_loop)
+{
+}
+
+bool TickCacheComputing::runTask()
+{
+  TickCache& cache = Data::get()->tick_cache;
+  if (print_every_n_loop_ > 0 && cache.tick() > 0 && cache.tick() % print_every_n_loop_ == 0)
+  {
+    cache.printStats(std::cout);
+  }
+  cache.newTick(Data::get()->time.now());
+  return true;
+}
+
+ValueMapsComputing::ValueMapsComputing()
+{
+}
+
+bool ValueMapsComputing::runTask()
+{
+  Data* data = Data::get();
+  double time = data->time.now();
+  opponents_.clear();
+  for (const Robot& robot : data->robots[Opponent])
+  {
+    if (robot.isActive())
+    {
+      opponents_.push_back(robot.getMovement().linearPosition(time));
+    }
+  }
+  data->value_maps.setField(data->field.field_length, data->field.field_width, data->field.goal_width);
+  data->value_maps.update(data->ball.getMovement().linearPosition(time), opponents_);
+  return true;
+}
+
 }  // namespace data
 
 }  // namespace rhoban_ssl
@@ -18,6 +18,7 @@
 */
 #include <math/vector2d.h>
 #include <list>
+#include <vector>
 #include "data.h"
 
 namespace rhoban_ssl
@@ -44,6 +45,45 @@ public:
 private:
   void computeTableOfCollisionTimes();
 };
+
+/**
+ * @brief Starts a new tick of the cache of the GameInformations queries (see TickCache).
+ *
+ * It must run after the vision and before the ai.
+ */
+class TickCacheComputing : public Task
+{
+public:
+  /**
+   * @param print_every_n_loop prints the hit rates of the queries every n loops, never if 0
+   */
+  TickCacheComputing(int print_every_n_loop = 0);
+
+  // Task interface
+public:
+  bool runTask();
+
+private:
+  int print_every_n_loop_;
+};
+
+/**
+ * @brief Computes the subscribed layers of the value maps (see ValueMaps) with the positions of the tick.
+ *
+ * It must run after the vision and before the ai.
+ */
+class ValueMapsComputing : public Task
+{
+public:
+  ValueMapsComputing();
+
+  // Task interface
+public:
+  bool runTask();
+
+private:
+  std::vector<Vector2d> opponents_;
+};
 }  // namespace data
 
 }  // namespace rhoban_ssl
@@ -0,0 +1,85 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include "tick_cache.h"
+
+using namespace rhoban_ssl;
+
+TEST(test_tick_cache, memo)
+{
+  data::TickCache cache;
+  EXPECT_FALSE(cache.enabled());
+  cache.newTick(1.0);
+  EXPECT_TRUE(cache.enabled());
+  EXPECT_EQ(cache.time(), 1.0);
+
+  int nb_computations = 0;
+  auto compute = [&]() {
+    nb_computations++;
+    return 42;
+  };
+  EXPECT_EQ(cache.get(cache.closest_robot, { { 0.0, 1.0, 2.0 } }, compute), 42);
+  EXPECT_EQ(cache.get(cache.closest_robot, { { 0.0, 1.0, 2.0 } }, compute), 42);
+  EXPECT_EQ(nb_computations, 1);
+  // other parameters
+  EXPECT_EQ(cache.get(cache.closest_robot, { { 1.0, 1.0, 2.0 } }, compute), 42);
+  EXPECT_EQ(nb_computations, 2);
+  EXPECT_EQ(cache.closest_robot.hits(), 1);
+  EXPECT_EQ(cache.closest_robot.misses(), 2);
+
+  // The results are cleared at each tick
+  cache.newTick(2.0);
+  EXPECT_EQ(cache.get(cache.closest_robot, { { 0.0, 1.0, 2.0 } }, compute), 42);
+  EXPECT_EQ(nb_computations, 3);
+  EXPECT_EQ(cache.tick(), 2);
+}
+
+TEST(test_tick_cache, capacity)
+{
+  data::Memo<int, 1> memo;
+  int value;
+  for (unsigned int i = 0; i < 2 * data::Memo<int, 1>::CAPACITY; i++)
+  {
+    EXPECT_FALSE(memo.find({ { (double)i } }, value));
+    memo.insert({ { (double)i } }, i);
+  }
+  EXPECT_TRUE(memo.find({ { 0.0 } }, value));
+  EXPECT_EQ(value, 0);
+  // The entries after the capacity are not stored
+  EXPECT_FALSE(memo.find({ { (double)data::Memo<int, 1>::CAPACITY } }, value));
+}
+
+TEST(test_tick_cache, ranking)
+{
+  data::Ranking ranking;
+  ranking.nb_robots = 2;
+  ranking.robots[0] = 3;
+  ranking.robots[1] = 1;
+  EXPECT_EQ(ranking.robot(0), 3);
+  EXPECT_EQ(ranking.robot(1), 1);
+  EXPECT_EQ(ranking.robot(2), -1);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
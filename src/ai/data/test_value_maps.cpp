@@ -0,0 +1,176 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include "value_maps.h"
+#include <cmath>
+#include <random>
+
+using namespace rhoban_ssl;
+
+namespace
+{
+data::ValueMaps::Weights only(data::ValueMaps::Layer layer)
+{
+  data::ValueMaps::Weights weights;
+  weights.fill(0.0f);
+  weights[layer] = 1.0f;
+  return weights;
+}
+
+double segmentDistance(const Vector2d& a, const Vector2d& b, const Vector2d& p)
+{
+  Vector2d ab = b - a;
+  double t = ab.norm() > 0.0 ? scalarProduct(p - a, ab) / (ab.norm() * ab.norm()) : 0.0;
+  t = std::min(std::max(t, 0.0), 1.0);
+  return (a + ab * t - p).norm();
+}
+}  // namespace
+
+TEST(test_value_maps, subscriptions)
+{
+  data::ValueMaps maps;
+  maps.setField(12.0, 9.0, 1.2);
+  EXPECT_EQ(maps.nbColumns(), 48);
+  EXPECT_EQ(maps.nbRows(), 36);
+
+  {
+    data::ValueMaps::Subscription subscription(maps, only(data::ValueMaps::NearestDefender));
+    maps.update(Vector2d(0.0, 0.0), {});
+    EXPECT_TRUE(maps.available(data::ValueMaps::NearestDefender));
+    EXPECT_FALSE(maps.available(data::ValueMaps::ShotQuality));
+    EXPECT_FALSE(maps.available(data::ValueMaps::PassReachability));
+    EXPECT_FALSE(maps.available(data::ValueMaps::OpponentCoverage));
+  }
+  EXPECT_FALSE(maps.subscribed(data::ValueMaps::NearestDefender));
+  maps.update(Vector2d(0.0, 0.0), {});
+  EXPECT_FALSE(maps.available(data::ValueMaps::NearestDefender));
+}
+
+TEST(test_value_maps, empty_field)
+{
+  data::ValueMaps maps;
+  data::ValueMaps::Weights all;
+  all.fill(1.0f);
+  data::ValueMaps::Subscription subscription(maps, all);
+  maps.setField(12.0, 9.0, 1.2);
+  maps.update(Vector2d(0.0, 0.0), {});
+
+  EXPECT_FLOAT_EQ(maps.value(data::ValueMaps::ShotQuality, rhoban_geometry::Point(4.0, 0.0)), 1.0f);
+  EXPECT_FLOAT_EQ(maps.mean(data::ValueMaps::PassReachability, rhoban_geometry::Point(-6.0, -4.5),
+                            rhoban_geometry::Point(6.0, 4.5)),
+                  1.0f);
+  EXPECT_FLOAT_EQ(maps.max(data::ValueMaps::OpponentCoverage, rhoban_geometry::Point(-6.0, -4.5),
+                           rhoban_geometry::Point(6.0, 4.5)),
+                  0.0f);
+  EXPECT_NEAR(maps.value(data::ValueMaps::NearestDefender, rhoban_geometry::Point(0.0, 0.0)), 15.0, 1e-3);
+}
+
+TEST(test_value_maps, against_brute_force)
+{
+  data::ValueMaps maps;
+  data::ValueMaps::Weights all;
+  all.fill(1.0f);
+  data::ValueMaps::Subscription subscription(maps, all);
+  maps.setField(12.0, 9.0, 1.2);
+
+  std::default_random_engine generator(42);
+  std::uniform_real_distribution<double> x(-6.0, 6.0);
+  std::uniform_real_distribution<double> y(-4.5, 4.5);
+  const double radius2 = data::ValueMaps::COVERAGE_RADIUS * data::ValueMaps::COVERAGE_RADIUS;
+  for (int test = 0; test < 20; ++test)
+  {
+    Vector2d ball(x(generator), y(generator));
+    std::vector<Vector2d> opponents;
+    for (int i = 0; i < 8; ++i)
+    {
+      opponents.push_back(Vector2d(x(generator), y(generator)));
+    }
+    maps.update(ball, opponents);
+
+    ShotWindows shot_windows(6.0, 1.2, data::ValueMaps::BLOCKING_RADIUS);
+    for (const Vector2d& opponent : opponents)
+    {
+      shot_windows.addObstacle(opponent);
+    }
+
+    for (int r = 0; r < maps.nbRows(); ++r)
+    {
+      for (int c = 0; c < maps.nbColumns(); ++c)
+      {
+        Vector2d cell = maps.cellCenter(c, r);
+        double nearest = 100.0;
+        double coverage = 0.0;
+        double lane = 100.0;
+        for (const Vector2d& opponent : opponents)
+        {
+          double d = (cell - opponent).norm();
+          nearest = std::min(nearest, d);
+          coverage += std::max(0.0, 1.0 - d * d / radius2);
+          lane = std::min(lane, segmentDistance(ball, cell, opponent));
+        }
+        double pass = (lane - data::ValueMaps::BLOCKING_RADIUS) / data::ValueMaps::PASS_MARGIN;
+        pass = std::min(std::max(pass, 0.0), 1.0);
+
+        int i = r * maps.nbColumns() + c;
+        ASSERT_NEAR(maps.layer(data::ValueMaps::NearestDefender)[i], nearest, 1e-4);
+        ASSERT_NEAR(maps.layer(data::ValueMaps::OpponentCoverage)[i], coverage, 1e-4);
+        ASSERT_NEAR(maps.layer(data::ValueMaps::PassReachability)[i], pass, 1e-3);
+        ASSERT_NEAR(maps.layer(data::ValueMaps::ShotQuality)[i], shot_windows.evaluate(cell).probability, 1e-5);
+      }
+    }
+  }
+}
+
+TEST(test_value_maps, argmax)
+{
+  data::ValueMaps maps;
+  data::ValueMaps::Subscription subscription(maps, only(data::ValueMaps::NearestDefender));
+  maps.setField(12.0, 9.0, 1.2);
+  maps.update(Vector2d(0.0, 0.0), { Vector2d(0.0, 0.0) });
+
+  // the farthest cell from the opponent is a corner
+  float best;
+  rhoban_geometry::Point point = maps.argmax(data::ValueMaps::NearestDefender, rhoban_geometry::Point(-6.0, -4.5),
+                                             rhoban_geometry::Point(6.0, 4.5), &best);
+  EXPECT_NEAR(std::fabs(point.getX()), 6.0 - 0.125, 1e-6);
+  EXPECT_NEAR(std::fabs(point.getY()), 4.5 - 0.125, 1e-6);
+  EXPECT_NEAR(best, std::sqrt(5.875 * 5.875 + 4.375 * 4.375), 1e-4);
+
+  // in a region, the corners can be given in any order
+  point = maps.argmax(data::ValueMaps::NearestDefender, rhoban_geometry::Point(0.9, 0.9),
+                      rhoban_geometry::Point(0.1, 0.1));
+  EXPECT_NEAR(point.getX(), 0.875, 1e-6);
+  EXPECT_NEAR(point.getY(), 0.875, 1e-6);
+
+  // the layers that are not computed count as 0
+  data::ValueMaps::Weights weights;
+  weights.fill(0.0f);
+  weights[data::ValueMaps::NearestDefender] = 1.0f;
+  weights[data::ValueMaps::ShotQuality] = 10.0f;
+  maps.argmax(weights, rhoban_geometry::Point(-6.0, -4.5), rhoban_geometry::Point(6.0, 4.5), &best);
+  EXPECT_NEAR(best, std::sqrt(5.875 * 5.875 + 4.375 * 4.375), 1e-4);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,80 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "tick_cache.h"
+
+namespace rhoban_ssl
+{
+namespace data
+{
+namespace
+{
+template <typename Value, unsigned int NB_KEYS>
+void printMemoStats(std::ostream& out, const std::string& name, const Memo<Value, NB_KEYS>& memo)
+{
+  unsigned long nb_queries = memo.hits() + memo.misses();
+  out << "  " << name << ": " << nb_queries << " queries, hit rate "
+      << (nb_queries > 0 ? 100.0 * memo.hits() / nb_queries : 0.0) << "%" << std::endl;
+}
+}  // namespace
+
+TickCache::TickCache() : tick_(0), time_(0.0)
+{
+}
+
+void TickCache::newTick(double time)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  tick_++;
+  time_ = time;
+  closest_robot.clear();
+  robots_in_line.clear();
+  goal_best_move.clear();
+  closest_robots_to_the_ball.clear();
+  threats.clear();
+}
+
+bool TickCache::enabled() const
+{
+  return tick_ > 0;
+}
+
+unsigned long TickCache::tick() const
+{
+  return tick_;
+}
+
+double TickCache::time() const
+{
+  return time_;
+}
+
+void TickCache::printStats(std::ostream& out)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  out << "GameInformations cache after " << tick_ << " ticks:" << std::endl;
+  printMemoStats(out, "closest robot", closest_robot);
+  printMemoStats(out, "robots in line", robots_in_line);
+  printMemoStats(out, "goal best move", goal_best_move);
+  printMemoStats(out, "closest robots to the ball", closest_robots_to_the_ball);
+  printMemoStats(out, "threats", threats);
+}
+
+}  // namespace data
+}  // namespace rhoban_ssl
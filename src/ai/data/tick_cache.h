@@ -0,0 +1,183 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <config.h>
+#include <math/vector2d.h>
+#include <array>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rhoban_ssl
+{
+namespace data
+{
+/**
+ * @brief Results of one query of GameInformations, stored with the parameters of the query.
+ *
+ * The entries are stored in a flat vector and searched linearly: a tick only asks a few
+ * different parameters. When it is full, the new results are not stored.
+ */
+template <typename Value, unsigned int NB_KEYS>
+class Memo
+{
+public:
+  typedef std::array<double, NB_KEYS> Key;
+  static constexpr unsigned int CAPACITY = 64;
+
+private:
+  std::vector<std::pair<Key, Value>> entries_;
+  unsigned long hits_;
+  unsigned long misses_;
+
+public:
+  Memo() : hits_(0), misses_(0)
+  {
+    entries_.reserve(CAPACITY);
+  }
+
+  bool find(const Key& key, Value& value)
+  {
+    for (const std::pair<Key, Value>& entry : entries_)
+    {
+      if (entry.first == key)
+      {
+        value = entry.second;
+        hits_++;
+        return true;
+      }
+    }
+    misses_++;
+    return false;
+  }
+
+  void insert(const Key& key, const Value& value)
+  {
+    if (entries_.size() < CAPACITY)
+    {
+      entries_.push_back(std::pair<Key, Value>(key, value));
+    }
+  }
+
+  void clear()
+  {
+    entries_.clear();
+  }
+
+  unsigned long hits() const
+  {
+    return hits_;
+  }
+
+  unsigned long misses() const
+  {
+    return misses_;
+  }
+};
+
+/**
+ * @brief The robots of a team sorted by a value (distance to the ball, threat...).
+ *
+ * Only the active robots are ranked, value_of_robot gives the value of each robot (-1 if it is not active).
+ */
+struct Ranking
+{
+  int nb_robots;
+  int robots[ai::Config::NB_OF_ROBOTS_BY_TEAM];
+  double value_of_robot[ai::Config::NB_OF_ROBOTS_BY_TEAM];
+
+  /**
+   * @brief The robot at the given rank, -1 if there are not enough active robots.
+   */
+  int robot(int rank) const
+  {
+    return rank < nb_robots ? robots[rank] : -1;
+  }
+};
+
+/**
+ * @brief The TickCache class stores the results of the GameInformations queries during one tick.
+ *
+ * The behaviors and the strategies often ask the same queries with the same parameters during
+ * a tick. The TickCacheComputing task starts a new tick before the ai: the results are cleared and
+ * the queries are computed at the time of the tick. Until the first tick, the cache is disabled
+ * and the queries are computed at each call.
+ *
+ * The cache can be used by the behaviors updated concurrently (see ai::Config::behavior_threads).
+ */
+class TickCache
+{
+private:
+  std::mutex mutex_;
+  unsigned long tick_;
+  double time_;
+
+public:
+  Memo<int, 3> closest_robot;                                         // team, point
+  Memo<std::vector<int>, 6> robots_in_line;                           // p1, p2, team, distance
+  Memo<std::pair<rhoban_geometry::Point, double>, 5> goal_best_move;  // point, goal, shooter
+  Memo<Ranking, 1> closest_robots_to_the_ball;                        // team
+  Memo<Ranking, 1> threats;                                           // team
+
+  TickCache();
+
+  /**
+   * @brief Clears the results, the next queries are computed at the given time.
+   */
+  void newTick(double time);
+
+  bool enabled() const;
+  unsigned long tick() const;
+  double time() const;
+
+  /**
+   * @brief Returns the stored result of the query, or computes and stores it.
+   * @param memo the results of the query
+   * @param key the parameters of the query
+   * @param compute computes the result (outside the lock)
+   */
+  template <typename Value, unsigned int NB_KEYS, typename Compute>
+  Value get(Memo<Value, NB_KEYS>& memo, const typename Memo<Value, NB_KEYS>::Key& key, Compute compute)
+  {
+    Value value;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (memo.find(key, value))
+      {
+        return value;
+      }
+    }
+    value = compute();
+    std::lock_guard<std::mutex> lock(mutex_);
+    memo.insert(key, value);
+    return value;
+  }
+
+  /**
+   * @brief Prints the hits and the misses of each query since the start.
+   */
+  void printStats(std::ostream& out);
+};
+
+}  // namespace data
+}  // namespace rhoban_ssl
@@ -0,0 +1,374 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "value_maps.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace rhoban_ssl
+{
+namespace data
+{
+constexpr double ValueMaps::DEFAULT_CELL_SIZE;
+constexpr double ValueMaps::BLOCKING_RADIUS;
+constexpr float ValueMaps::PASS_MARGIN;
+constexpr float ValueMaps::COVERAGE_RADIUS;
+
+ValueMaps::Subscription::Subscription(ValueMaps& maps, const Weights& weights) : maps_(maps), weights_(weights)
+{
+  for (int layer = 0; layer < NB_LAYERS; ++layer)
+  {
+    if (weights_[layer] != 0.0f)
+    {
+      maps_.subscribe(Layer(layer));
+    }
+  }
+}
+
+ValueMaps::Subscription::~Subscription()
+{
+  for (int layer = 0; layer < NB_LAYERS; ++layer)
+  {
+    if (weights_[layer] != 0.0f)
+    {
+      maps_.unsubscribe(Layer(layer));
+    }
+  }
+}
+
+ValueMaps::ValueMaps(double cell_size)
+  : cell_size_(cell_size)
+  , field_length_(0.0)
+  , field_width_(0.0)
+  , goal_width_(0.0)
+  , nb_columns_(0)
+  , nb_rows_(0)
+  , shot_windows_(0.0, 0.0, BLOCKING_RADIUS)
+{
+  for (int layer = 0; layer < NB_LAYERS; ++layer)
+  {
+    subscribers_[layer] = 0;
+    available_[layer] = false;
+  }
+}
+
+void ValueMaps::subscribe(Layer layer)
+{
+  subscribers_[layer]++;
+}
+
+void ValueMaps::unsubscribe(Layer layer)
+{
+  assert(subscribers_[layer] > 0);
+  subscribers_[layer]--;
+}
+
+bool ValueMaps::subscribed(Layer layer) const
+{
+  return subscribers_[layer] > 0;
+}
+
+void ValueMaps::setField(double field_length, double field_width, double goal_width)
+{
+  if (field_length == field_length_ && field_width == field_width_ && goal_width == goal_width_)
+  {
+    return;
+  }
+  field_length_ = field_length;
+  field_width_ = field_width;
+  goal_width_ = goal_width;
+  nb_columns_ = std::max(1, int(std::ceil(field_length / cell_size_)));
+  nb_rows_ = std::max(1, int(std::ceil(field_width / cell_size_)));
+
+  int nb_cells = nb_columns_ * nb_rows_;
+  cells_x_.resize(nb_cells);
+  cells_y_.resize(nb_cells);
+  cells_.resize(nb_cells);
+  for (int r = 0; r < nb_rows_; ++r)
+  {
+    for (int c = 0; c < nb_columns_; ++c)
+    {
+      rhoban_geometry::Point center = cellCenter(c, r);
+      cells_x_[r * nb_columns_ + c] = float(center.getX());
+      cells_y_[r * nb_columns_ + c] = float(center.getY());
+      cells_[r * nb_columns_ + c] = center;
+    }
+  }
+  for (int layer = 0; layer < NB_LAYERS; ++layer)
+  {
+    layers_[layer].assign(nb_cells, 0.0f);
+    available_[layer] = false;
+  }
+  min_distances_.resize(nb_cells);
+  shot_windows_ = ShotWindows(field_length / 2.0, goal_width, BLOCKING_RADIUS);
+}
+
+void ValueMaps::update(const Vector2d& ball, const std::vector<Vector2d>& opponents)
+{
+  for (int layer = 0; layer < NB_LAYERS; ++layer)
+  {
+    available_[layer] = nb_columns_ > 0 && subscribed(Layer(layer));
+  }
+  if (available_[ShotQuality])
+  {
+    computeShotQuality(opponents);
+  }
+  if (available_[PassReachability])
+  {
+    computePassReachability(ball, opponents);
+  }
+  if (available_[OpponentCoverage])
+  {
+    computeOpponentCoverage(opponents);
+  }
+  if (available_[NearestDefender])
+  {
+    computeNearestDefender(opponents);
+  }
+}
+
+void ValueMaps::computeShotQuality(const std::vector<Vector2d>& opponents)
+{
+  shot_windows_.clearObstacles();
+  for (const Vector2d& opponent : opponents)
+  {
+    shot_windows_.addObstacle(opponent);
+  }
+  shot_windows_.evaluate(cells_, windows_);
+  std::vector<float>& values = layers_[ShotQuality];
+  for (unsigned int i = 0; i < values.size(); ++i)
+  {
+    values[i] = float(windows_[i].probability);
+  }
+}
+
+void ValueMaps::computePassReachability(const Vector2d& ball, const std::vector<Vector2d>& opponents)
+{
+  const int nb_cells = nb_columns_ * nb_rows_;
+  const float* cells_x = cells_x_.data();
+  const float* cells_y = cells_y_.data();
+  float* min_distances = min_distances_.data();
+  const float bx = float(ball.getX());
+  const float by = float(ball.getY());
+  const float radius = float(BLOCKING_RADIUS);
+
+  // farther than radius + PASS_MARGIN, the opponents don't change the value
+  std::fill(min_distances_.begin(), min_distances_.end(), (radius + PASS_MARGIN) * (radius + PASS_MARGIN));
+  for (const Vector2d& opponent : opponents)
+  {
+    const float ox = float(opponent.getX()) - bx;
+    const float oy = float(opponent.getY()) - by;
+    // squared distance from the opponent to the segment [ball, cell]
+    for (int i = 0; i < nb_cells; ++i)
+    {
+      float dx = cells_x[i] - bx;
+      float dy = cells_y[i] - by;
+      float length2 = dx * dx + dy * dy;
+      float t = (ox * dx + oy * dy) / (length2 > 1e-6f ? length2 : 1e-6f);
+      t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+      float px = t * dx - ox;
+      float py = t * dy - oy;
+      float d2 = px * px + py * py;
+      min_distances[i] = d2 < min_distances[i] ? d2 : min_distances[i];
+    }
+  }
+
+  float* values = layers_[PassReachability].data();
+  for (int i = 0; i < nb_cells; ++i)
+  {
+    float v = (std::sqrt(min_distances[i]) - radius) / PASS_MARGIN;
+    values[i] = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+  }
+}
+
+void ValueMaps::computeOpponentCoverage(const std::vector<Vector2d>& opponents)
+{
+  const int nb_cells = nb_columns_ * nb_rows_;
+  const float* cells_x = cells_x_.data();
+  const float* cells_y = cells_y_.data();
+  float* values = layers_[OpponentCoverage].data();
+  const float inv_radius2 = 1.0f / (COVERAGE_RADIUS * COVERAGE_RADIUS);
+
+  std::fill(layers_[OpponentCoverage].begin(), layers_[OpponentCoverage].end(), 0.0f);
+  for (const Vector2d& opponent : opponents)
+  {
+    const float ox = float(opponent.getX());
+    const float oy = float(opponent.getY());
+    for (int i = 0; i < nb_cells; ++i)
+    {
+      float dx = cells_x[i] - ox;
+      float dy = cells_y[i] - oy;
+      float coverage = 1.0f - (dx * dx + dy * dy) * inv_radius2;
+      values[i] += coverage > 0.0f ? coverage : 0.0f;
+    }
+  }
+}
+
+void ValueMaps::computeNearestDefender(const std::vector<Vector2d>& opponents)
+{
+  const int nb_cells = nb_columns_ * nb_rows_;
+  const float* cells_x = cells_x_.data();
+  const float* cells_y = cells_y_.data();
+  float* min_distances = min_distances_.data();
+
+  // without opponent, the distance is the diagonal of the field
+  std::fill(min_distances_.begin(), min_distances_.end(),
+            float(field_length_ * field_length_ + field_width_ * field_width_));
+  for (const Vector2d& opponent : opponents)
+  {
+    const float ox = float(opponent.getX());
+    const float oy = float(opponent.getY());
+    for (int i = 0; i < nb_cells; ++i)
+    {
+      float dx = cells_x[i] - ox;
+      float dy = cells_y[i] - oy;
+      float d2 = dx * dx + dy * dy;
+      min_distances[i] = d2 < min_distances[i] ? d2 : min_distances[i];
+    }
+  }
+
+  float* values = layers_[NearestDefender].data();
+  for (int i = 0; i < nb_cells; ++i)
+  {
+    values[i] = std::sqrt(min_distances[i]);
+  }
+}
+
+bool ValueMaps::available(Layer layer) const
+{
+  return available_[layer];
+}
+
+int ValueMaps::nbColumns() const
+{
+  return nb_columns_;
+}
+
+int ValueMaps::nbRows() const
+{
+  return nb_rows_;
+}
+
+const std::vector<float>& ValueMaps::layer(Layer layer) const
+{
+  return layers_[layer];
+}
+
+rhoban_geometry::Point ValueMaps::cellCenter(int column, int row) const
+{
+  return rhoban_geometry::Point(-field_length_ / 2.0 + (column + 0.5) * field_length_ / nb_columns_,
+                                -field_width_ / 2.0 + (row + 0.5) * field_width_ / nb_rows_);
+}
+
+int ValueMaps::column(double x) const
+{
+  int c = int(std::floor((x + field_length_ / 2.0) * nb_columns_ / field_length_));
+  return std::min(std::max(c, 0), nb_columns_ - 1);
+}
+
+int ValueMaps::row(double y) const
+{
+  int r = int(std::floor((y + field_width_ / 2.0) * nb_rows_ / field_width_));
+  return std::min(std::max(r, 0), nb_rows_ - 1);
+}
+
+float ValueMaps::value(Layer layer, const rhoban_geometry::Point& point) const
+{
+  assert(nb_columns_ > 0);
+  return layers_[layer][row(point.getY()) * nb_columns_ + column(point.getX())];
+}
+
+rhoban_geometry::Point ValueMaps::argmax(const Weights& weights, const rhoban_geometry::Point& p1,
+                                         const rhoban_geometry::Point& p2, float* best_value) const
+{
+  assert(nb_columns_ > 0);
+  int c_min = column(std::min(p1.getX(), p2.getX()));
+  int c_max = column(std::max(p1.getX(), p2.getX()));
+  int r_min = row(std::min(p1.getY(), p2.getY()));
+  int r_max = row(std::max(p1.getY(), p2.getY()));
+
+  int best_column = c_min;
+  int best_row = r_min;
+  float best = -std::numeric_limits<float>::infinity();
+  for (int r = r_min; r <= r_max; ++r)
+  {
+    for (int c = c_min; c <= c_max; ++c)
+    {
+      float sum = 0.0f;
+      for (int layer = 0; layer < NB_LAYERS; ++layer)
+      {
+        if (weights[layer] != 0.0f && available_[layer])
+        {
+          sum += weights[layer] * layers_[layer][r * nb_columns_ + c];
+        }
+      }
+      if (sum > best)
+      {
+        best = sum;
+        best_column = c;
+        best_row = r;
+      }
+    }
+  }
+  if (best_value != nullptr)
+  {
+    *best_value = best;
+  }
+  return cellCenter(best_column, best_row);
+}
+
+rhoban_geometry::Point ValueMaps::argmax(Layer layer, const rhoban_geometry::Point& p1,
+                                         const rhoban_geometry::Point& p2, float* best_value) const
+{
+  Weights weights;
+  weights.fill(0.0f);
+  weights[layer] = 1.0f;
+  return argmax(weights, p1, p2, best_value);
+}
+
+float ValueMaps::max(Layer layer, const rhoban_geometry::Point& p1, const rhoban_geometry::Point& p2) const
+{
+  float best;
+  argmax(layer, p1, p2, &best);
+  return best;
+}
+
+float ValueMaps::mean(Layer layer, const rhoban_geometry::Point& p1, const rhoban_geometry::Point& p2) const
+{
+  assert(nb_columns_ > 0);
+  int c_min = column(std::min(p1.getX(), p2.getX()));
+  int c_max = column(std::max(p1.getX(), p2.getX()));
+  int r_min = row(std::min(p1.getY(), p2.getY()));
+  int r_max = row(std::max(p1.getY(), p2.getY()));
+
+  double sum = 0.0;
+  for (int r = r_min; r <= r_max; ++r)
+  {
+    for (int c = c_min; c <= c_max; ++c)
+    {
+      sum += layers_[layer][r * nb_columns_ + c];
+    }
+  }
+  return float(sum / ((c_max - c_min + 1) * (r_max - r_min + 1)));
+}
+
+}  // namespace data
+}  // namespace rhoban_ssl
@@ -0,0 +1,170 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <math/shot_window.h>
+#include <math/vector2d.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace rhoban_ssl
+{
+namespace data
+{
+/**
+ * @brief Grids of values over the field, used to choose the positions of the robots.
+ *
+ * Each layer is a float grid (one value by cell, stored row by row) computed once per tick
+ * by the ValueMapsComputing task:
+ *  - ShotQuality: part of the opponent goal that a shot from the cell reaches without passing near
+ *    an opponent (see ShotWindows), between 0 and 1,
+ *  - PassReachability: 1 if the pass from the ball to the cell doesn't pass near an opponent, down
+ *    to 0 when an opponent is on its line,
+ *  - OpponentCoverage: sum over the opponents of 1 - d^2 / COVERAGE_RADIUS^2 (0 farther than COVERAGE_RADIUS),
+ *  - NearestDefender: distance from the cell to the closest opponent.
+ *
+ * Only the layers with subscribers are computed. A layer subscribed during a tick is available
+ * from the next one (see available()).
+ *
+ * The values of each layer are computed for all the cells in plain loops over arrays that the
+ * compiler vectorizes. The queries only read the grids: they can be used by the behaviors
+ * updated concurrently.
+ */
+class ValueMaps
+{
+public:
+  enum Layer
+  {
+    ShotQuality = 0,
+    PassReachability,
+    OpponentCoverage,
+    NearestDefender,
+    NB_LAYERS
+  };
+  typedef std::array<float, NB_LAYERS> Weights;
+
+  static constexpr double DEFAULT_CELL_SIZE = 0.25;
+  // an opponent closer than this to the line blocks the shot or the pass
+  static constexpr double BLOCKING_RADIUS = 0.15;
+  // the pass reachability increases from 0 to 1 between BLOCKING_RADIUS and BLOCKING_RADIUS + PASS_MARGIN
+  static constexpr float PASS_MARGIN = 0.5f;
+  static constexpr float COVERAGE_RADIUS = 1.0f;
+
+  /**
+   * @brief Subscribes to the layers with a non zero weight until it is destroyed.
+   */
+  class Subscription
+  {
+  private:
+    ValueMaps& maps_;
+    Weights weights_;
+
+  public:
+    Subscription(ValueMaps& maps, const Weights& weights);
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+    ~Subscription();
+  };
+
+private:
+  double cell_size_;
+  double field_length_;
+  double field_width_;
+  double goal_width_;
+  int nb_columns_;
+  int nb_rows_;
+
+  // centers of the cells
+  std::vector<float> cells_x_;
+  std::vector<float> cells_y_;
+  std::vector<Vector2d> cells_;
+
+  std::vector<float> layers_[NB_LAYERS];
+  std::atomic<int> subscribers_[NB_LAYERS];
+  bool available_[NB_LAYERS];
+
+  ShotWindows shot_windows_;
+  std::vector<ShotWindow> windows_;
+  std::vector<float> min_distances_;
+
+  void computeShotQuality(const std::vector<Vector2d>& opponents);
+  void computePassReachability(const Vector2d& ball, const std::vector<Vector2d>& opponents);
+  void computeOpponentCoverage(const std::vector<Vector2d>& opponents);
+  void computeNearestDefender(const std::vector<Vector2d>& opponents);
+
+  int column(double x) const;
+  int row(double y) const;
+
+public:
+  ValueMaps(double cell_size = DEFAULT_CELL_SIZE);
+
+  void subscribe(Layer layer);
+  void unsubscribe(Layer layer);
+  bool subscribed(Layer layer) const;
+
+  /**
+   * @brief Sets the dimensions of the field, the grids are only resized when they change.
+   */
+  void setField(double field_length, double field_width, double goal_width);
+
+  /**
+   * @brief Computes the subscribed layers.
+   * @param ball origin of the passes
+   * @param opponents positions of the active opponents
+   */
+  void update(const Vector2d& ball, const std::vector<Vector2d>& opponents);
+
+  /**
+   * @brief Returns true if the layer has been computed by the last update.
+   */
+  bool available(Layer layer) const;
+
+  int nbColumns() const;
+  int nbRows() const;
+  const std::vector<float>& layer(Layer layer) const;
+  rhoban_geometry::Point cellCenter(int column, int row) const;
+
+  /**
+   * @brief Value of the cell containing the point (the closest cell if the point is outside the field).
+   */
+  float value(Layer layer, const rhoban_geometry::Point& point) const;
+
+  /**
+   * @brief Center of the cell of the rectangle (p1, p2) where the weighted sum of the layers is the largest.
+   *
+   * The layers that are not available count as 0. The rectangle is clipped to the field, it
+   * always contains at least one cell.
+   * @param best_value if not null, receives the weighted sum at the returned cell
+   */
+  rhoban_geometry::Point argmax(const Weights& weights, const rhoban_geometry::Point& p1,
+                                const rhoban_geometry::Point& p2, float* best_value = nullptr) const;
+  rhoban_geometry::Point argmax(Layer layer, const rhoban_geometry::Point& p1, const rhoban_geometry::Point& p2,
+                                float* best_value = nullptr) const;
+
+  /**
+   * @brief Largest and mean values of the layer in the rectangle (p1, p2).
+   */
+  float max(Layer layer, const rhoban_geometry::Point& p1, const rhoban_geometry::Point& p2) const;
+  float mean(Layer layer, const rhoban_geometry::Point& p1, const rhoban_geometry::Point& p2) const;
+};
+
+}  // namespace data
+}  // namespace rhoban_ssl
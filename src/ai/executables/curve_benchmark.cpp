@@ -0,0 +1,152 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Measures the arc length queries of Curve2d on the curves of test_curve.cpp
+ * and compares them with a walk along the curve (what was done before the tables).
+ *
+ * ./bin/curve_benchmark -n 10000 -s 0.0001
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <tclap/CmdLine.h>
+#include <math/curve.h>
+
+namespace
+{
+// The arc length computed by walking along the curve from 0 to u
+double walkArcLength(const Curve2d& curve, double u)
+{
+  double length = 0.0;
+  Vector2d old = curve(0.0);
+  double v = 0.0;
+  for (; v <= u; v += curve.step_curve_parameter)
+  {
+    Vector2d current = curve(v);
+    length += norm_2(current - old);
+    old = current;
+  }
+  return length + norm_2(curve(u) - old);
+}
+
+// The parameter where the arc length is l, computed by walking along the curve
+double walkInverseOfArcLength(const Curve2d& curve, double l)
+{
+  double length = 0.0;
+  Vector2d old = curve(0.0);
+  double u = 0.0;
+  for (; length < l; u += curve.step_curve_parameter)
+  {
+    Vector2d current = curve(u);
+    length += norm_2(current - old);
+    old = current;
+  }
+  return u;
+}
+
+template <typename F>
+double nanosecondsPerCall(const std::vector<double>& inputs, F f, double& checksum)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (double x : inputs)
+  {
+    checksum += f(x);
+  }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / inputs.size();
+}
+
+void benchmark(const std::string& name, const Curve2d& curve, int nb_queries, bool walk,
+               const std::function<double(double)>& exact_length)
+{
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> parameters(0.0, 1.0);
+  std::vector<double> us(nb_queries);
+  std::vector<double> lengths(nb_queries);
+  for (int i = 0; i < nb_queries; ++i)
+  {
+    us[i] = parameters(generator);
+    lengths[i] = us[i] * curve.size();
+  }
+
+  double checksum = 0.0;
+  double build = 0.0;
+  if (!curve.constant_speed)
+  {
+    auto start = std::chrono::steady_clock::now();
+    Curve2d copy(curve.curve, curve.step_curve_parameter);
+    build = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    checksum += copy.size();
+  }
+
+  double length_ns = nanosecondsPerCall(us, [&](double u) { return curve.arcLength(u); }, checksum);
+  double inverse_ns = nanosecondsPerCall(lengths, [&](double l) { return curve.inverseOfArcLength(l); }, checksum);
+
+  double max_error = 0.0;
+  for (double u : us)
+  {
+    max_error = std::max(max_error, std::fabs(curve.arcLength(u) - exact_length(u)));
+  }
+
+  std::cout << name << " (" << curve.length_table.size() << " entries, built in " << build << " us)" << std::endl;
+  std::cout << "  arcLength: " << length_ns << " ns, inverseOfArcLength: " << inverse_ns
+            << " ns, max error: " << max_error << " m" << std::endl;
+
+  if (walk)
+  {
+    double walk_length_ns = nanosecondsPerCall(us, [&](double u) { return walkArcLength(curve, u); }, checksum);
+    double walk_inverse_ns =
+        nanosecondsPerCall(lengths, [&](double l) { return walkInverseOfArcLength(curve, l); }, checksum);
+    std::cout << "  walk arcLength: " << walk_length_ns << " ns, walk inverseOfArcLength: " << walk_inverse_ns
+              << " ns" << std::endl;
+  }
+  // prevents the compiler from removing the queries
+  if (checksum == 42.0)
+  {
+    std::cout << checksum << std::endl;
+  }
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  TCLAP::CmdLine cmd("Curve2d arc length benchmark", ' ', "0.0", true);
+  TCLAP::ValueArg<int> nb_queries("n", "queries", "Number of queries", false, 10000, "int", cmd);
+  TCLAP::ValueArg<double> step("s", "step", "Step of the curve parameter", false, 0.0001, "double", cmd);
+  TCLAP::SwitchArg no_walk("w", "no_walk", "Don't measure the walk along the curve", cmd, false);
+  cmd.parse(argc, argv);
+
+  double length = 2.0;
+  benchmark("line", Curve2d([&](double u) { return Vector2d(length * u, 0.0); }, step.getValue()),
+            nb_queries.getValue(), !no_walk.getValue(), [&](double u) { return length * u; });
+
+  benchmark("parabola", Curve2d([](double u) { return Vector2d(u * u, 2 * u); }, step.getValue()),
+            nb_queries.getValue(), !no_walk.getValue(),
+            [](double u) { return u * std::sqrt(u * u + 1) + std::asinh(u); });
+
+  benchmark("analytic segment", Curve2d::segment(Vector2d(0.0, 0.0), Vector2d(length, 0.0)), nb_queries.getValue(),
+            false, [&](double u) { return length * u; });
+
+  benchmark("analytic arc", Curve2d::arc(Vector2d(0.0, 0.0), 1.0, 0.0, M_PI), nb_queries.getValue(), false,
+            [](double u) { return M_PI * u; });
+  return 0;
+}
@@ -0,0 +1,121 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Fits the delay between the commands of the robots and their measured velocities
+ * from a log written by the ai with --control_log, and proposes the
+ * latency:actuation_delay of config.json.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <tclap/CmdLine.h>
+#include <control/latency_model.h>
+
+using namespace rhoban_ssl;
+
+struct RobotLog
+{
+  std::vector<control::LatencyModel::Sample> command_speed;
+  std::vector<control::LatencyModel::Sample> command_angular;
+  std::vector<control::LatencyModel::Sample> measured_speed;
+  std::vector<control::LatencyModel::Sample> measured_angular;
+};
+
+int main(int argc, char** argv)
+{
+  TCLAP::CmdLine cmd("Fits the command latency from a control log", ' ', "0.0", true);
+  TCLAP::ValueArg<std::string> path("f", "file", "Csv file written with --control_log", true, "", "string", cmd);
+  TCLAP::ValueArg<double> max_delay("m", "max_delay", "Maximum delay searched (s)", false, 0.3, "double", cmd);
+  TCLAP::ValueArg<double> step("s", "step", "Resolution of the delay (s)", false, 0.001, "double", cmd);
+  cmd.parse(argc, argv);
+
+  std::ifstream in(path.getValue());
+  if (!in.good())
+  {
+    std::cerr << "Can't open " << path.getValue() << std::endl;
+    return 1;
+  }
+
+  std::map<int, RobotLog> logs;
+  double vision_delay_sum = 0.0;
+  double radio_rtt_sum = 0.0;
+  unsigned long nb_lines = 0;
+
+  std::string line;
+  std::getline(in, line);  // header
+  while (std::getline(in, line))
+  {
+    std::istringstream fields(line);
+    double values[8];
+    char separator;
+    fields >> values[0];
+    for (int i = 1; i < 8; ++i)
+    {
+      fields >> separator >> values[i];
+    }
+    if (fields.fail())
+      continue;
+
+    RobotLog& log = logs[static_cast<int>(values[1])];
+    log.command_speed.push_back({ values[0], values[2] });
+    log.command_angular.push_back({ values[0], values[3] });
+    log.measured_speed.push_back({ values[0], values[4] });
+    log.measured_angular.push_back({ values[0], values[5] });
+    vision_delay_sum += values[6];
+    radio_rtt_sum += values[7];
+    nb_lines++;
+  }
+  if (nb_lines == 0)
+  {
+    std::cerr << "No sample in " << path.getValue() << std::endl;
+    return 1;
+  }
+
+  double delay_sum = 0.0;
+  int nb_fits = 0;
+  for (const auto& robot : logs)
+  {
+    double speed_error, angular_error;
+    double speed_delay = control::LatencyModel::fitDelay(robot.second.command_speed, robot.second.measured_speed,
+                                                         max_delay.getValue(), step.getValue(), &speed_error);
+    double angular_delay = control::LatencyModel::fitDelay(
+        robot.second.command_angular, robot.second.measured_angular, max_delay.getValue(), step.getValue(),
+        &angular_error);
+    std::cout << "robot " << robot.first << " (" << robot.second.command_speed.size() << " samples): speed delay "
+              << speed_delay * 1000 << " ms (rms " << speed_error << " m/s), angular delay " << angular_delay * 1000
+              << " ms (rms " << angular_error << " rad/s)" << std::endl;
+    delay_sum += speed_delay + angular_delay;
+    nb_fits += 2;
+  }
+
+  // the measured velocities are extrapolated from the capture, so the fitted delay
+  // is the vision delay plus the actuation delay.
+  double delay = delay_sum / nb_fits;
+  double vision_delay = vision_delay_sum / nb_lines;
+  double radio_rtt = radio_rtt_sum / nb_lines;
+  double actuation_delay = std::max(0.0, delay - vision_delay - radio_rtt / 2);
+  std::cout << "total delay " << delay * 1000 << " ms, vision " << vision_delay * 1000 << " ms, radio rtt "
+            << radio_rtt * 1000 << " ms" << std::endl;
+  std::cout << "suggested latency:actuation_delay " << actuation_delay << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,220 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Compares the point-to-point times of the PID position follower and of the
+ * time-optimal trajectory follower.
+ *
+ * The robot goes through the corners of a rectangle. A leg ends when the robot is
+ * near the corner and almost stopped. The times of the legs are printed, then their mean.
+ *
+ * ./bin/follower_comparison -s -r 2 -f bang_bang
+ */
+
+#include <iostream>
+#include <chrono>
+#include <signal.h>
+#include <fenv.h>
+#include <tclap/CmdLine.h>
+#include <vision/ai_vision_client.h>
+#include <data.h>
+#include <math/bang_bang.h>
+#include <robot_behavior/position_follower.h>
+#include <robot_behavior/trajectory_follower.h>
+#include <executables/tools.h>
+
+#define CONFIG_PATH "./src/ai/config.json"
+
+using namespace rhoban_ssl;
+
+namespace
+{
+constexpr double REACH_RADIUS = 0.05;
+constexpr double REACH_VELOCITY = 0.1;
+
+/**
+ * @brief Moves the robot from corner to corner and measures the duration of each leg.
+ */
+class PointToPoint : public robot_behavior::RobotBehavior
+{
+private:
+  robot_behavior::ConsignFollower* follower_;
+  std::vector<rhoban_geometry::Point> targets_;
+  unsigned int nb_legs_;
+  unsigned int leg_;
+  double leg_start_;
+  double total_time_;
+
+public:
+  PointToPoint(robot_behavior::ConsignFollower* follower, const std::vector<rhoban_geometry::Point>& targets,
+               unsigned int nb_legs)
+    : follower_(follower), targets_(targets), nb_legs_(nb_legs), leg_(0), leg_start_(-1.0), total_time_(0.0)
+  {
+  }
+
+  ~PointToPoint()
+  {
+    delete follower_;
+  }
+
+  void update(double time, const data::Robot& robot, const data::Ball& ball)
+  {
+    RobotBehavior::updateTimeAndPosition(time, robot, ball);
+    if (leg_start_ < 0.0)
+    {
+      leg_start_ = time;
+    }
+
+    const rhoban_geometry::Point& target = targets_[leg_ % targets_.size()];
+    if (linearPosition().getDist(target) < REACH_RADIUS && robot_linear_velocity_.norm() < REACH_VELOCITY)
+    {
+      double duration = time - leg_start_;
+      total_time_ += duration;
+      leg_++;
+      leg_start_ = time;
+      std::cout << "leg " << leg_ << ": " << duration << " s" << std::endl;
+      if (leg_ == nb_legs_)
+      {
+        std::cout << "mean: " << total_time_ / nb_legs_ << " s" << std::endl;
+        ExecutionManager::getManager().shutdown();
+      }
+    }
+
+    follower_->setFollowingPosition(targets_[leg_ % targets_.size()], 0.0);
+    follower_->avoidTheBall(false);
+    follower_->update(time, robot, ball);
+  }
+
+  Control control() const
+  {
+    return follower_->control();
+  }
+
+  rhoban_ssl::annotations::Annotations getAnnotations() const
+  {
+    return follower_->getAnnotations();
+  }
+};
+
+/**
+ * @brief Prints the mean duration of the planning of a trajectory.
+ */
+void benchmarkPlanning()
+{
+  const int nb_plans = 100000;
+  BangBangTrajectory2D trajectory;
+  double sum = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < nb_plans; ++i)
+  {
+    trajectory.generate(Vector2d(-2.0 + (i % 7) * 0.5, -1.0), Vector2d(0.5, (i % 5) * 0.2 - 0.4), Vector2d(2.0, 1.5),
+                        ai::Config::translation_velocity_limit, ai::Config::translation_acceleration_limit);
+    sum += trajectory.totalTime();
+  }
+  double duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "planning: " << duration / nb_plans * 1e6 << " us per trajectory (mean time " << sum / nb_plans
+            << " s)" << std::endl;
+}
+}  // namespace
+
+void stop(int)
+{
+  rhoban_ssl::ExecutionManager::getManager().shutdown();
+}
+
+int main(int argc, char** argv)
+{
+  // Enabling floating point errors
+  feenableexcept(FE_DIVBYZERO | FE_INVALID | FE_OVERFLOW);
+  signal(SIGINT, stop);
+
+  TCLAP::CmdLine cmd("Point-to-point comparison of the consign followers", ' ', "0.0", true);
+  TCLAP::SwitchArg simulation("s", "simulation", "Simulation mode", cmd, false);
+  TCLAP::SwitchArg yellow("y", "yellow", "If set we are yellow otherwise we are blue.", cmd, false);
+  TCLAP::ValueArg<std::string> config_path("c", "config", "The config path to the json configuration of AI", false,
+                                           CONFIG_PATH, "string", cmd);
+  TCLAP::ValueArg<std::string> addr("a", "address", "Vision client address", false, SSL_VISION_ADDRESS, "string",
+                                    cmd);
+  TCLAP::ValueArg<std::string> port("p", "port", "Vision client port", false, SSL_VISION_PORT, "string", cmd);
+  TCLAP::ValueArg<std::string> sim_port("u", "sim_port", "Vision client simulator port", false,
+                                        SSL_SIMULATION_VISION_PORT, "string", cmd);
+  TCLAP::ValueArg<uint> assigned_robot("r", "robot_number", "The number of the robot to move", true, 0, "uint", cmd);
+  TCLAP::ValueArg<std::string> follower_name("f", "follower", "The follower to use: 'pid' or 'bang_bang'", false,
+                                             "bang_bang", "string", cmd);
+  TCLAP::ValueArg<unsigned int> nb_legs("n", "legs", "Number of point-to-point moves", false, 8, "uint", cmd);
+  TCLAP::ValueArg<double> half_length("x", "half_length", "Half length of the rectangle (m)", false, 2.0, "double",
+                                      cmd);
+  TCLAP::ValueArg<double> half_width("w", "half_width", "Half width of the rectangle (m)", false, 1.0, "double", cmd);
+  cmd.parse(argc, argv);
+
+  ai::Config::we_are_blue = !yellow.getValue();
+  ai::Config::is_in_simulation = simulation.getValue();
+  ai::Config::load(config_path.getValue());
+
+  benchmarkPlanning();
+
+  robot_behavior::ConsignFollower* follower;
+  if (follower_name.getValue() == "pid")
+  {
+    robot_behavior::PositionFollower* position_follower =
+        new robot_behavior::PositionFollower(Data::get()->time.now(), ai::Config::period);
+    position_follower->setTranslationPid(ai::Config::p_translation, ai::Config::i_translation,
+                                         ai::Config::d_translation);
+    position_follower->setOrientationPid(ai::Config::p_orientation, ai::Config::i_orientation,
+                                         ai::Config::d_orientation);
+    position_follower->setLimits(ai::Config::translation_velocity_limit, ai::Config::rotation_velocity_limit,
+                                 ai::Config::translation_acceleration_limit, ai::Config::rotation_acceleration_limit);
+    follower = position_follower;
+  }
+  else if (follower_name.getValue() == "bang_bang")
+  {
+    follower = new robot_behavior::TrajectoryFollower();
+  }
+  else
+  {
+    std::cerr << "Unknown follower: " << follower_name.getValue() << std::endl;
+    return 1;
+  }
+
+  double x = half_length.getValue();
+  double y = half_width.getValue();
+  std::vector<rhoban_geometry::Point> targets = { rhoban_geometry::Point(-x, -y), rhoban_geometry::Point(x, -y),
+                                                  rhoban_geometry::Point(x, y), rhoban_geometry::Point(-x, y) };
+
+  addCoreTasks();
+  addVisionTasks(addr.getValue(), simulation.getValue() ? sim_port.getValue() : port.getValue(),
+                 vision::PartOfTheField::ALL_FIELD);
+  addRobotComTasks();
+
+  ExecutionManager::getManager().addTask(
+      new ConditionalTask([]() -> bool { return vision::VisionDataGlobal::singleton_.last_packets_.size() > 0; },
+                          [&]() -> bool {
+                            Data::get()->robots[Ally][assigned_robot.getValue()].is_goalie = false;
+                            ExecutionManager::getManager().addTask(
+                                new robot_behavior::RobotBehaviorTask(
+                                    assigned_robot.getValue(), new PointToPoint(follower, targets, nb_legs.getValue())),
+                                102);
+                            return false;
+                          }));
+
+  ExecutionManager::getManager().run(0.01);
+
+  ::google::protobuf::ShutdownProtobufLibrary();
+  return 0;
+}
@@ -0,0 +1,96 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Transitions per second of a MachineState: a ring of states, each of them with
+ * one edge to the next state that fires once per run() and some edges that never fire.
+ *
+ * ./bin/machine_state_benchmark -s 16 -e 4 -r 1000000
+ */
+
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <tclap/CmdLine.h>
+#include <core/machine_state.h>
+
+namespace
+{
+struct Data
+{
+  unsigned long nb_states_run;
+  unsigned long nb_edges_run;
+};
+
+typedef construct_machine_state_infrastructure<std::string, Data, Data> Infra;
+
+std::string stateName(int i)
+{
+  return "state_" + std::to_string(i);
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  TCLAP::CmdLine cmd("Machine state benchmark", ' ', "0.0", true);
+  TCLAP::ValueArg<int> nb_states("s", "states", "Number of states in the ring", false, 16, "int", cmd);
+  TCLAP::ValueArg<int> nb_edges("e", "edges", "Number of edges out of each state", false, 4, "int", cmd);
+  TCLAP::ValueArg<int> nb_tokens("t", "tokens", "Number of states active at the same time", false, 2, "int", cmd);
+  TCLAP::ValueArg<int> nb_runs("r", "runs", "Number of calls to run()", false, 1000000, "int", cmd);
+  cmd.parse(argc, argv);
+
+  Data data = { 0, 0 };
+  Infra::MachineState machine(data, data);
+  for (int i = 0; i < nb_states.getValue(); i++)
+  {
+    machine.addState(stateName(i), [](Data& data, unsigned int, unsigned int) { data.nb_states_run++; });
+  }
+  for (int i = 0; i < nb_states.getValue(); i++)
+  {
+    for (int k = 1; k < nb_edges.getValue(); k++)
+    {
+      machine.addEdge(stateName(i) + "_never_" + std::to_string(k), stateName(i),
+                      stateName((i + k + 1) % nb_states.getValue()),
+                      [](const Data& data, unsigned int run_number, unsigned int) { return run_number == 0; });
+    }
+    // fires at the first atomic run of each run, so each token moves once per run
+    machine.addEdge(stateName(i) + "_next", stateName(i), stateName((i + 1) % nb_states.getValue()),
+                    [](const Data&, unsigned int, unsigned int atomic_run_number) { return atomic_run_number == 1; },
+                    [](Data& data, unsigned int, unsigned int) { data.nb_edges_run++; });
+  }
+  for (int i = 0; i < nb_tokens.getValue(); i++)
+  {
+    machine.addInitState(stateName(i * nb_states.getValue() / nb_tokens.getValue()));
+  }
+  machine.start();
+
+  auto start = std::chrono::steady_clock::now();
+  for (int run = 0; run < nb_runs.getValue(); run++)
+  {
+    machine.run();
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << nb_states.getValue() << " states, " << nb_edges.getValue() << " edges per state, "
+            << nb_tokens.getValue() << " active states:" << std::endl;
+  std::cout << "  run(): " << 1e6 * seconds / nb_runs.getValue() << " us" << std::endl;
+  std::cout << "  transitions: " << data.nb_edges_run / seconds << " per second" << std::endl;
+  std::cout << "  state runs: " << data.nb_states_run / seconds << " per second" << std::endl;
+  return 0;
+}
@@ -0,0 +1,145 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Compares the minimum cost assignment (matching::Assignment) with the stable matching
+ * of Gale-Shapley (what the manager used before) on random placements of robots.
+ *
+ * ./bin/matching_benchmark -n 1000 -r 16
+ */
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <tclap/CmdLine.h>
+#include <math/matching.h>
+#include <math/vector2d.h>
+
+using namespace rhoban_ssl;
+
+namespace
+{
+struct Result
+{
+  double microseconds;
+  double cost;
+};
+
+double squaredDistance(const Vector2d& a, const Vector2d& b)
+{
+  return (a - b).normSquare();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  TCLAP::CmdLine cmd("Assignment benchmark", ' ', "0.0", true);
+  TCLAP::ValueArg<int> nb_problems("n", "problems", "Number of random problems", false, 1000, "int", cmd);
+  TCLAP::ValueArg<int> nb_robots("r", "robots", "Number of robots and of positions", false, 16, "int", cmd);
+  TCLAP::ValueArg<double> move("m", "move", "Move (m) of the robots between two warm starts", false, 0.05, "double",
+                               cmd);
+  cmd.parse(argc, argv);
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> xs(-6.0, 6.0);
+  std::uniform_real_distribution<double> ys(-4.5, 4.5);
+  std::uniform_real_distribution<double> moves(-move.getValue(), move.getValue());
+
+  int n = nb_robots.getValue();
+  std::vector<Vector2d> robots(n);
+  std::vector<Vector2d> positions(n);
+  std::function<double(const Vector2d& robot, const Vector2d& position)> robot_rank = squaredDistance;
+  std::function<double(const Vector2d& position, const Vector2d& robot)> position_rank = squaredDistance;
+
+  Result gale_shapley = { 0.0, 0.0 };
+  Result cold = { 0.0, 0.0 };
+  Result warm = { 0.0, 0.0 };
+  matching::Assignment cold_assignment;
+  matching::Assignment warm_assignment;
+  warm_assignment.resize(n, n);
+  for (int problem = 0; problem < nb_problems.getValue(); problem++)
+  {
+    for (int i = 0; i < n; i++)
+    {
+      robots[i] = Vector2d(xs(generator), ys(generator));
+      positions[i] = Vector2d(xs(generator), ys(generator));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    matching::Matchings matchings =
+        matching::galeShapleyAlgorithm(robots, positions, robot_rank, position_rank, false, false);
+    gale_shapley.microseconds +=
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    for (const std::pair<unsigned int, unsigned int>& pair : matchings.man_to_women_matchings)
+    {
+      gale_shapley.cost += squaredDistance(robots[pair.first], positions[pair.second]);
+    }
+
+    start = std::chrono::steady_clock::now();
+    cold_assignment.resize(n, n);
+    cold_assignment.reset();
+    for (int i = 0; i < n; i++)
+    {
+      for (int j = 0; j < n; j++)
+      {
+        cold_assignment.cost(i, j) = squaredDistance(positions[i], robots[j]);
+      }
+    }
+    cold_assignment.solve();
+    cold.microseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    cold.cost += cold_assignment.totalCost();
+
+    // The same problem a tick later: the robots moved a little
+    warm_assignment.reset();
+    for (int i = 0; i < n; i++)
+    {
+      for (int j = 0; j < n; j++)
+      {
+        warm_assignment.cost(i, j) = cold_assignment.cost(i, j);
+      }
+    }
+    warm_assignment.solve();
+    for (int j = 0; j < n; j++)
+    {
+      robots[j] += Vector2d(moves(generator), moves(generator));
+    }
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; i++)
+    {
+      for (int j = 0; j < n; j++)
+      {
+        warm_assignment.cost(i, j) = squaredDistance(positions[i], robots[j]);
+      }
+    }
+    warm_assignment.solve();
+    warm.microseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    warm.cost += warm_assignment.totalCost();
+  }
+
+  int nb = nb_problems.getValue();
+  std::cout << n << "x" << n << " assignments, mean on " << nb << " problems:" << std::endl;
+  std::cout << "  gale-shapley: " << gale_shapley.microseconds / nb << " us, sum of squared distances "
+            << gale_shapley.cost / nb << " m2" << std::endl;
+  std::cout << "  hungarian: " << cold.microseconds / nb << " us, sum of squared distances " << cold.cost / nb << " m2"
+            << std::endl;
+  std::cout << "  hungarian after a move of " << move.getValue() << " m (warm start): " << warm.microseconds / nb
+            << " us" << std::endl;
+  return 0;
+}
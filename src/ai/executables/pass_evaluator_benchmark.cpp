@@ -0,0 +1,91 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Time to evaluate all the passes (all the receivers, opponents and kick speeds) with
+ * PassEvaluator, on random positions and velocities of the robots.
+ *
+ * ./bin/pass_evaluator_benchmark -n 1000
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <tclap/CmdLine.h>
+#include <math/pass_evaluator.h>
+
+namespace
+{
+double microseconds(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  TCLAP::CmdLine cmd("Pass evaluator benchmark", ' ', "0.0", true);
+  TCLAP::ValueArg<int> nb_problems("n", "problems", "Number of random positions of the robots", false, 1000, "int",
+                                   cmd);
+  TCLAP::ValueArg<int> nb_receivers("r", "receivers", "Number of receivers", false, 7, "int", cmd);
+  TCLAP::ValueArg<int> nb_opponents("o", "opponents", "Number of opponents", false, 8, "int", cmd);
+  cmd.parse(argc, argv);
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> xs(-6.0, 6.0);
+  std::uniform_real_distribution<double> ys(-4.5, 4.5);
+  std::uniform_real_distribution<double> velocities(-2.0, 2.0);
+
+  auto start = std::chrono::steady_clock::now();
+  PassEvaluator evaluator;
+  double construction_us = microseconds(start);
+
+  double total_us = 0.0;
+  double max_us = 0.0;
+  unsigned long nb_safe_passes = 0;
+  for (int problem = 0; problem < nb_problems.getValue(); problem++)
+  {
+    evaluator.setBall(Vector2d(xs(generator), ys(generator)));
+    evaluator.clearReceivers();
+    for (int i = 0; i < nb_receivers.getValue(); i++)
+    {
+      evaluator.addReceiver(Vector2d(xs(generator), ys(generator)));
+    }
+    evaluator.clearOpponents();
+    for (int i = 0; i < nb_opponents.getValue(); i++)
+    {
+      Vector2d position(xs(generator), ys(generator));
+      evaluator.addOpponent(position, Vector2d(velocities(generator), velocities(generator)));
+    }
+
+    start = std::chrono::steady_clock::now();
+    nb_safe_passes += evaluator.evaluate().size();
+    double us = microseconds(start);
+    total_us += us;
+    max_us = std::max(max_us, us);
+  }
+
+  std::cout << nb_receivers.getValue() << " receivers, " << nb_opponents.getValue() << " opponents, "
+            << PassEvaluator::Parameters().kick_speeds.size() << " kick speeds:" << std::endl;
+  std::cout << "  tables: " << construction_us << " us" << std::endl;
+  std::cout << "  evaluation: " << total_us / nb_problems.getValue() << " us (max " << max_us << " us)" << std::endl;
+  std::cout << "  safe passes: " << double(nb_safe_passes) / nb_problems.getValue() << std::endl;
+  return 0;
+}
@@ -0,0 +1,127 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Drives the Commander at a fixed rate against a mock radio (a fake mainboard on a
+ * pseudo-terminal) and measures the delay between the publication of the commands
+ * and the answer of the robots.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <tclap/CmdLine.h>
+#include <mock_radio.h>
+#include <com/ai_commander.h>
+#include <data.h>
+
+using namespace rhoban_ssl;
+
+int main(int argc, char** argv)
+{
+  TCLAP::CmdLine cmd("Commander to robot answer latency benchmark", ' ', "0.0", true);
+  TCLAP::ValueArg<double> rate("r", "rate", "Rate of the commands (Hz)", false, 150.0, "double", cmd);
+  TCLAP::ValueArg<double> duration("t", "duration", "Duration of the benchmark (s)", false, 10.0, "double", cmd);
+  TCLAP::ValueArg<double> delay("d", "delay", "Answer delay of the mock radio (ms)", false, 2.0, "double", cmd);
+  TCLAP::ValueArg<double> jitter("j", "jitter", "Maximum random extra delay (ms)", false, 1.0, "double", cmd);
+  TCLAP::ValueArg<double> loss("l", "loss", "Probability to lose an answer", false, 0.0, "double", cmd);
+  cmd.parse(argc, argv);
+
+  ai::Config::is_in_simulation = false;
+  ai::Config::is_in_mixcontrol = false;
+
+  MockRadio radio({ delay.getValue() / 1000, jitter.getValue() / 1000, loss.getValue(), 42 });
+  control::Commander commander(radio.port());
+
+  std::mutex mutex;
+  std::vector<double> latencies;
+  commander.real_->setAnswerCallback([&](double latency) {
+    std::lock_guard<std::mutex> lock(mutex);
+    latencies.push_back(latency);
+  });
+
+  for (uint robot_id = 0; robot_id < ai::Config::NB_OF_ROBOTS_BY_TEAM; ++robot_id)
+  {
+    Control& ctrl = Data::get()->shared_data.final_control_for_robots[robot_id].control;
+    ctrl = Control(Vector2d(0.5, 0.0), ContinuousAngle(1.0), false);
+  }
+
+  auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(1.0 / rate.getValue()));
+  auto next = std::chrono::steady_clock::now();
+  long nb_ticks = static_cast<long>(duration.getValue() * rate.getValue());
+  for (long tick = 0; tick < nb_ticks; ++tick)
+  {
+    commander.runTask();
+    next += period;
+    std::this_thread::sleep_until(next);
+  }
+  // the last answers
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  Master::SendStats stats = commander.real_->sendStats();
+  std::vector<double> sorted;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    sorted = latencies;
+  }
+  std::sort(sorted.begin(), sorted.end());
+
+  std::cout << "Commands: " << nb_ticks << " at " << rate.getValue() << " Hz" << std::endl;
+  std::cout << "Frames: " << stats.published << " published, " << stats.sent << " sent, " << stats.superseded
+            << " superseded, " << stats.lateAnswers << " late answers" << std::endl;
+  std::cout << "Mock radio: " << radio.nbFrames() << " frames, " << radio.nbAnswers() << " answers, "
+            << radio.nbLost() << " lost" << std::endl;
+  std::cout << "Publication to write: mean " << stats.meanLatency * 1000 << " ms, max " << stats.maxLatency * 1000
+            << " ms" << std::endl;
+
+  if (sorted.empty())
+  {
+    std::cout << "No answer received" << std::endl;
+    return 1;
+  }
+  std::cout << "Publication to answer (" << sorted.size() << " answers):";
+  const double percentiles[] = { 0.0, 0.5, 0.9, 0.99, 1.0 };
+  const char* names[] = { "min", "p50", "p90", "p99", "max" };
+  for (int i = 0; i < 5; ++i)
+  {
+    size_t index = std::min(sorted.size() - 1, static_cast<size_t>(percentiles[i] * sorted.size()));
+    std::cout << " " << names[i] << " " << sorted[index] * 1000 << " ms";
+  }
+  std::cout << std::endl;
+
+  // histogram with 1 ms bins
+  std::vector<unsigned long> histogram(static_cast<size_t>(sorted.back() * 1000) + 1, 0);
+  for (double latency : sorted)
+  {
+    histogram[static_cast<size_t>(latency * 1000)]++;
+  }
+  for (size_t bin = 0; bin < histogram.size(); ++bin)
+  {
+    if (histogram[bin] > 0)
+    {
+      std::cout << "  " << bin << "-" << bin + 1 << " ms: " << histogram[bin] << std::endl;
+    }
+  }
+
+  return 0;
+}
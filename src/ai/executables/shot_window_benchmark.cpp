@@ -0,0 +1,140 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Compares the shot windows (ShotWindows) with the sampling of the goal that
+ * findGoalBestMove did before, on random positions of the robots.
+ *
+ * ./bin/shot_window_benchmark -n 1000 -c 256
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <tclap/CmdLine.h>
+#include <math/shot_window.h>
+
+namespace
+{
+const double GOAL_X = 6.0;
+const double GOAL_WIDTH = 1.2;
+const double RADIUS = 0.15;
+
+// The previous findGoalBestMove: 14 shots to the goal, each one checked against all the robots
+double sampledProbability(const rhoban_geometry::Point& shooter, const std::vector<rhoban_geometry::Point>& robots)
+{
+  const int nb_analysed_point = 16;
+  int nb_valid_path = 0;
+  int max_valid_path = 0;
+  for (int i = 1; i < nb_analysed_point - 1; i++)
+  {
+    rhoban_geometry::Point analysed_point(GOAL_X, -GOAL_WIDTH / 2.0 + GOAL_WIDTH / nb_analysed_point * i);
+    Vector2d u = Vector2d(analysed_point - shooter);
+    u = u / u.norm();
+    bool free = true;
+    for (const rhoban_geometry::Point& robot : robots)
+    {
+      // distanceFromPointToLine()
+      if (std::fabs(vectorialProduct(u, robot - shooter)) <= RADIUS)
+      {
+        free = false;
+      }
+    }
+    nb_valid_path = free ? nb_valid_path + 1 : 0;
+    max_valid_path = std::max(max_valid_path, nb_valid_path);
+  }
+  return double(max_valid_path) / nb_analysed_point;
+}
+
+double microseconds(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  TCLAP::CmdLine cmd("Shot window benchmark", ' ', "0.0", true);
+  TCLAP::ValueArg<int> nb_problems("n", "problems", "Number of random positions of the robots", false, 1000, "int",
+                                   cmd);
+  TCLAP::ValueArg<int> nb_candidates("c", "candidates", "Number of shooting positions", false, 256, "int", cmd);
+  TCLAP::ValueArg<int> nb_robots("r", "robots", "Number of robots", false, 16, "int", cmd);
+  cmd.parse(argc, argv);
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> xs(0.0, GOAL_X);
+  std::uniform_real_distribution<double> ys(-4.5, 4.5);
+
+  std::vector<rhoban_geometry::Point> robots(nb_robots.getValue());
+  std::vector<rhoban_geometry::Point> candidates(nb_candidates.getValue());
+  std::vector<Vector2d> shooters(nb_candidates.getValue());
+  std::vector<ShotWindow> windows;
+  double sampling_us = 0.0;
+  double scalar_us = 0.0;
+  double batch_us = 0.0;
+  double checksum = 0.0;
+  for (int problem = 0; problem < nb_problems.getValue(); problem++)
+  {
+    ShotWindows shot_windows(GOAL_X, GOAL_WIDTH, RADIUS);
+    for (rhoban_geometry::Point& robot : robots)
+    {
+      robot = rhoban_geometry::Point(xs(generator), ys(generator));
+      shot_windows.addObstacle(robot);
+    }
+    for (unsigned int i = 0; i < candidates.size(); i++)
+    {
+      candidates[i] = rhoban_geometry::Point(xs(generator), ys(generator));
+      shooters[i] = candidates[i];
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (const rhoban_geometry::Point& candidate : candidates)
+    {
+      checksum += sampledProbability(candidate, robots);
+    }
+    sampling_us += microseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const Vector2d& shooter : shooters)
+    {
+      checksum += shot_windows.evaluate(shooter).probability;
+    }
+    scalar_us += microseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    shot_windows.evaluate(shooters, windows);
+    batch_us += microseconds(start);
+    checksum += windows[0].probability;
+  }
+
+  double nb = double(nb_problems.getValue()) * nb_candidates.getValue() / 1000.0;
+  std::cout << nb_robots.getValue() << " robots, time per shooting position:" << std::endl;
+  std::cout << "  sampling (previous findGoalBestMove): " << sampling_us / nb << " ns" << std::endl;
+  std::cout << "  shot window: " << scalar_us / nb << " ns" << std::endl;
+  std::cout << "  shot windows by batch of " << nb_candidates.getValue() << ": " << batch_us / nb << " ns"
+            << std::endl;
+  // prevents the compiler from removing the evaluations
+  if (checksum == 42.0)
+  {
+    std::cout << checksum << std::endl;
+  }
+  return 0;
+}
@@ -1,6 +1,7 @@
 #include "tools.h"
 #include <execution_manager.h>
 #include <ai.h>
+#include <control/control_loop.h>
 #include <referee_client_single_thread.h>
 #include <referee/referee_packet_analyzer.h>
 #include <data/computed_data.h>
@@ -54,12 +55,21 @@ void addRefereeTasks(std::string referee_port)
 void addPreBehaviorTreatment()
 {  // range 300
   ExecutionManager::getManager().addTask(new data::CollisionComputing(), 300);
+  ExecutionManager::getManager().addTask(new data::TickCacheComputing(), 310);
+  ExecutionManager::getManager().addTask(new data::ValueMapsComputing(), 320);
 }
 
 void addRobotComTasks()
 {  // range 2000
-  ExecutionManager::getManager().addTask(new control::LimitVelocities(), 2000);
-  ExecutionManager::getManager().addTask(new control::Commander(), 2010);
+  if (ai::Config::control_rate > 0)
+  {
+    ExecutionManager::getManager().addTask(new control::ControlLoop(ai::Config::control_rate), 2010);
+  }
+  else
+  {
+    ExecutionManager::getManager().addTask(new control::LimitVelocities(), 2000);
+    ExecutionManager::getManager().addTask(new control::Commander(), 2010);
+  }
 }
 
 void addViewerTasks(ai::AI* ai, int port)
@@ -0,0 +1,167 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+ * Measures the size and the cpu time of a viewer frame for each encoding
+ * (json text, protobuf binary and protobuf keyframes/deltas) on a synthetic game
+ * with annotations.
+ *
+ * ./bin/viewer_encodings -f 600 -a 16
+ *
+ * With the defaults (-O2, one Xeon core), by frame:
+ *   json:           31.5 kB, 1.1 to 1.4 ms
+ *   protobuf:        6.6 kB, 40 to 60 us
+ *   protobuf delta:  5.1 kB, 49 to 65 us
+ */
+
+#include <iostream>
+#include <chrono>
+#include <tclap/CmdLine.h>
+#include <viewer/viewer_serializer.h>
+#include <ssl_referee.pb.h>
+
+using namespace rhoban_ssl;
+
+void fillSnapshot(viewer::ViewerSnapshot& snapshot, int frame, int shapes_by_robot)
+{
+  double t = frame / 60.0;
+  snapshot.time = t;
+  snapshot.we_are_blue = true;
+  snapshot.robot_radius = 0.09;
+
+  snapshot.field = { 12.0, 9.0, 0.3, 1.2, 0.18, 2.4, 1.2, 0.0, 0.0, 0.5 };
+  snapshot.ball = { std::cos(t), std::sin(t), -std::sin(t), std::cos(t), 0.021375 };
+
+  for (uint team_id = 0; team_id < 2; team_id++)
+  {
+    viewer::snapshot::Team& team = snapshot.teams[team_id];
+    viewer::snapshot::copyName(team.name, team_id == Ally ? "NAMeC" : "Opponent");
+    team.positive_axis = (team_id == Ally);
+    team.score = 0;
+    team.timeout_remaining_count = 4;
+    team.timeout_remaining_time = 300000000;
+    team.goalkeeper_number = 0;
+    team.yellow_cards_count = 0;
+    team.nb_yellow_card_times = 0;
+    team.red_cards_count = 0;
+    team.foul_counter = 0;
+    team.max_allowed_bots = ai::Config::NB_OF_ROBOTS_BY_TEAM;
+
+    for (uint rid = 0; rid < ai::Config::NB_OF_ROBOTS_BY_TEAM; rid++)
+    {
+      viewer::snapshot::Robot& robot = team.bots[rid];
+      robot.number = rid;
+      robot.time = t;
+      robot.x = (team_id == Ally ? -1.0 : 1.0) * (0.5 + 0.5 * rid);
+      robot.y = std::sin(t + rid);
+      robot.orientation = t;
+      robot.vx = 0.1 * rid;
+      robot.vy = std::cos(t + rid);
+      robot.vtheta = 1.0;
+      robot.is_present = true;
+      viewer::snapshot::copyName(robot.behavior, "Navigation_with_obstacle_avoidance");
+      robot.electronics = { true, 15.8, 180.0, false, robot.x, robot.y, t, false };
+    }
+  }
+
+  snapshot.referee = { Referee_Stage_NORMAL_FIRST_HALF, 300000000, Referee_Command_FORCE_START };
+  snapshot.informations.simulation = false;
+  snapshot.informations.packets_per_second = 60.0;
+  snapshot.informations.snapshot_duration = 0.0;
+  snapshot.informations.serialization_duration = 0.0;
+  snapshot.informations.superseded_snapshots = 0;
+  snapshot.informations.refinement_duration = 0.0005;
+  snapshot.informations.refinement_budget = 0.002;
+  snapshot.informations.refinement_pending = false;
+  snapshot.informations.has_radio = false;
+
+  snapshot.ai.has_ai = true;
+  viewer::snapshot::copyName(snapshot.ai.current_manager, "Match");
+  snapshot.ai.nb_strategies_used = 0;
+  snapshot.ai.nb_strategies = 0;
+
+  // full annotations: each robot draws circles, arrows, crosses and boxes.
+  snapshot.annotations.clear();
+  for (uint rid = 0; rid < ai::Config::NB_OF_ROBOTS_BY_TEAM; rid++)
+  {
+    const viewer::snapshot::Robot& robot = snapshot.teams[Ally].bots[rid];
+    for (int i = 0; i < shapes_by_robot; ++i)
+    {
+      switch (i % 4)
+      {
+        case 0:
+          snapshot.annotations.addCircle(robot.x, robot.y, 0.2 + 0.01 * i, "red", "transparent", true);
+          break;
+        case 1:
+          snapshot.annotations.addArrow(robot.x, robot.y, robot.x + robot.vx, robot.y + robot.vy, "magenta");
+          break;
+        case 2:
+          snapshot.annotations.addCross(robot.x + 0.1 * i, robot.y, "blue");
+          break;
+        default:
+          snapshot.annotations.addBox(Box(rhoban_geometry::Point(robot.x - 0.1, robot.y - 0.1),
+                                          rhoban_geometry::Point(robot.x + 0.1, robot.y + 0.1)),
+                                      "orange");
+      }
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  TCLAP::CmdLine cmd("Viewer encodings benchmark", ' ', "0.0", true);
+  TCLAP::ValueArg<int> frames("f", "frames", "Number of frames to serialize", false, 600, "int", cmd);
+  TCLAP::ValueArg<int> shapes("a", "annotations", "Number of annotations by robot", false, 16, "int", cmd);
+  cmd.parse(argc, argv);
+
+  viewer::ViewerSerializer serializer;
+  viewer::ViewerSnapshot& snapshot = serializer.backBuffer();
+  std::vector<viewer::ViewerPacket> packets;
+
+  const char* names[viewer::ViewerPacket::NB_ENCODINGS] = { "json", "protobuf", "protobuf delta" };
+  for (int encoding = 0; encoding < viewer::ViewerPacket::NB_ENCODINGS; ++encoding)
+  {
+    double total_duration = 0.0;
+    unsigned long total_bytes = 0;
+    for (int frame = 0; frame < frames.getValue(); ++frame)
+    {
+      fillSnapshot(snapshot, frame, shapes.getValue());
+      packets.clear();
+
+      auto start = std::chrono::high_resolution_clock::now();
+      serializer.serialize(snapshot, static_cast<viewer::ViewerPacket::Encoding>(encoding), packets);
+      total_duration +=
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start)
+              .count() /
+          1e9;
+
+      for (const viewer::ViewerPacket& packet : packets)
+      {
+        total_bytes += packet.payload.size();
+      }
+    }
+    double bytes_by_frame = double(total_bytes) / frames.getValue();
+    double duration_by_frame = total_duration / frames.getValue();
+    std::cout << names[encoding] << ": " << bytes_by_frame << " bytes/frame, " << duration_by_frame * 1e6
+              << " us/frame, at 60Hz: " << bytes_by_frame * 60 / 1024 << " KiB/s, " << duration_by_frame * 60 * 100
+              << " % of a core" << std::endl;
+  }
+
+  return 0;
+}
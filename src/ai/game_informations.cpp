@@ -20,9 +20,158 @@
 
 #include "game_informations.h"
 #include "math/lines.h"
+#include "math/shot_window.h"
+#include "math/pass_evaluator.h"
 
 namespace rhoban_ssl
 {
+namespace
+{
+// The queries without the cache, at the given time
+
+void appendRobotsInLine(const rhoban_geometry::Point& p1, const rhoban_geometry::Point& p2, Team team,
+                        double distance, double time, std::vector<int>& result)
+{
+  if (normSquare(p1 - p2) == 0)
+  {
+    return;
+  }
+
+  for (size_t i = 0; i < ai::Config::NB_OF_ROBOTS_BY_TEAM; i++)
+  {
+    const data::Robot& robot = Data::get()->robots[team][i];
+    if (robot.isActive())
+    {
+      const rhoban_geometry::Point& robot_position = robot.getMovement().linearPosition(time);
+      if (distanceFromPointToLine(robot_position, p1, p2) <= distance)
+      {
+        result.push_back(i);
+      }
+    }
+  }
+}
+
+int closestRobot(Team team, const rhoban_geometry::Point& point, double time)
+{
+  int id = -1;
+  double distance_max = -1;
+  for (int i = 0; i < ai::Config::NB_OF_ROBOTS_BY_TEAM; i++)
+  {
+    const data::Robot& robot = Data::get()->robots[team][i];
+    if (robot.isActive())
+    {
+      const rhoban_geometry::Point& robot_position = robot.getMovement().linearPosition(time);
+      double distance = robot_position.getDist(point);
+      if (id == -1 or distance < distance_max)
+      {
+        distance_max = distance;
+        id = i;
+      }
+    }
+  }
+  return id;
+}
+
+double robotDistanceFromAllyGoalCenter(const data::Robot& robot, double time)
+{
+  double distance = -1;
+  if (robot.isActive())
+  {
+    const rhoban_geometry::Point& robot_position = robot.getMovement().linearPosition(time);
+    Vector2d goal_center_robot = robot_position - Data::get()->field.goalCenter(Ally);
+    distance = goal_center_robot.norm();
+    distance = (Data::get()->field.field_length - distance) / Data::get()->field.field_length;
+  }
+  return distance;
+}
+
+// Sorts the active robots by their values, the robots with the same value stay in the order of their numbers
+template <typename Value>
+data::Ranking rankRobots(Team team, bool increasing, Value value_of_robot)
+{
+  data::Ranking ranking;
+  ranking.nb_robots = 0;
+  for (int i = 0; i < ai::Config::NB_OF_ROBOTS_BY_TEAM; i++)
+  {
+    const data::Robot& robot = Data::get()->robots[team][i];
+    ranking.value_of_robot[i] = value_of_robot(robot);
+    if (!robot.isActive())
+    {
+      continue;
+    }
+    double value = ranking.value_of_robot[i];
+    int rank = ranking.nb_robots;
+    while (rank > 0 && (increasing ? value < ranking.value_of_robot[ranking.robots[rank - 1]] :
+                                     value > ranking.value_of_robot[ranking.robots[rank - 1]]))
+    {
+      ranking.robots[rank] = ranking.robots[rank - 1];
+      rank--;
+    }
+    ranking.robots[rank] = i;
+    ranking.nb_robots++;
+  }
+  return ranking;
+}
+
+// Radius around the robots where the shots are blocked
+const double SHOT_BLOCKING_RADIUS = 0.15;
+
+// The windows in the goal of the opponent, with all the active robots but the shooter as obstacles
+ShotWindows opponentGoalShotWindows(int shooter, double time)
+{
+  ShotWindows shot_windows(Data::get()->field.field_length / 2.0, Data::get()->field.goal_width,
+                           SHOT_BLOCKING_RADIUS);
+  for (const std::pair<Team, data::Robot*>& elem : Data::get()->all_robots)
+  {
+    bool is_shooter = elem.first == Ally && int(elem.second->id) == shooter;
+    if (elem.second->isActive() && not(is_shooter))
+    {
+      shot_windows.addObstacle(elem.second->getMovement().linearPosition(time));
+    }
+  }
+  return shot_windows;
+}
+
+std::pair<rhoban_geometry::Point, double> goalBestMove(const rhoban_geometry::Point& point,
+                                                       const rhoban_geometry::Point& goal, int shooter, double time)
+{
+  ShotWindow window = opponentGoalShotWindows(shooter, time).evaluate(point);
+  if (!window.open)
+  {
+    rhoban_geometry::Point opponent_goal_point = goal;
+    if (goal == rhoban_geometry::Point(66, 66))
+    {
+      opponent_goal_point = Data::get()->field.goalCenter(Opponent);
+    }
+    return std::pair<rhoban_geometry::Point, double>(opponent_goal_point, 0.0);
+  }
+  return std::pair<rhoban_geometry::Point, double>(window.target, window.probability);
+}
+
+// The opponents are supposed to move like our robots
+PassEvaluator::Parameters passParameters()
+{
+  PassEvaluator::Parameters parameters;
+  parameters.opponent_acceleration = ai::Config::translation_acceleration_limit;
+  parameters.opponent_max_speed = ai::Config::translation_velocity_limit;
+  parameters.interception_radius = ai::Config::robot_radius + ai::Config::ball_radius;
+  return parameters;
+}
+
+// Computes the query now, or once for the tick when the cache is enabled
+template <typename Value, unsigned int NB_KEYS, typename Compute>
+Value query(data::Memo<Value, NB_KEYS> data::TickCache::*memo, const typename data::Memo<Value, NB_KEYS>::Key& key,
+            Compute compute)
+{
+  data::TickCache& cache = Data::get()->tick_cache;
+  if (!cache.enabled())
+  {
+    return compute(Data::get()->time.now());
+  }
+  return cache.get(cache.*memo, key, [&]() { return compute(cache.time()); });
+}
+}  // namespace
+
 GameInformations::GameInformations()
 {
 }
@@ -49,23 +198,14 @@ const data::Robot& GameInformations::getRobot(int robot_number, Team team) const
 void GameInformations::getRobotInLine(const rhoban_geometry::Point p1, const rhoban_geometry::Point p2, Team team,
                                       double distance, std::vector<int>& result) const
 {
-  if (normSquare(p1 - p2) == 0)
-  {
-    return;
-  }
-
-  for (size_t i = 0; i < ai::Config::NB_OF_ROBOTS_BY_TEAM; i++)
-  {
-    const data::Robot& robot = getRobot(i, team);
-    if (robot.isActive())
-    {
-      const rhoban_geometry::Point& robot_position = robot.getMovement().linearPosition(time());
-      if (distanceFromPointToLine(robot_position, p1, p2) <= distance)
-      {
-        result.push_back(i);
-      }
-    }
-  }
+  std::vector<int> robots = query(&data::TickCache::robots_in_line,
+                                  { { p1.getX(), p1.getY(), p2.getX(), p2.getY(), (double)team, distance } },
+                                  [&](double time) {
+                                    std::vector<int> robots;
+                                    appendRobotsInLine(p1, p2, team, distance, time, robots);
+                                    return robots;
+                                  });
+  result.insert(result.end(), robots.begin(), robots.end());
 }
 
 std::vector<int> GameInformations::getRobotInLine(const rhoban_geometry::Point p1, const rhoban_geometry::Point p2,
@@ -86,170 +226,93 @@ std::vector<int> GameInformations::getRobotInLine(const rhoban_geometry::Point p
 }
 
 std::pair<rhoban_geometry::Point, double> GameInformations::findGoalBestMove(const rhoban_geometry::Point point,
-                                                                             const rhoban_geometry::Point goal) const
+                                                                             const rhoban_geometry::Point goal,
+                                                                             int shooter) const
 {
-  rhoban_geometry::Point opponent_goal_point;
-  if (goal == rhoban_geometry::Point(66, 66))
-  {
-    opponent_goal_point = Data::get()->field.goalCenter(Opponent);
-  }
-  else
+  return query(&data::TickCache::goal_best_move,
+               { { point.getX(), point.getY(), goal.getX(), goal.getY(), double(shooter) } },
+               [&](double time) { return goalBestMove(point, goal, shooter, time); });
+}
+
+std::vector<PassOption> GameInformations::findSafePasses(const std::vector<int>& receivers) const
+{
+  // One evaluator by thread, the behaviors can be updated concurrently. Its tables are computed
+  // again only when the limits of the robots are changed (see UpdateConfigTask).
+  static thread_local PassEvaluator evaluator(passParameters());
+  evaluator.setParameters(passParameters());
+
+  double time = this->time();
+  evaluator.setBall(ball().getMovement().linearPosition(time));
+  evaluator.clearReceivers();
+  for (int receiver : receivers)
   {
-    opponent_goal_point = goal;
+    evaluator.addReceiver(getRobot(receiver, Ally).getMovement().linearPosition(time));
   }
-
-  rhoban_geometry::Point return_point;
-  const rhoban_geometry::Point left_post_position =
-      rhoban_geometry::Point(Data::get()->field.field_length / 2.0, Data::get()->field.goal_width / 2.0);
-  const rhoban_geometry::Point right_post_position =
-      rhoban_geometry::Point(Data::get()->field.field_length / 2.0, -Data::get()->field.goal_width / 2.0);
-  const Vector2d left_right_post_vector = right_post_position - left_post_position;
-  const double dist_post = left_right_post_vector.norm();
-  const int nb_analysed_point = 16;
-  rhoban_geometry::Point analysed_point;
-
-  int nb_valid_path = 0;
-  double max_valid_path = 0.0;
-  int max_i = 0;
-  bool max_valid_combo_begin = false;
-
-  for (size_t i = 1; i < nb_analysed_point - 1; i++)
+  evaluator.clearOpponents();
+  for (const data::Robot& robot : Data::get()->robots[Opponent])
   {
-    analysed_point = right_post_position + rhoban_geometry::Point(0, dist_post / nb_analysed_point * i);
-    std::vector<int> robot_in_line = GameInformations::getRobotInLine(point, analysed_point, Opponent, 0.15);
-    std::vector<int> robot_in_line2 = GameInformations::getRobotInLine(point, analysed_point, Ally, 0.15);
-    robot_in_line.insert(robot_in_line.end(), robot_in_line2.begin(), robot_in_line2.end());
-    if (robot_in_line.empty())
-    {
-      nb_valid_path++;
-      if (nb_valid_path > max_valid_path)
-      {
-        max_valid_path = nb_valid_path;
-        if (max_valid_combo_begin == false)
-        {
-          max_valid_combo_begin = true;
-          max_i = i;
-        }
-      }
-    }
-    else
+    if (robot.isActive())
     {
-      nb_valid_path = 0;
-      max_valid_combo_begin = false;
+      evaluator.addOpponent(robot.getMovement().linearPosition(time), robot.getMovement().linearVelocity(time));
     }
   }
 
-  if (max_valid_path == 0)
+  std::vector<PassOption> passes = evaluator.evaluate();
+  for (PassOption& pass : passes)
   {
-    return_point = opponent_goal_point;
+    pass.receiver = receivers[pass.receiver];
   }
-  else
-  {
-    return_point =
-        right_post_position + rhoban_geometry::Point(0, dist_post / nb_analysed_point * (max_i + max_valid_path / 2));
-  }
-
-  double proba = max_valid_path / nb_analysed_point;
-
-  std::pair<rhoban_geometry::Point, double> results(return_point, proba);
-
-  return results;
+  return passes;
 }
 
 int GameInformations::getShirtNumberOfClosestRobotToTheBall(Team team) const
 {
-  return getShirtNumberOfClosestRobot(team, ballPosition());
+  return closestRobotsToTheBall(team).robot(0);
+}
+
+data::Ranking GameInformations::closestRobotsToTheBall(Team team) const
+{
+  return query(&data::TickCache::closest_robots_to_the_ball, { { (double)team } }, [&](double time) {
+    rhoban_geometry::Point ball_position = ball().getMovement().linearPosition(time);
+    return rankRobots(team, true, [&](const data::Robot& robot) {
+      return robot.isActive() ? robot.getMovement().linearPosition(time).getDist(ball_position) : -1.0;
+    });
+  });
 }
 
 int GameInformations::getShirtNumberOfClosestRobot(Team team, rhoban_geometry::Point point) const
 {
-  int id = -1;
-  double distance_max = -1;
-  for (int i = 0; i < ai::Config::NB_OF_ROBOTS_BY_TEAM; i++)
-  {
-    const data::Robot& robot = getRobot(i, team);
-    if (robot.isActive())
-    {
-      const rhoban_geometry::Point& robot_position = robot.getMovement().linearPosition(time());
-      double distance = robot_position.getDist(point);
-      if (id == -1 or distance < distance_max)
-      {
-        distance_max = distance;
-        id = i;
-      }
-    }
-  }
-  return id;
+  return query(&data::TickCache::closest_robot, { { (double)team, point.getX(), point.getY() } },
+               [&](double time) { return closestRobot(team, point, time); });
 }
 
 double GameInformations::getRobotDistanceFromAllyGoalCenter(int robot_number, Team team) const
 {
-  double distance = -1;
-  const data::Robot& robot = getRobot(robot_number, team);
-  if (robot.isActive())
-  {
-    const rhoban_geometry::Point& robot_position = robot.getMovement().linearPosition(time());
-    Vector2d goal_center_robot = robot_position - Data::get()->field.goalCenter(Ally);
-    distance = goal_center_robot.norm();
-    distance = (Data::get()->field.field_length - distance) / Data::get()->field.field_length;
-  }
-  return distance;
+  return robotDistanceFromAllyGoalCenter(getRobot(robot_number, team), time());
 }
 
 std::vector<double> GameInformations::threat(Team team) const
 {
-  std::vector<double> v_threat;
-  for (size_t i = 0; i < ai::Config::NB_OF_ROBOTS_BY_TEAM; i++)
-  {
-    double threat = getRobotDistanceFromAllyGoalCenter(i, team);
-    v_threat.push_back(threat);
-  }
-  return v_threat;
+  data::Ranking ranking = threatRanking(team);
+  return std::vector<double>(ranking.value_of_robot, ranking.value_of_robot + ai::Config::NB_OF_ROBOTS_BY_TEAM);
 }
 
-int GameInformations::shirtNumberOfThreatMax(Team team) const
+data::Ranking GameInformations::threatRanking(Team team) const
 {
-  int id = -1;
-  double threat_max = -1;
+  return query(&data::TickCache::threats, { { (double)team } }, [&](double time) {
+    return rankRobots(team, false,
+                      [&](const data::Robot& robot) { return robotDistanceFromAllyGoalCenter(robot, time); });
+  });
+}
 
-  std::vector<double> v_threat = threat(team);
-  for (size_t i = 0; i < v_threat.size(); i++)
-  {
-    double threat = v_threat[i];
-    if (threat > threat_max)
-    {
-      threat_max = threat;
-      id = i;
-    }
-  }
-  return id;
+int GameInformations::shirtNumberOfThreatMax(Team team) const
+{
+  return threatRanking(team).robot(0);
 }
 
 int GameInformations::shirtNumberOfThreatMax2(Team team) const
 {  // second threat max
-  int id_1 = -1;
-  int id_2 = -1;
-  double threat_max = -1;
-  double threat_max_2 = -1;
-
-  std::vector<double> v_threat = threat(team);
-  for (size_t i = 0; i < v_threat.size(); i++)
-  {
-    double threat = v_threat[i];
-    if (threat > threat_max)
-    {
-      threat_max_2 = threat_max;
-      threat_max = threat;
-      id_2 = id_1;
-      id_1 = i;
-    }
-    else if (threat > threat_max_2)
-    {
-      threat_max_2 = threat;
-      id_2 = i;
-    }
-  }
-  return id_2;
+  return threatRanking(team).robot(1);
 }
 
 const data::Ball& GameInformations::ball() const
@@ -20,10 +20,15 @@
 */
 #pragma once
 #include <math/box.h>
+#include <math/pass_evaluator.h>
 #include <data.h>
 
 namespace rhoban_ssl
 {
+/**
+ * The queries about the robots and the ball are computed once per tick when the
+ * data::TickCache is enabled: they are then computed at the time of the tick.
+ */
 class GameInformations
 {
 public:
@@ -238,24 +243,44 @@ public:
    * @see GameInformation::get_robot() to know the difference between robot'id and robot's number).
    */
   int getShirtNumberOfClosestRobotToTheBall(Team team) const;
+  /**
+   * @brief returns the active robots of the team given in parameter sorted
+   * from the closest to the ball to the farthest.
+   * @param team
+   * ( Opponent or Ally)
+   * @return a ranking of robot's shirt numbers, the values are the distances to the ball
+   */
+  data::Ranking closestRobotsToTheBall(Team team) const;
 
   /**************************  Algos INFORMATIONS *************************/
   /**
    * @brief returns the "ideal" position to target that maximazes the chance to score
-   * in the targeted goal given in parameter and its probability to score.
+   * in the opponent goal from the point given in parameter and its probability to score.
    *
-   * The algorithm tests different lines between the point and the goal given
-   * in parameter and returns the leasts covered by robots line.
+   * The robots between the point and the goal hide parts of the goal (see ShotWindows),
+   * the target is the middle of the largest visible part of the goal.
    * @note Attack algorithm
    * @param a point
    * (usually the ball's position)
    * @param a goal
-   * (usually the ennemy's goal center)
+   * (returned when the goal is completely hidden, the ennemy's goal center by default)
+   * @param shooter the shirt number of the ally robot that shoots, it doesn't hide the goal
+   * (-1 when no robot is ignored; any other robot closer than the blocking radius in front of
+   * the point hides the whole goal)
    * @return pair<rhoban_geometry::Point, double>
-   * (double correspond of his "efficiency rate" )
+   * (double correspond of his "efficiency rate": the width of the visible part divided by the goal width)
    */
-  std::pair<rhoban_geometry::Point, double> findGoalBestMove(
-      const rhoban_geometry::Point point, const rhoban_geometry::Point goal = rhoban_geometry::Point(66, 66)) const;
+  std::pair<rhoban_geometry::Point, double>
+  findGoalBestMove(const rhoban_geometry::Point point,
+                   const rhoban_geometry::Point goal = rhoban_geometry::Point(66, 66), int shooter = -1) const;
+  /**
+   * @brief returns the passes from the ball to the given ally robots that the opponents
+   * can't intercept (see PassEvaluator), the safest first.
+   * @note Attack algorithm
+   * @param receivers the shirt numbers of the receivers
+   * @return the safe passes, the receiver of each pass is its shirt number
+   */
+  std::vector<PassOption> findSafePasses(const std::vector<int>& receivers) const;
   /**
    * @brief returns the distance between a robot with the shirt number given in parameter
    * and the ally goal center.
@@ -302,6 +327,15 @@ public:
    * @see GameInformation::get_robot() to know the difference between robot'id and robot's number).
    */
   int shirtNumberOfThreatMax2(Team team) const;  // second threat max
+  /**
+   * @brief returns the active robots of the team given in parameter sorted
+   * from the biggest threat to the smallest.
+   * @note Defense algorithm
+   * @param team
+   * @return a ranking of robot's shirt numbers, the values are the threats
+   * @see threat()
+   */
+  data::Ranking threatRanking(Team team) const;
 };
 
 }  // namespace rhoban_ssl
@@ -18,6 +18,9 @@
 */
 #include <iostream>
 #include <sstream>
+#include <chrono>
+#include <utility>
+#include <vector>
 #include <unistd.h>
 #include <signal.h>
 #include <fenv.h>
@@ -28,6 +31,7 @@
 #include "client_config.h"
 
 #include <executables/tools.h>
+#include <control/control_logger.h>
 
 #define TEAM_NAME "nAMeC"
 #define ZONE_NAME "all"
@@ -62,6 +66,15 @@ int main(int argc, char** argv)
   signal(SIGFPE, superStop);
   atexit((void (*)(void))superStop);
 
+  // Duration of each startup phase, printed before entering the main loop
+  std::vector<std::pair<std::string, double>> startup_phases;
+  std::chrono::steady_clock::time_point phase_start = std::chrono::steady_clock::now();
+  auto endStartupPhase = [&](const std::string& phase) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    startup_phases.push_back(std::make_pair(phase, std::chrono::duration<double>(now - phase_start).count()));
+    phase_start = now;
+  };
+
   // Command line parsing
   TCLAP::CmdLine cmd("Rhoban SSL AI", ' ', "0.0", true);
   TCLAP::SwitchArg simulation("s", "simulation", "Simulation mode", cmd, false);
@@ -162,7 +175,63 @@ int main(int argc, char** argv)
                                   "bool",  // short description of the expected value.
                                   cmd);
 
+  TCLAP::ValueArg<std::string> radio_metrics("",               // no short argument name
+                                              "radio_metrics",  // long argument name
+                                              "Csv file receiving the radio link statistics every second",
+                                              false,     // Flag is not required
+                                              "",        // Default value
+                                              "string",  // short description of the expected value.
+                                              cmd);
+
+  TCLAP::ValueArg<double> control_rate("",              // no short argument name
+                                       "control_rate",  // long argument name
+                                       "Rate (Hz) of the thread sending the commands, 0 to send them with the ai",
+                                       false,     // Flag is not required
+                                       0.0,       // Default value
+                                       "double",  // short description of the expected value.
+                                       cmd);
+
+  TCLAP::ValueArg<std::string> control_log("",             // no short argument name
+                                            "control_log",  // long argument name
+                                            "Csv file receiving the commands and the measured velocities",
+                                            false,     // Flag is not required
+                                            "",        // Default value
+                                            "string",  // short description of the expected value.
+                                            cmd);
+
+  TCLAP::SwitchArg orca("",      // no short argument name
+                        "orca",  // long argument name
+                        "Makes the velocities of all the allied robots collision free together (ORCA)",
+                        cmd,     // command line
+                        false);  // Default value
+
+  TCLAP::ValueArg<int> behavior_threads("",                  // no short argument name
+                                        "behavior_threads",  // long argument name
+                                        "Threads updating the behaviors of the robots concurrently, 0 to update "
+                                        "them one after another",
+                                        false,  // Flag is not required
+                                        0,      // Default value
+                                        "int",  // short description of the expected value.
+                                        cmd);
+
+  TCLAP::ValueArg<double> refinement_budget("",                   // no short argument name
+                                            "refinement_budget",  // long argument name
+                                            "Time (s) given to the anytime refinement of the strategies at each tick",
+                                            false,     // Flag is not required
+                                            0.002,     // Default value
+                                            "double",  // short description of the expected value.
+                                            cmd);
+
+  TCLAP::MultiArg<std::string> prewarm("",         // no short argument name
+                                       "prewarm",  // long argument name
+                                       "Strategy constructed when the manager is set rather than at its first use "
+                                       "(can be repeated, \"all\" for all the strategies)",
+                                       false,     // Flag is not required
+                                       "string",  // short description of the expected value.
+                                       cmd);
+
   cmd.parse(argc, argv);
+  endStartupPhase("command line");
 
   if (em.getValue())
   {
@@ -203,6 +272,12 @@ int main(int argc, char** argv)
   ai::Config::we_are_blue = !yellow.getValue();
   ai::Config::is_in_simulation = simulation.getValue();
   ai::Config::load(config_path.getValue());
+  ai::Config::radio_metrics_file = radio_metrics.getValue();
+  ai::Config::control_rate = control_rate.getValue();
+  ai::Config::orca = orca.getValue();
+  ai::Config::behavior_threads = behavior_threads.getValue();
+  ai::Config::refinement_budget = refinement_budget.getValue();
+  ai::Config::prewarm_strategies = prewarm.getValue();
 
   ExecutionManager::getManager().addTask(new ai::UpdateConfigTask(config_path.getValue()));
 
@@ -210,16 +285,27 @@ int main(int argc, char** argv)
     ai::Config::ntpd_enable = false;
 
   Data::get()->referee.blue_team_on_positive_half = side_blue.getValue();
+  endStartupPhase("config");
 
   addCoreTasks();
   addVisionTasks(addr.getValue(), theport, part_of_the_field_used);
   addRefereeTasks(port_referee.getValue());
+  endStartupPhase("vision and referee");
   addPreBehaviorTreatment();
   addRobotComTasks();
+  if (!control_log.getValue().empty())
+  {
+    // after the limits of the velocities, before the commander
+    ExecutionManager::getManager().addTask(new control::ControlLogger(control_log.getValue()), 2005);
+  }
+
+  endStartupPhase("robot communication");
 
   ai::AI* ai = new ai::AI(manager_name.getValue());
   ExecutionManager::getManager().addTask(ai, 1000);
+  endStartupPhase("ai and managers");
   addViewerTasks(ai, viewer_port.getValue());
+  endStartupPhase("viewer");
 
   // stats
   // ExecutionManager::getManager().addTask(new stats::ResourceUsage(true, false));  // plot every 50 loop
@@ -240,6 +326,16 @@ int main(int argc, char** argv)
                             }));
   }
 
+  double startup_duration = 0;
+  std::cout << "Startup:";
+  for (const std::pair<std::string, double>& phase : startup_phases)
+  {
+    std::cout << " " << phase.first << " " << 1000 * phase.second << " ms,";
+    startup_duration += phase.second;
+  }
+  std::cout << " total " << 1000 * startup_duration << " ms (" << ai->getCurrentManager()->nbConstructedStrategies()
+            << " strategies constructed)" << std::endl;
+
   ExecutionManager::getManager().run(ai::Config::period);
 
   ::google::protobuf::ShutdownProtobufLibrary();
@@ -52,9 +52,9 @@ DumbManager::DumbManager(std::string name)
   halt_strats_[1] = { strategy::Halt::name };
 
   // Register strategy.
-  registerStrategy(strategy::Halt::name, std::shared_ptr<strategy::Strategy>(new strategy::Halt()));
-  registerStrategy(strategy::KeeperStrat::name, std::shared_ptr<strategy::Strategy>(new strategy::KeeperStrat()));
-  registerStrategy(strategy::Wall_2::name, std::shared_ptr<strategy::Strategy>(new strategy::Wall_2()));
+  registerStrategy<strategy::Halt>();
+  registerStrategy<strategy::KeeperStrat>();
+  registerStrategy<strategy::Wall_2>();
 }
 
 void DumbManager::startStop()
@@ -205,18 +205,17 @@ LordOfDarkness::LordOfDarkness(std::string name)
   direct_opponent_strats_[1] = { strategy::KeeperStrat::name };
 
   // Register strategy.
-  registerStrategy(strategy::Halt::name, std::shared_ptr<strategy::Strategy>(new strategy::Halt()));
-  registerStrategy(strategy::KeeperStrat::name, std::shared_ptr<strategy::Strategy>(new strategy::KeeperStrat()));
-  registerStrategy(strategy::Wall_2::name, std::shared_ptr<strategy::Strategy>(new strategy::Wall_2()));
-  registerStrategy(strategy::Wall2Passif::name, std::shared_ptr<strategy::Strategy>(new strategy::Wall2Passif()));
-  registerStrategy(strategy::Wall::name, std::shared_ptr<strategy::Strategy>(new strategy::Wall()));
-  registerStrategy(strategy::Defensive2::name, std::shared_ptr<strategy::Strategy>(new strategy::Defensive2()));
-  registerStrategy(strategy::Defensive::name, std::shared_ptr<strategy::Strategy>(new strategy::Defensive()));
-  registerStrategy(strategy::StrikerV2::name, std::shared_ptr<strategy::Strategy>(new strategy::StrikerV2()));
-  registerStrategy(strategy::Offensive::name, std::shared_ptr<strategy::Strategy>(new strategy::Offensive()));
-  registerStrategy(strategy::StrikerKick::name, std::shared_ptr<strategy::Strategy>(new strategy::StrikerKick()));
-  registerStrategy(strategy::AttaqueWithSupportMs::name,
-                   std::shared_ptr<strategy::Strategy>(new strategy::AttaqueWithSupportMs()));
+  registerStrategy<strategy::Halt>();
+  registerStrategy<strategy::KeeperStrat>();
+  registerStrategy<strategy::Wall_2>();
+  registerStrategy<strategy::Wall2Passif>();
+  registerStrategy<strategy::Wall>();
+  registerStrategy<strategy::Defensive2>();
+  registerStrategy<strategy::Defensive>();
+  registerStrategy<strategy::StrikerV2>();
+  registerStrategy<strategy::Offensive>();
+  registerStrategy<strategy::StrikerKick>();
+  registerStrategy<strategy::AttaqueWithSupportMs>();
 
   registerStrategy("kickoff_ally_placement_M", std::shared_ptr<strategy::Strategy>(new strategy::FromRobotBehavior(
                                                    [&](double time, double dt) {
@@ -292,8 +291,8 @@ LordOfDarkness::LordOfDarkness(std::string name)
                               },
                               true)));
 
-  registerStrategy(strategy::PrepareKickoff::name, std::shared_ptr<strategy::Strategy>(new strategy::PrepareKickoff()));
-  registerStrategy(strategy::MurStop::name, std::shared_ptr<strategy::Strategy>(new strategy::MurStop()));
+  registerStrategy<strategy::PrepareKickoff>();
+  registerStrategy<strategy::MurStop>();
 
   registerStrategy(PROTECT_BALL, std::shared_ptr<strategy::Strategy>(new strategy::FromRobotBehavior(
                                      [&](double time, double dt) {
@@ -45,7 +45,70 @@ const std::vector<int>& Manager::getTeamIds() const
 void Manager::registerStrategy(const std::string& strategy_name, std::shared_ptr<strategy::Strategy> strategy)
 {
   assert(strategies_.find(strategy_name) == strategies_.end());
-  strategies_[strategy_name] = strategy;
+  strategies_[strategy_name].min_robots = strategy->minRobots();
+  strategies_[strategy_name].strategy = strategy;
+}
+
+void Manager::registerStrategy(const std::string& strategy_name, StrategyFactory factory, int min_robots)
+{
+  assert(strategies_.find(strategy_name) == strategies_.end());
+  strategies_[strategy_name].factory = factory;
+  strategies_[strategy_name].min_robots = min_robots;
+}
+
+strategy::Strategy& Manager::constructedStrategy(const std::string& strategy_name) const
+{
+  assert(strategies_.find(strategy_name) != strategies_.end());
+  RegisteredStrategy& registered = strategies_.at(strategy_name);
+  if (!registered.strategy)
+  {
+    registered.strategy = registered.factory();
+    // the number given at the registration must be the one of the strategy
+    assert(registered.min_robots == UNKNOWN_MIN_ROBOTS || registered.min_robots == registered.strategy->minRobots());
+    registered.min_robots = registered.strategy->minRobots();
+  }
+  return *registered.strategy;
+}
+
+int Manager::minRobots(const std::string& strategy_name) const
+{
+  assert(strategies_.find(strategy_name) != strategies_.end());
+  const RegisteredStrategy& registered = strategies_.at(strategy_name);
+  if (registered.min_robots != UNKNOWN_MIN_ROBOTS)
+  {
+    return registered.min_robots;
+  }
+  return constructedStrategy(strategy_name).minRobots();
+}
+
+unsigned int Manager::prewarmStrategies(const std::vector<std::string>& strategy_names)
+{
+  bool all = std::find(strategy_names.begin(), strategy_names.end(), "all") != strategy_names.end();
+  unsigned int nb_constructed = 0;
+  for (auto& entry : strategies_)
+  {
+    if (entry.second.strategy ||
+        (!all && std::find(strategy_names.begin(), strategy_names.end(), entry.first) == strategy_names.end()))
+    {
+      continue;
+    }
+    constructedStrategy(entry.first);
+    nb_constructed++;
+  }
+  return nb_constructed;
+}
+
+unsigned int Manager::nbConstructedStrategies() const
+{
+  unsigned int nb = 0;
+  for (auto& entry : strategies_)
+  {
+    if (entry.second.strategy)
+    {
+      nb++;
+    }
+  }
+  return nb;
 }
 
 void Manager::clearStrategyAssignement()
@@ -94,14 +157,12 @@ void Manager::assignStrategy(const std::string& strategy_name, double time, cons
 
 strategy::Strategy& Manager::getStrategy(const std::string& strategy_name)
 {
-  assert(strategies_.find(strategy_name) != strategies_.end());
-  return *(strategies_.at(strategy_name));
+  return constructedStrategy(strategy_name);
 }
 
 const strategy::Strategy& Manager::getStrategy(const std::string& strategy_name) const
 {
-  assert(strategies_.find(strategy_name) != strategies_.end());
-  return *(strategies_.at(strategy_name));
+  return constructedStrategy(strategy_name);
 }
 
 const std::list<std::string>& Manager::getCurrentStrategyNames() const
@@ -111,10 +172,14 @@ const std::list<std::string>& Manager::getCurrentStrategyNames() const
 
 void Manager::updateStrategies(double time)
 {
-  for (std::pair<std::string, std::shared_ptr<strategy::Strategy> > elem : strategies_)
+  for (auto& entry : strategies_)
   {
-    // REFACTO : TODO Remove the time passed.
-    elem.second->update(time);
+    // a strategy that has never been used has nothing to update
+    if (entry.second.strategy)
+    {
+      // REFACTO : TODO Remove the time passed.
+      entry.second.strategy->update(time);
+    }
   }
 }
 
@@ -127,8 +192,23 @@ void Manager::updateCurrentStrategies()
   }
 }
 
-void Manager::assignBehaviorToRobots(std::map<int, std::shared_ptr<robot_behavior::RobotBehavior> >& robot_behaviors,
-                                     double time, double dt)
+void Manager::refineCurrentStrategies(double time, double budget)
+{
+  refined_strategies_.clear();
+  for (const std::string& name : current_strategy_names_)
+  {
+    refined_strategies_.push_back(&getStrategy(name));
+  }
+  refinement_.run(refined_strategies_.size(),
+                  [&](unsigned int i) { return refined_strategies_[i]->refine(time); }, budget);
+}
+
+const AnytimeScheduler::Stats& Manager::refinementStats() const
+{
+  return refinement_.stats();
+}
+
+void Manager::assignBehaviorToRobots(robot_behavior::RobotBehaviors& robot_behaviors, double time, double dt)
 {
   for (const std::string& name : current_strategy_names_)
   {
@@ -153,6 +233,7 @@ void Manager::assignBehaviorToRobots(std::map<int, std::shared_ptr<robot_behavio
 #endif
           if (id == -1)
             return;
+          assert(id >= 0 && id < static_cast<int>(robot_behaviors.size()));
           robot_behaviors[id] = behavior;
           return;
         },
@@ -162,8 +243,8 @@ void Manager::assignBehaviorToRobots(std::map<int, std::shared_ptr<robot_behavio
 
 Manager::Manager(std::string name) : manager_name_(name), blue_is_not_set_(true)
 {
-  registerStrategy(MANAGER__REMOVE_ROBOTS, std::shared_ptr<strategy::Strategy>(new strategy::Halt()));
-  registerStrategy(MANAGER__PLACER, std::shared_ptr<strategy::Strategy>(new strategy::Placer()));
+  registerStrategy<strategy::Halt>(MANAGER__REMOVE_ROBOTS);
+  registerStrategy<strategy::Placer>(MANAGER__PLACER);
 }
 
 std::string Manager::name()
@@ -350,44 +431,62 @@ void Manager::aggregateAllStartingPositionOfAllStrategies(const std::list<std::s
 
 void Manager::sortRobotOrderedByTheDistanceWithStartingPosition()
 {
-  assert(starting_positions_.size() <= getValidPlayerIds().size());
-  robot_consigns_ = std::vector<std::pair<rhoban_geometry::Point, ContinuousAngle> >(getValidPlayerIds().size());
-  robot_affectations_.resize(getValidPlayerIds().size());
+  const std::vector<int>& player_ids = getValidPlayerIds();
+  assert(starting_positions_.size() <= player_ids.size());
+  robot_consigns_ = std::vector<std::pair<rhoban_geometry::Point, ContinuousAngle> >(player_ids.size());
+  robot_affectations_.resize(player_ids.size());
 
   std::vector<std::pair<rhoban_geometry::Point, ContinuousAngle> > choising_positions =
       list2vector(starting_positions_);
 
-  std::function<double(const int& robot_id, const std::pair<rhoban_geometry::Point, ContinuousAngle>& pos)>
-      robot_ranking = [this](const int& robot_id, const std::pair<rhoban_geometry::Point, ContinuousAngle>& pos) {
-        return Vector2d(pos.first - Data::get()->robots[Ally][robot_id].getMovement().linearPosition(time()))
-            .normSquare();
-      };
-
-  std::function<double(const std::pair<rhoban_geometry::Point, ContinuousAngle>& pos, const int& robot_id)>
-      distance_ranking = [this](const std::pair<rhoban_geometry::Point, ContinuousAngle>& pos, const int& robot_id) {
-        return Vector2d(pos.first - Data::get()->robots[Ally][robot_id].getMovement().linearPosition(time()))
-            .normSquare();
-      };
+  // The sum of the squared distances is minimized, so the paths of the robots to their
+  // positions don't cross each other.
+  assignment_.resize(choising_positions.size(), player_ids.size());
+  for (unsigned int j = 0; j < player_ids.size(); j++)
+  {
+    Vector2d robot_position = Data::get()->robots[Ally][player_ids[j]].getMovement().linearPosition(time());
+    for (unsigned int i = 0; i < choising_positions.size(); i++)
+    {
+      assignment_.cost(i, j) = (Vector2d(choising_positions[i].first) - robot_position).normSquare();
+    }
+  }
 
-  matching::Matchings matchings = matching::galeShapleyAlgorithm(getValidPlayerIds(), choising_positions, robot_ranking,
-                                                                 distance_ranking, false, false);
+  // A robot keeps its previous starting position unless an other assignment is really better
+  std::vector<int> previous_cols(choising_positions.size(), matching::Assignment::UNASSIGNED);
+  for (unsigned int i = 0; i < std::min(choising_positions.size(), previous_robot_of_starting_position_.size()); i++)
+  {
+    std::vector<int>::const_iterator it =
+        std::find(player_ids.begin(), player_ids.end(), previous_robot_of_starting_position_[i]);
+    if (it != player_ids.end())
+    {
+      previous_cols[i] = it - player_ids.begin();
+    }
+  }
+  assignment_.setPreviousAssignment(previous_cols);
+  assignment_.setSwitchingCost(ASSIGNMENT_SWITCHING_COST);
+  const std::vector<int>& col_of_row = assignment_.solve();
 
   std::list<int> not_choosen_robot;
-  for (unsigned int id : matchings.unaffected_man)
+  for (unsigned int j = 0; j < player_ids.size(); j++)
   {
-    not_choosen_robot.push_back(getValidPlayerIds()[id]);
+    if (assignment_.rowOfCol()[j] == matching::Assignment::UNASSIGNED)
+    {
+      not_choosen_robot.push_back(player_ids[j]);
+    }
   }
 
+  previous_robot_of_starting_position_.resize(choising_positions.size());
   for (unsigned int i = 0; i < choising_positions.size(); i++)
   {
     const std::pair<rhoban_geometry::Point, ContinuousAngle>& pos = choising_positions[i];
     robot_consigns_[i] = pos;
-    robot_affectations_[i] = getValidPlayerIds()[matchings.women_to_man_matchings.at(i)];
+    robot_affectations_[i] = player_ids[col_of_row[i]];
+    previous_robot_of_starting_position_[i] = robot_affectations_[i];
   }
 
   // We place the other robot outsde the field.
   std::list<int>::const_iterator it = not_choosen_robot.begin();
-  for (unsigned int i = starting_positions_.size(); i < getValidPlayerIds().size(); i++)
+  for (unsigned int i = starting_positions_.size(); i < player_ids.size(); i++)
   {
     robot_consigns_[i] = std::pair<rhoban_geometry::Point, ContinuousAngle>(
         rhoban_geometry::Point(
@@ -22,10 +22,13 @@
 #include <game_informations.h>
 #include <strategy/strategy.h>
 #include <robot_behavior/robot_behavior.h>
+#include <functional>
 #include <map>
 #include <memory>
 #include <vector>
 #include <annotations/annotations.h>
+#include <math/matching.h>
+#include <core/anytime_scheduler.h>
 
 namespace rhoban_ssl
 {
@@ -34,6 +37,9 @@ namespace manager
 class Manager
 {
 public:
+  typedef std::function<std::shared_ptr<strategy::Strategy>()> StrategyFactory;
+  static constexpr int UNKNOWN_MIN_ROBOTS = -1;
+
   static constexpr const char* MANAGER__REMOVE_ROBOTS = "manager__remove_robots";
   static constexpr const char* MANAGER__PLACER = "manager__placer";
 
@@ -51,7 +57,22 @@ private:
   std::vector<int> invalid_team_ids_;
 
   std::list<std::string> current_strategy_names_;
-  std::map<std::string, std::shared_ptr<strategy::Strategy>> strategies_;
+
+  struct RegisteredStrategy
+  {
+    StrategyFactory factory;
+    // minRobots() of the strategy, UNKNOWN_MIN_ROBOTS when it was not given at the registration
+    int min_robots;
+    // null until the first use of the strategy
+    std::shared_ptr<strategy::Strategy> strategy;
+  };
+  // mutable: the const accessors construct the strategies on demand too
+  mutable std::map<std::string, RegisteredStrategy> strategies_;
+
+  AnytimeScheduler refinement_;
+  std::vector<strategy::Strategy*> refined_strategies_;
+
+  strategy::Strategy& constructedStrategy(const std::string& strategy_name) const;
 
   void affectInvalidRobotsToInvalidRobotsStrategy();
   void detectInvalidRobots();
@@ -96,7 +117,7 @@ public:
   template <typename STRATEGY>
   STRATEGY& getStrategy(const std::string& name)
   {
-    return static_cast<STRATEGY&>(*strategies_.at(name));
+    return static_cast<STRATEGY&>(getStrategy(name));
   };
 
   template <typename STRATEGY>
@@ -109,8 +130,52 @@ public:
   const strategy::Strategy& getStrategy(const std::string& strategy_name) const;
   const std::list<std::string>& getCurrentStrategyNames() const;
 
+  /**
+   * @brief minRobots() of the strategy, without constructing it when the number was given at its registration.
+   */
+  int minRobots(const std::string& strategy_name) const;
+
+  /**
+   * @brief Registers a strategy that is already constructed.
+   */
   void registerStrategy(const std::string& strategy_name, std::shared_ptr<strategy::Strategy> strategy);
 
+  /**
+   * @brief Registers a strategy constructed by the factory at its first use.
+   *
+   * A strategy is used when it is assigned, queried by getStrategy() or prewarmed.
+   * @param min_robots the minRobots() of the strategy, to describe it without constructing it
+   */
+  void registerStrategy(const std::string& strategy_name, StrategyFactory factory,
+                        int min_robots = UNKNOWN_MIN_ROBOTS);
+
+  template <typename STRATEGY>
+  void registerStrategy(const std::string& strategy_name, int min_robots = UNKNOWN_MIN_ROBOTS)
+  {
+    registerStrategy(strategy_name,
+                     StrategyFactory([]() { return std::shared_ptr<strategy::Strategy>(new STRATEGY()); }),
+                     min_robots);
+  };
+
+  template <typename STRATEGY>
+  void registerStrategy(int min_robots = UNKNOWN_MIN_ROBOTS)
+  {
+    registerStrategy<STRATEGY>(STRATEGY::name, min_robots);
+  };
+
+  /**
+   * @brief Constructs the given strategies now, to not construct them during a match.
+   *
+   * The names that are not registered in this manager are ignored, "all" constructs all the strategies.
+   * @return the number of strategies constructed
+   */
+  unsigned int prewarmStrategies(const std::vector<std::string>& strategy_names);
+
+  /**
+   * @brief Number of strategies already constructed.
+   */
+  unsigned int nbConstructedStrategies() const;
+
   void clearStrategyAssignement();
 
   void assignStrategy(const std::string& strategy_name, double time, const std::vector<int>& robot_ids,
@@ -122,8 +187,14 @@ public:
   virtual void updateStrategies(double time);
   virtual void updateCurrentStrategies();
 
-  virtual void assignBehaviorToRobots(std::map<int, std::shared_ptr<robot_behavior::RobotBehavior>>& robot_behaviors,
-                                      double time, double dt);
+  /**
+   * @brief Refines the decisions of the current strategies in the budget (see Strategy::refine()).
+   * @param budget in seconds
+   */
+  void refineCurrentStrategies(double time, double budget);
+  const AnytimeScheduler::Stats& refinementStats() const;
+
+  virtual void assignBehaviorToRobots(robot_behavior::RobotBehaviors& robot_behaviors, double time, double dt);
 
   void removeInvalidRobots();
 
@@ -146,6 +217,11 @@ private:
   ContinuousAngle goalie_angular_position_;
 
   void sortRobotOrderedByTheDistanceWithStartingPosition();
+  // cost (m^2) added to a robot that leaves the starting position it had at the previous placement
+  static constexpr double ASSIGNMENT_SWITCHING_COST = 0.25;
+  // assignment of the starting positions (rows) to the valid players (columns)
+  matching::Assignment assignment_;
+  std::vector<int> previous_robot_of_starting_position_;
   std::vector<int> robot_affectations_;
   // this list is a special orrder of get_valid_player_ids().
   // ths starting_posiitons.size() fisrt robots of robot_affectation
@@ -194,15 +194,22 @@ Manual::Manual(std::string name) : Manager(name)
                                               false  // we don't want to define a goal here !
                                               )));
 
-  registerStrategy("Tutorial - Caterpillar",
-                   std::shared_ptr<strategy::Strategy>(new strategy::Caterpillar(std::vector<rhoban_geometry::Point>{
-                       rhoban_geometry::Point(-3, 3), rhoban_geometry::Point(3, 3), rhoban_geometry::Point(-3, -3),
-                       rhoban_geometry::Point(3, -3) })));
+  registerStrategy("Tutorial - Caterpillar", StrategyFactory([]() {
+                     std::vector<rhoban_geometry::Point> targets{ rhoban_geometry::Point(-3, 3),
+                                                                  rhoban_geometry::Point(3, 3),
+                                                                  rhoban_geometry::Point(-3, -3),
+                                                                  rhoban_geometry::Point(3, -3) };
+                     return std::shared_ptr<strategy::Strategy>(new strategy::Caterpillar(targets));
+                   }),
+                   strategy::Caterpillar::CATERPILLAR_SIZE);
 
-  registerStrategy("go to xy strat",
-                   std::shared_ptr<strategy::Strategy>(new strategy::GoToXYStrat(std::vector<rhoban_geometry::Point>{
-                       rhoban_geometry::Point(-3, 3), rhoban_geometry::Point(3, 3), rhoban_geometry::Point(-3, -3),
-                       rhoban_geometry::Point(3, -3) })));
+  // GoToXYStrat uses one robot by target
+  std::vector<rhoban_geometry::Point> go_to_xy_targets{ rhoban_geometry::Point(-3, 3), rhoban_geometry::Point(3, 3),
+                                                        rhoban_geometry::Point(-3, -3), rhoban_geometry::Point(3, -3) };
+  registerStrategy("go to xy strat", StrategyFactory([go_to_xy_targets]() {
+                     return std::shared_ptr<strategy::Strategy>(new strategy::GoToXYStrat(go_to_xy_targets));
+                   }),
+                   go_to_xy_targets.size());
 
   registerStrategy("Stealer", std::shared_ptr<strategy::Strategy>(new strategy::FromRobotBehavior(
                                   [&](double time, double dt) {
@@ -263,13 +270,13 @@ Manual::Manual(std::string name) : Manager(name)
                                      },
                                      false  // we don't want to define a goal here !
                                      )));
-  registerStrategy("Offensive", std::shared_ptr<strategy::Strategy>(new strategy::Offensive()));
-  registerStrategy("attaque ms", std::shared_ptr<strategy::Strategy>(new strategy::AttaqueWithSupportMs()));
-  registerStrategy("striker kick strat", std::shared_ptr<strategy::Strategy>(new strategy::StrikerKick()));
-  registerStrategy("Mur Stop", std::shared_ptr<strategy::Strategy>(new strategy::MurStop()));
-  registerStrategy("prepare kickoff", std::shared_ptr<strategy::Strategy>(new strategy::PrepareKickoff()));
-  registerStrategy("Defensive", std::shared_ptr<strategy::Strategy>(new strategy::Defensive()));
-  registerStrategy("Striker V2 (strat)", std::shared_ptr<strategy::Strategy>(new strategy::StrikerV2()));
+  registerStrategy<strategy::Offensive>("Offensive", 1);
+  registerStrategy<strategy::AttaqueWithSupportMs>("attaque ms", 2);
+  registerStrategy<strategy::StrikerKick>("striker kick strat", 1);
+  registerStrategy<strategy::MurStop>("Mur Stop", 2);
+  registerStrategy<strategy::PrepareKickoff>("prepare kickoff", 0);
+  registerStrategy<strategy::Defensive>("Defensive", 1);
+  registerStrategy<strategy::StrikerV2>("Striker V2 (strat)", 1);
   registerStrategy("Receiver", std::shared_ptr<strategy::Strategy>(new strategy::FromRobotBehavior(
                                    [&](double time, double dt) {
                                      robot_behavior::attacker::Receiver* receiver =
@@ -279,9 +286,9 @@ Manual::Manual(std::string name) : Manager(name)
                                    false  // we don't want to define a goal here !
                                    )));
 
-  registerStrategy("Wall1", std::shared_ptr<strategy::Strategy>(new strategy::Wall()));
-  registerStrategy("Wall2", std::shared_ptr<strategy::Strategy>(new strategy::Wall_2()));
-  registerStrategy("Pass", std::shared_ptr<strategy::Strategy>(new strategy::Pass()));
+  registerStrategy<strategy::Wall>("Wall1", 1);
+  registerStrategy<strategy::Wall_2>("Wall2", 2);
+  registerStrategy<strategy::Pass>("Pass", 2);
 
   registerStrategy("Obstructor", std::shared_ptr<strategy::Strategy>(new strategy::FromRobotBehavior(
                                      [&](double time, double dt) {
@@ -291,7 +298,7 @@ Manual::Manual(std::string name) : Manager(name)
                                      },
                                      false  // we don't want to define a goal here !
                                      )));
-  registerStrategy("Keeper Strat (need goalie)", std::shared_ptr<strategy::Strategy>(new strategy::KeeperStrat()));
+  registerStrategy<strategy::KeeperStrat>("Keeper Strat (need goalie)", 0);
   registerStrategy("Test - IR", std::shared_ptr<strategy::Strategy>(new strategy::FromRobotBehavior(
                                     [&](double time, double dt) {
                                       robot_behavior::tests::TestInfra* test_ir =
@@ -386,7 +393,7 @@ Manual::Manual(std::string name) : Manager(name)
                                     },
                                     false  // we don't want to define a goal here !
                                     )));
-  registerStrategy("zizou", std::shared_ptr<strategy::Strategy>(new strategy::Zizou()));
+  registerStrategy<strategy::Zizou>("zizou", 1);
   registerStrategy("Search Shoot Area", std::shared_ptr<strategy::Strategy>(new strategy::FromRobotBehavior(
                                             [&](double time, double dt) {
                                               robot_behavior::SearchShootArea* ssa =
@@ -427,8 +434,8 @@ Manual::Manual(std::string name) : Manager(name)
                                        },
                                        false  // we don't want to define a goal here !
                                        )));
-  registerStrategy("Defensive2", std::shared_ptr<strategy::Strategy>(new strategy::Defensive2()));
-  registerStrategy("Wall2Passif", std::shared_ptr<strategy::Strategy>(new strategy::Wall2Passif()));
+  registerStrategy<strategy::Defensive2>("Defensive2", 2);
+  registerStrategy<strategy::Wall2Passif>("Wall2Passif", 2);
 }
 
 void Manual::update()
@@ -24,7 +24,7 @@ namespace manager
 Match::Match(std::string name) : ManagerWithGameState(name)
 {
   // Register strategy.
-  registerStrategy(strategy::Halt::name, std::shared_ptr<strategy::Strategy>(new strategy::Halt()));
+  registerStrategy<strategy::Halt>();
 }
 
 void Match::startStop()
@@ -0,0 +1,199 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "bang_bang.h"
+#include <assert.h>
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+// Number of bisection steps used to synchronize the two axes
+constexpr int NB_SYNCHRONIZATION_STEPS = 30;
+// alpha is kept away from 0 and pi/2 so that no axis gets null limits
+constexpr double MIN_ALPHA = 1e-4;
+}  // namespace
+
+BangBangTrajectory1D::BangBangTrajectory1D() : nb_phases_(0)
+{
+  start_time_[0] = 0.0;
+  position_[0] = 0.0;
+  velocity_[0] = 0.0;
+}
+
+void BangBangTrajectory1D::addPhase(double duration, double acceleration)
+{
+  if (duration <= 0.0)
+  {
+    return;
+  }
+  assert(nb_phases_ < MAX_PHASES);
+  int i = nb_phases_++;
+  acceleration_[i] = acceleration;
+  start_time_[i + 1] = start_time_[i] + duration;
+  velocity_[i + 1] = velocity_[i] + acceleration * duration;
+  position_[i + 1] = position_[i] + (velocity_[i] + 0.5 * acceleration * duration) * duration;
+}
+
+void BangBangTrajectory1D::generate(double initial_position, double initial_velocity, double target,
+                                    double max_velocity, double max_acceleration)
+{
+  assert(max_velocity > 0.0);
+  assert(max_acceleration > 0.0);
+
+  nb_phases_ = 0;
+  start_time_[0] = 0.0;
+  position_[0] = initial_position;
+  velocity_[0] = initial_velocity;
+
+  // The braking phases only happen once each, the loop ends with the final profile.
+  while (true)
+  {
+    double distance = target - position_[nb_phases_];
+    // We work on the absolute distance, v is the velocity towards the target.
+    double direction = (distance > 0.0 || (distance == 0.0 && velocity_[nb_phases_] < 0.0)) ? 1.0 : -1.0;
+    distance = std::fabs(distance);
+    double v = direction * velocity_[nb_phases_];
+
+    if (v < 0.0)
+    {
+      // Moving away from the target: we stop first.
+      addPhase(-v / max_acceleration, direction * max_acceleration);
+      continue;
+    }
+    if (v * v > 2.0 * max_acceleration * distance * (1.0 + 1e-9) && v > 0.0)
+    {
+      // We can't stop before the target: we stop after it and come back.
+      addPhase(v / max_acceleration, -direction * max_acceleration);
+      continue;
+    }
+    if (v > max_velocity)
+    {
+      addPhase((v - max_velocity) / max_acceleration, -direction * max_acceleration);
+      continue;
+    }
+
+    // Trapezoidal profile, or triangular if the cruise velocity is not reached.
+    double peak_velocity = std::sqrt(max_acceleration * distance + 0.5 * v * v);
+    if (peak_velocity > max_velocity)
+    {
+      double cruise_distance = distance - (2.0 * max_velocity * max_velocity - v * v) / (2.0 * max_acceleration);
+      addPhase((max_velocity - v) / max_acceleration, direction * max_acceleration);
+      addPhase(cruise_distance / max_velocity, 0.0);
+      addPhase(max_velocity / max_acceleration, -direction * max_acceleration);
+    }
+    else
+    {
+      addPhase((peak_velocity - v) / max_acceleration, direction * max_acceleration);
+      addPhase(peak_velocity / max_acceleration, -direction * max_acceleration);
+    }
+    break;
+  }
+}
+
+double BangBangTrajectory1D::totalTime() const
+{
+  return start_time_[nb_phases_];
+}
+
+int BangBangTrajectory1D::phaseAt(double t) const
+{
+  int i = 0;
+  while (i < nb_phases_ && t >= start_time_[i + 1])
+  {
+    i++;
+  }
+  return i;
+}
+
+double BangBangTrajectory1D::position(double t) const
+{
+  int i = phaseAt(t);
+  if (i == nb_phases_)
+  {
+    return position_[i];
+  }
+  double dt = t - start_time_[i];
+  return position_[i] + (velocity_[i] + 0.5 * acceleration_[i] * dt) * dt;
+}
+
+double BangBangTrajectory1D::velocity(double t) const
+{
+  int i = phaseAt(t);
+  if (i == nb_phases_)
+  {
+    return 0.0;
+  }
+  return velocity_[i] + acceleration_[i] * (t - start_time_[i]);
+}
+
+double BangBangTrajectory1D::acceleration(double t) const
+{
+  int i = phaseAt(t);
+  if (i == nb_phases_)
+  {
+    return 0.0;
+  }
+  return acceleration_[i];
+}
+
+void BangBangTrajectory2D::generate(const Vector2d& initial_position, const Vector2d& initial_velocity,
+                                    const Vector2d& target, double max_velocity, double max_acceleration)
+{
+  double low = MIN_ALPHA;
+  double high = M_PI / 2.0 - MIN_ALPHA;
+  double alpha = M_PI / 4.0;
+  for (int i = 0; i < NB_SYNCHRONIZATION_STEPS; ++i)
+  {
+    alpha = 0.5 * (low + high);
+    double c = std::cos(alpha);
+    double s = std::sin(alpha);
+    x_.generate(initial_position[0], initial_velocity[0], target[0], max_velocity * c, max_acceleration * c);
+    y_.generate(initial_position[1], initial_velocity[1], target[1], max_velocity * s, max_acceleration * s);
+    // The x axis gets slower when alpha grows, the y axis gets faster.
+    if (x_.totalTime() > y_.totalTime())
+    {
+      high = alpha;
+    }
+    else
+    {
+      low = alpha;
+    }
+  }
+}
+
+double BangBangTrajectory2D::totalTime() const
+{
+  return std::max(x_.totalTime(), y_.totalTime());
+}
+
+Vector2d BangBangTrajectory2D::position(double t) const
+{
+  return Vector2d(x_.position(t), y_.position(t));
+}
+
+Vector2d BangBangTrajectory2D::velocity(double t) const
+{
+  return Vector2d(x_.velocity(t), y_.velocity(t));
+}
+
+Vector2d BangBangTrajectory2D::acceleration(double t) const
+{
+  return Vector2d(x_.acceleration(t), y_.acceleration(t));
+}
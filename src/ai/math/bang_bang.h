@@ -0,0 +1,107 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <math/vector2d.h>
+
+/**
+ * @brief Time-optimal trajectory of a double integrator on one axis.
+ *
+ * The trajectory goes from an initial position and velocity to a target where it stops,
+ * using only the accelerations -max_acceleration, 0 and max_acceleration
+ * and never going faster than max_velocity (except to brake when the initial velocity is above it).
+ *
+ * It is made of at most MAX_PHASES phases of constant acceleration:
+ *  - braking if the robot moves away from the target or can't stop before it,
+ *  - braking down to max_velocity if the robot is too fast,
+ *  - then a trapezoidal (or triangular) velocity profile.
+ */
+class BangBangTrajectory1D
+{
+public:
+  static constexpr int MAX_PHASES = 5;
+
+private:
+  int nb_phases_;
+  // for each phase, its start time, acceleration and the state at its start
+  double start_time_[MAX_PHASES + 1];
+  double acceleration_[MAX_PHASES];
+  double position_[MAX_PHASES + 1];
+  double velocity_[MAX_PHASES + 1];
+
+  void addPhase(double duration, double acceleration);
+  int phaseAt(double t) const;
+
+public:
+  BangBangTrajectory1D();
+
+  /**
+   * @brief Computes the trajectory (in a few hundred nanoseconds, without allocation).
+   * @param initial_position position at t = 0
+   * @param initial_velocity velocity at t = 0
+   * @param target position where the trajectory stops
+   * @param max_velocity velocity limit, it should be greater than 0
+   * @param max_acceleration acceleration limit, it should be greater than 0
+   */
+  void generate(double initial_position, double initial_velocity, double target, double max_velocity,
+                double max_acceleration);
+
+  /**
+   * @brief Duration of the trajectory, the target is reached at this time.
+   */
+  double totalTime() const;
+
+  double position(double t) const;
+  double velocity(double t) const;
+  double acceleration(double t) const;
+};
+
+/**
+ * @brief Time-optimal trajectory of a robot in the plane.
+ *
+ * The velocity and acceleration limits are shared by the two axes:
+ * the x axis uses max * cos(alpha) and the y axis max * sin(alpha).
+ * alpha is found by bisection so that both axes reach the target at the same time,
+ * This keeps the norm of the acceleration under its limit. The norm of the velocity is kept under its limit
+ * as soon as the velocity of each axis is under its share (an axis that starts faster brakes down to it).
+ */
+class BangBangTrajectory2D
+{
+private:
+  BangBangTrajectory1D x_;
+  BangBangTrajectory1D y_;
+
+public:
+  /**
+   * @brief Computes the trajectory.
+   * @param initial_position position at t = 0
+   * @param initial_velocity velocity at t = 0
+   * @param target position where the trajectory stops
+   * @param max_velocity limit of the norm of the velocity
+   * @param max_acceleration limit of the norm of the acceleration
+   */
+  void generate(const Vector2d& initial_position, const Vector2d& initial_velocity, const Vector2d& target,
+                double max_velocity, double max_acceleration);
+
+  double totalTime() const;
+
+  Vector2d position(double t) const;
+  Vector2d velocity(double t) const;
+  Vector2d acceleration(double t) const;
+};
@@ -20,6 +20,8 @@
 #include <assert.h>
 #include "curve.h"
 #include <debug.h>
+#include <algorithm>
+#include <cmath>
 
 DifferentiableVelocityConsign::DifferentiableVelocityConsign(double distance, double max_velocity,
                                                              double max_acceleration)
@@ -105,30 +107,78 @@ double ContinuousVelocityConsign::time_of_acceleration()
 
 void Curve2d::init()
 {
+  if (constant_speed)
+  {
+    return;
+  }
+  assert(step_curve_parameter > 0.0);
+  length_table.clear();
+  length_table.reserve(static_cast<size_t>(1.0 / step_curve_parameter) + 2);
+  length_table.push_back(0.0);
+  Vector2d old = curve(0.0);
+  for (size_t i = 1; tableParameter(i - 1) < 1.0; ++i)
+  {
+    Vector2d current = curve(tableParameter(i));
+    length_table.push_back(length_table.back() + norm_2(current - old));
+    old = current;
+  }
   if (curve_length < 0)
   {
-    this->curve_length = lengthIterator().next(1.0);
+    this->curve_length = length_table.back();
   }
 }
 
+double Curve2d::tableParameter(size_t i) const
+{
+  return std::min(1.0, i * step_curve_parameter);
+}
+
 Curve2d::Curve2d(const std::function<Vector2d(double u)>& curve, double step_curve_parameter)
-  : curve(curve), step_curve_parameter(step_curve_parameter), curve_length(-1.0)
+  : curve(curve), step_curve_parameter(step_curve_parameter), curve_length(-1.0), constant_speed(false)
 {
   init();
 };
 
 Curve2d::Curve2d(const std::function<Vector2d(double u)>& curve, double step_curve_parameter, double curve_length)
-  : curve(curve), step_curve_parameter(step_curve_parameter), curve_length(curve_length)
+  : curve(curve), step_curve_parameter(step_curve_parameter), curve_length(curve_length), constant_speed(false)
 {
   init();
 };
 
+Curve2d::Curve2d(const std::function<Vector2d(double u)>& curve, double curve_length, ConstantSpeed)
+  : curve(curve), step_curve_parameter(1.0), curve_length(curve_length), constant_speed(true)
+{
+}
+
 Curve2d::Curve2d(const Curve2d& curve)
-  : curve(curve.curve), step_curve_parameter(curve.step_curve_parameter), curve_length(curve.curve_length)
+  : curve(curve.curve)
+  , step_curve_parameter(curve.step_curve_parameter)
+  , curve_length(curve.curve_length)
+  , length_table(curve.length_table)
+  , constant_speed(curve.constant_speed)
 {
-  init();
 };
 
+Curve2d Curve2d::constantSpeedCurve(const std::function<Vector2d(double u)>& curve, double curve_length)
+{
+  return Curve2d(curve, curve_length, ConstantSpeed());
+}
+
+Curve2d Curve2d::segment(const Vector2d& start, const Vector2d& end)
+{
+  return constantSpeedCurve([start, end](double u) { return start + u * (end - start); }, norm_2(end - start));
+}
+
+Curve2d Curve2d::arc(const Vector2d& center, double radius, double start_angle, double end_angle)
+{
+  return constantSpeedCurve(
+      [center, radius, start_angle, end_angle](double u) {
+        double angle = start_angle + u * (end_angle - start_angle);
+        return center + radius * Vector2d(std::cos(angle), std::sin(angle));
+      },
+      std::fabs(radius * (end_angle - start_angle)));
+}
+
 Vector2d Curve2d::operator()(double u) const
 {
   return this->curve(u);
@@ -141,12 +191,36 @@ double Curve2d::size() const
 
 double Curve2d::arcLength(double u) const
 {
-  return Length(*this)(u);
+  if (u <= 0)
+    return 0.0;
+  if (u >= 1.0)
+    return curve_length;
+  if (constant_speed)
+    return u * curve_length;
+
+  size_t i = std::min(static_cast<size_t>(u / step_curve_parameter), length_table.size() - 2);
+  double u0 = tableParameter(i);
+  double u1 = tableParameter(i + 1);
+  return length_table[i] + (length_table[i + 1] - length_table[i]) * (u - u0) / (u1 - u0);
 }
 
 double Curve2d::inverseOfArcLength(double l) const
 {
-  return InverseOfLength(*this)(l);
+  if (l <= 0)
+    return 0.0;
+  if (l >= curve_length)
+    return 1.0;
+  if (constant_speed)
+    return l / curve_length;
+
+  // First entry strictly greater than l: the table is non decreasing, so l is in [i-1, i].
+  size_t i = std::upper_bound(length_table.begin(), length_table.end(), l) - length_table.begin();
+  if (i == length_table.size())
+    return 1.0;
+  double l0 = length_table[i - 1];
+  double l1 = length_table[i];
+  double u0 = tableParameter(i - 1);
+  return u0 + (tableParameter(i) - u0) * (l - l0) / (l1 - l0);
 }
 
 void RenormalizedCurve::init()
@@ -60,66 +60,53 @@ public:
   double step_curve_parameter;
   double curve_length;
 
+  // Arc length at u = i * step_curve_parameter, the last entry is the arc length at u = 1.
+  // It is built once at construction and is empty when the curve has a constant speed.
+  std::vector<double> length_table;
+  // The arc length is proportional to u (segments, arcs...)
+  bool constant_speed;
+
   void init();
 
+private:
+  struct ConstantSpeed
+  {
+  };
+  Curve2d(const std::function<Vector2d(double u)>& curve, double curve_length, ConstantSpeed);
+
+  double tableParameter(size_t i) const;
+
 public:
   struct Length
   {
     const Curve2d& _this;
-    double v;
-    double length;
-    Vector2d old;
 
-    Length(const Curve2d& _this) : _this(_this), v(0), length(0), old(_this.curve(0.0))
+    Length(const Curve2d& _this) : _this(_this)
     {
     }
 
     double next(double u)
     {
-      assert(v <= u);
-      for (; v <= u; v += _this.step_curve_parameter)
-      {
-        Vector2d current = _this.curve(v);
-        length += norm_2(current - old);
-        old = current;
-      }
-      return length + norm_2(_this.curve(u) - old);
+      return _this.arcLength(u);
     }
 
     double operator()(double u)
     {
-      if (u <= 0)
-        return 0.0;
-      if (u >= 1.0)
-        return _this.curve_length;
-      return next(u);
+      return _this.arcLength(u);
     }
   };
 
   struct InverseOfLength
   {
     const Curve2d& _this;
-    double u;
-    double length;
-    Vector2d old;
 
-    InverseOfLength(const Curve2d& _this) : _this(_this), u(0), length(0), old(_this.curve(0.0))
+    InverseOfLength(const Curve2d& _this) : _this(_this)
     {
     }
 
     double operator()(double l)
     {
-      if (l <= 0)
-        return 0.0;
-      if (l >= _this.curve_length)
-        return 1.0;
-      for (; length < l; u += _this.step_curve_parameter)
-      {
-        Vector2d current = _this.curve(u);
-        length += norm_2(current - old);
-        old = current;
-      }
-      return u;
+      return _this.inverseOfArcLength(l);
     }
   };
 
@@ -128,14 +115,27 @@ public:
   Curve2d(const std::function<Vector2d(double u)>& curve, double step_curve_parameter, double curve_length);
   Curve2d(const Curve2d& curve);
 
+  /**
+   * @brief A curve whose arc length is proportional to its parameter: no table is built.
+   */
+  static Curve2d constantSpeedCurve(const std::function<Vector2d(double u)>& curve, double curve_length);
+  static Curve2d segment(const Vector2d& start, const Vector2d& end);
+  static Curve2d arc(const Vector2d& center, double radius, double start_angle, double end_angle);
+
   Vector2d operator()(double u) const;
 
+  /**
+   * @brief Arc length from 0 to u, interpolated in the table (O(1)).
+   */
   double arcLength(double u) const;
   Length lengthIterator() const
   {
     return Length(*this);
   }
 
+  /**
+   * @brief Parameter u where the arc length is l, found by binary search in the table (O(log n)).
+   */
   double inverseOfArcLength(double l) const;
   InverseOfLength InverseOfLengthIterator() const
   {
@@ -0,0 +1,254 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "matching.h"
+#include <cassert>
+
+namespace rhoban_ssl
+{
+namespace matching
+{
+constexpr int Assignment::UNASSIGNED;
+
+Assignment::Assignment() : nb_rows_(0), nb_cols_(0), switching_cost_(0.0)
+{
+}
+
+void Assignment::resize(unsigned int nb_rows, unsigned int nb_cols)
+{
+  assert(nb_rows <= nb_cols);
+  if (nb_rows == nb_rows_ && nb_cols == nb_cols_)
+  {
+    return;
+  }
+  nb_rows_ = nb_rows;
+  nb_cols_ = nb_cols;
+  costs_.resize(nb_rows * nb_cols);
+  reset();
+}
+
+unsigned int Assignment::nbRows() const
+{
+  return nb_rows_;
+}
+
+unsigned int Assignment::nbCols() const
+{
+  return nb_cols_;
+}
+
+double& Assignment::cost(unsigned int row, unsigned int col)
+{
+  return costs_[row * nb_cols_ + col];
+}
+
+double Assignment::cost(unsigned int row, unsigned int col) const
+{
+  return costs_[row * nb_cols_ + col];
+}
+
+void Assignment::setSwitchingCost(double switching_cost)
+{
+  switching_cost_ = switching_cost;
+}
+
+void Assignment::setPreviousAssignment(const std::vector<int>& col_of_row)
+{
+  assert(col_of_row.size() == nb_rows_);
+  std::copy(col_of_row.begin(), col_of_row.end(), previous_col_of_row_.begin());
+}
+
+void Assignment::reset()
+{
+  // The problem is made square with rows of null costs, so every column is assigned and
+  // any potentials of the columns can be reused by the next call.
+  previous_col_of_row_.assign(nb_cols_, UNASSIGNED);
+  // The potentials and the matching are indexed from 1, the column 0 is the root of the searches
+  u_.assign(nb_cols_ + 1, 0.0);
+  v_.assign(nb_cols_ + 1, 0.0);
+  matched_row_.assign(nb_cols_ + 1, 0);
+  matched_col_.assign(nb_cols_ + 1, 0);
+  col_of_row_.assign(nb_rows_, UNASSIGNED);
+  row_of_col_.assign(nb_cols_, UNASSIGNED);
+}
+
+void Assignment::computeSwitchedCosts()
+{
+  switched_costs_.resize(nb_cols_ * nb_cols_);
+  std::fill(switched_costs_.begin() + nb_rows_ * nb_cols_, switched_costs_.end(), 0.0);
+  for (unsigned int row = 0; row < nb_rows_; ++row)
+  {
+    const double* costs = &costs_[row * nb_cols_];
+    double* switched_costs = &switched_costs_[row * nb_cols_];
+    int previous = previous_col_of_row_[row];
+    for (unsigned int col = 0; col < nb_cols_; ++col)
+    {
+      switched_costs[col] = costs[col] + ((previous != UNASSIGNED && previous != (int)col) ? switching_cost_ : 0.0);
+    }
+  }
+}
+
+void Assignment::warmStart()
+{
+  // The pairs of the previous assignment are candidates, a column can only be kept once
+  std::fill(matched_row_.begin(), matched_row_.end(), 0);
+  for (unsigned int i = 1; i <= nb_cols_; ++i)
+  {
+    int col = previous_col_of_row_[i - 1];
+    matched_col_[i] = 0;
+    if (col != UNASSIGNED && col < (int)nb_cols_ && matched_row_[col + 1] == 0)
+    {
+      matched_col_[i] = col + 1;
+      matched_row_[col + 1] = i;
+    }
+  }
+
+  // The potentials of the rows are the largest that keep the reduced costs (cost - u - v) positive,
+  // the candidates whose reduced cost is not null are searched again.
+  for (unsigned int i = 1; i <= nb_cols_; ++i)
+  {
+    const double* costs = &switched_costs_[(i - 1) * nb_cols_];
+    double min = std::numeric_limits<double>::infinity();
+    for (unsigned int j = 1; j <= nb_cols_; ++j)
+    {
+      min = std::min(min, costs[j - 1] - v_[j]);
+    }
+    u_[i] = min;
+    unsigned int j = matched_col_[i];
+    if (j != 0 && costs[j - 1] - v_[j] > min)
+    {
+      matched_col_[i] = 0;
+      matched_row_[j] = 0;
+    }
+  }
+}
+
+void Assignment::augment(unsigned int row)
+{
+  // Shortest augmenting path from row in the reduced costs (Dijkstra)
+  min_reduced_cost_.assign(nb_cols_ + 1, std::numeric_limits<double>::infinity());
+  way_.assign(nb_cols_ + 1, 0);
+  visited_.assign(nb_cols_ + 1, false);
+
+  matched_row_[0] = row;
+  unsigned int j0 = 0;
+  do
+  {
+    visited_[j0] = true;
+    unsigned int i0 = matched_row_[j0];
+    const double* costs = &switched_costs_[(i0 - 1) * nb_cols_];
+    double delta = std::numeric_limits<double>::infinity();
+    unsigned int j1 = 0;
+    for (unsigned int j = 1; j <= nb_cols_; ++j)
+    {
+      if (!visited_[j])
+      {
+        double reduced_cost = costs[j - 1] - u_[i0] - v_[j];
+        if (reduced_cost < min_reduced_cost_[j])
+        {
+          min_reduced_cost_[j] = reduced_cost;
+          way_[j] = j0;
+        }
+        if (min_reduced_cost_[j] < delta)
+        {
+          delta = min_reduced_cost_[j];
+          j1 = j;
+        }
+      }
+    }
+    for (unsigned int j = 0; j <= nb_cols_; ++j)
+    {
+      if (visited_[j])
+      {
+        u_[matched_row_[j]] += delta;
+        v_[j] -= delta;
+      }
+      else
+      {
+        min_reduced_cost_[j] -= delta;
+      }
+    }
+    j0 = j1;
+  } while (matched_row_[j0] != 0);
+
+  // Flips the pairs along the path
+  do
+  {
+    unsigned int j1 = way_[j0];
+    matched_row_[j0] = matched_row_[j1];
+    j0 = j1;
+  } while (j0 != 0);
+}
+
+const std::vector<int>& Assignment::solve()
+{
+  computeSwitchedCosts();
+  warmStart();
+
+  for (unsigned int i = 1; i <= nb_cols_; ++i)
+  {
+    if (matched_col_[i] == 0)
+    {
+      augment(i);
+    }
+  }
+
+  for (unsigned int j = 1; j <= nb_cols_; ++j)
+  {
+    unsigned int i = matched_row_[j];
+    matched_col_[i] = j;
+    previous_col_of_row_[i - 1] = j - 1;
+    if (i <= nb_rows_)
+    {
+      col_of_row_[i - 1] = j - 1;
+      row_of_col_[j - 1] = i - 1;
+    }
+    else
+    {
+      row_of_col_[j - 1] = UNASSIGNED;
+    }
+  }
+  return col_of_row_;
+}
+
+const std::vector<int>& Assignment::colOfRow() const
+{
+  return col_of_row_;
+}
+
+const std::vector<int>& Assignment::rowOfCol() const
+{
+  return row_of_col_;
+}
+
+double Assignment::totalCost() const
+{
+  double total = 0.0;
+  for (unsigned int row = 0; row < nb_rows_; ++row)
+  {
+    if (col_of_row_[row] != UNASSIGNED)
+    {
+      total += cost(row, col_of_row_[row]);
+    }
+  }
+  return total;
+}
+
+}  // namespace matching
+}  // namespace rhoban_ssl
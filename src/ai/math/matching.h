@@ -25,6 +25,7 @@
 #include <functional>
 #include <map>
 #include <list>
+#include <limits>
 
 #include <debug.h>
 #include <core/print_collection.h>
@@ -150,5 +151,100 @@ Matchings galeShapleyAlgorithm(const std::vector<MAN>& man_set, const std::vecto
   return result;
 }
 
+/**
+ * @brief Minimum total cost assignment of rows to columns (Hungarian algorithm with potentials,
+ * O(rows^2 * columns)).
+ *
+ * Each row is assigned to a different column, so there must be at least as many columns as rows.
+ * The costs are stored in a flat row major matrix that is reused from one call to another.
+ *
+ * To avoid that the assignment changes at each call when two choices are close, a switching cost
+ * is added to every pair that was not in the previous assignment (see setPreviousAssignment()).
+ * The potentials of the previous call and the pairs of the previous assignment that are still
+ * optimal for them are kept (warm start), so only the rows whose choice changes are searched again.
+ */
+class Assignment
+{
+private:
+  unsigned int nb_rows_;
+  unsigned int nb_cols_;
+  std::vector<double> costs_;
+  double switching_cost_;
+  // previous column of each row, followed by the rows added to make the problem square
+  std::vector<int> previous_col_of_row_;
+  // costs with the switching costs, nb_cols x nb_cols
+  std::vector<double> switched_costs_;
+
+  // potentials of the rows and of the columns (cost - u - v >= 0, = 0 for the assigned pairs)
+  std::vector<double> u_;
+  std::vector<double> v_;
+  // row (from 1, 0 if none) assigned to each column (from 1, the column 0 is the root of the searches)
+  std::vector<unsigned int> matched_row_;
+  std::vector<unsigned int> matched_col_;
+  std::vector<int> col_of_row_;
+  std::vector<int> row_of_col_;
+
+  std::vector<double> min_reduced_cost_;
+  std::vector<int> way_;
+  std::vector<char> visited_;
+
+  void computeSwitchedCosts();
+  void warmStart();
+  void augment(unsigned int row);
+
+public:
+  static constexpr int UNASSIGNED = -1;
+
+  Assignment();
+
+  /**
+   * @brief Sets the size of the cost matrix (nb_rows <= nb_cols), the costs are not initialized.
+   *
+   * If the size changes, the previous assignment and the potentials are forgotten.
+   */
+  void resize(unsigned int nb_rows, unsigned int nb_cols);
+
+  unsigned int nbRows() const;
+  unsigned int nbCols() const;
+
+  double& cost(unsigned int row, unsigned int col);
+  double cost(unsigned int row, unsigned int col) const;
+
+  /**
+   * @brief Cost added to each pair that is not in the previous assignment (0 by default).
+   */
+  void setSwitchingCost(double switching_cost);
+
+  /**
+   * @brief Declares the column previously assigned to each row (UNASSIGNED if there is none).
+   *
+   * By default, the previous assignment is the result of the last call to solve().
+   */
+  void setPreviousAssignment(const std::vector<int>& col_of_row);
+
+  /**
+   * @brief Forgets the previous assignment and the potentials (the next solve() starts from scratch).
+   */
+  void reset();
+
+  /**
+   * @brief Computes the assignment that minimizes the sum of the costs and of the switching costs.
+   * @return the column assigned to each row
+   */
+  const std::vector<int>& solve();
+
+  const std::vector<int>& colOfRow() const;
+
+  /**
+   * @brief The row assigned to each column (UNASSIGNED for the columns left over).
+   */
+  const std::vector<int>& rowOfCol() const;
+
+  /**
+   * @brief Sum of the costs of the assigned pairs (without the switching costs).
+   */
+  double totalCost() const;
+};
+
 };  // namespace matching
 };  // namespace rhoban_ssl
@@ -0,0 +1,224 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pass_evaluator.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+PassEvaluator::Parameters::Parameters()
+  : ball_deceleration(0.5)
+  , opponent_acceleration(3.0)
+  , opponent_max_speed(2.5)
+  , reaction_time(0.1)
+  , interception_radius(0.11)
+  , time_step(0.02)
+  , max_time(3.0)
+  , kick_speeds({ 1.5, 2.0, 2.5, 3.0, 4.0, 5.0, 6.0 })
+{
+}
+
+bool PassEvaluator::Parameters::operator==(const Parameters& other) const
+{
+  return ball_deceleration == other.ball_deceleration && opponent_acceleration == other.opponent_acceleration &&
+         opponent_max_speed == other.opponent_max_speed && reaction_time == other.reaction_time &&
+         interception_radius == other.interception_radius && time_step == other.time_step &&
+         max_time == other.max_time && kick_speeds == other.kick_speeds;
+}
+
+PassEvaluator::PassEvaluator(const Parameters& parameters) : parameters_(parameters)
+{
+  computeTables();
+}
+
+void PassEvaluator::setParameters(const Parameters& parameters)
+{
+  if (!(parameters == parameters_))
+  {
+    parameters_ = parameters;
+    computeTables();
+  }
+}
+
+void PassEvaluator::computeTables()
+{
+  assert(parameters_.time_step > 0.0);
+  nb_steps_ = int(std::ceil(parameters_.max_time / parameters_.time_step)) + 1;
+
+  const double acceleration = parameters_.opponent_acceleration;
+  const double max_speed = parameters_.opponent_max_speed;
+  const double deceleration = parameters_.ball_deceleration;
+
+  // Distance between the opponent and its position at constant velocity: the acceleration moves it
+  // by at most acceleration * tau^2 / 2, and its velocity can't change by more than 2 * max_speed.
+  reach_.resize(nb_steps_);
+  for (int k = 0; k < nb_steps_; ++k)
+  {
+    double tau = std::max(0.0, k * parameters_.time_step - parameters_.reaction_time);
+    double distance = std::min(acceleration * tau * tau / 2.0, 2.0 * max_speed * tau);
+    reach_[k] = distance + parameters_.interception_radius;
+  }
+
+  travel_.resize(parameters_.kick_speeds.size() * nb_steps_);
+  for (unsigned int s = 0; s < parameters_.kick_speeds.size(); ++s)
+  {
+    double speed = parameters_.kick_speeds[s];
+    double t_stop = deceleration > 0.0 ? speed / deceleration : std::numeric_limits<double>::infinity();
+    for (int k = 0; k < nb_steps_; ++k)
+    {
+      double t = std::min(k * parameters_.time_step, t_stop);
+      travel_[s * nb_steps_ + k] = speed * t - deceleration * t * t / 2.0;
+    }
+  }
+}
+
+void PassEvaluator::setBall(const Vector2d& position)
+{
+  ball_ = position;
+}
+
+void PassEvaluator::clearReceivers()
+{
+  receivers_.clear();
+}
+
+void PassEvaluator::addReceiver(const Vector2d& position)
+{
+  receivers_.push_back(position);
+}
+
+void PassEvaluator::clearOpponents()
+{
+  opponents_.clear();
+  opponent_velocities_.clear();
+}
+
+void PassEvaluator::addOpponent(const Vector2d& position, const Vector2d& velocity)
+{
+  opponents_.push_back(position);
+  opponent_velocities_.push_back(velocity);
+}
+
+double PassEvaluator::clearance(int speed, int nb_steps) const
+{
+  const double* travel = travel_.data() + speed * nb_steps_;
+  const double* reach = reach_.data();
+  const double dt = parameters_.time_step;
+
+  double result = std::numeric_limits<double>::infinity();
+  for (unsigned int o = 0; o < along_.size(); ++o)
+  {
+    const double along = along_[o];
+    const double across = across_[o];
+    const double velocity_along = velocity_along_[o];
+    const double velocity_across = velocity_across_[o];
+    double gap = std::numeric_limits<double>::infinity();
+    for (int k = 0; k < nb_steps; ++k)
+    {
+      // the center of the disc keeps the velocity of the opponent
+      double t = k * dt;
+      double dx = travel[k] - along - velocity_along * t;
+      double dy = across + velocity_across * t;
+      double g = std::sqrt(dx * dx + dy * dy) - reach[k];
+      gap = g < gap ? g : gap;
+    }
+    result = std::min(result, gap);
+    if (result <= 0.0)
+    {
+      break;
+    }
+  }
+  return result;
+}
+
+const std::vector<PassOption>& PassEvaluator::evaluate()
+{
+  passes_.clear();
+  const double deceleration = parameters_.ball_deceleration;
+
+  for (unsigned int r = 0; r < receivers_.size(); ++r)
+  {
+    Vector2d line = receivers_[r] - ball_;
+    double distance = line.norm();
+    if (distance == 0.0)
+    {
+      continue;
+    }
+    Vector2d direction = line / distance;
+
+    along_.resize(opponents_.size());
+    across_.resize(opponents_.size());
+    velocity_along_.resize(opponents_.size());
+    velocity_across_.resize(opponents_.size());
+    for (unsigned int o = 0; o < opponents_.size(); ++o)
+    {
+      Vector2d relative = opponents_[o] - ball_;
+      Vector2d velocity = opponent_velocities_[o];
+      double opponent_speed = velocity.norm();
+      if (opponent_speed > parameters_.opponent_max_speed)
+      {
+        velocity = velocity * (parameters_.opponent_max_speed / opponent_speed);
+      }
+      along_[o] = scalarProduct(relative, direction);
+      across_[o] = vectorialProduct(direction, relative);
+      velocity_along_[o] = scalarProduct(velocity, direction);
+      velocity_across_[o] = vectorialProduct(direction, velocity);
+    }
+
+    for (unsigned int s = 0; s < parameters_.kick_speeds.size(); ++s)
+    {
+      double speed = parameters_.kick_speeds[s];
+      double arrival_time;
+      double arrival_speed;
+      if (deceleration > 0.0)
+      {
+        double square = speed * speed - 2.0 * deceleration * distance;
+        if (square < 0.0)
+        {
+          // the ball stops before the receiver
+          continue;
+        }
+        arrival_speed = std::sqrt(square);
+        arrival_time = (speed - arrival_speed) / deceleration;
+      }
+      else
+      {
+        arrival_speed = speed;
+        arrival_time = distance / speed;
+      }
+      int nb_steps = int(std::ceil(arrival_time / parameters_.time_step)) + 1;
+      if (nb_steps > nb_steps_)
+      {
+        continue;
+      }
+
+      double c = clearance(s, nb_steps);
+      if (c > 0.0)
+      {
+        passes_.push_back(PassOption{ int(r), speed, arrival_time, arrival_speed, c });
+      }
+    }
+  }
+
+  std::sort(passes_.begin(), passes_.end(), [](const PassOption& a, const PassOption& b) {
+    return a.clearance > b.clearance || (a.clearance == b.clearance && a.arrival_time < b.arrival_time);
+  });
+  return passes_;
+}
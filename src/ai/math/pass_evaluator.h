@@ -0,0 +1,114 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <math/vector2d.h>
+#include <vector>
+
+/**
+ * @brief A pass to a receiver at a kick speed that no opponent can intercept.
+ */
+struct PassOption
+{
+  // index of the receiver in the order of PassEvaluator::addReceiver()
+  int receiver;
+  double kick_speed;
+  // when and how fast the ball reaches the receiver
+  double arrival_time;
+  double arrival_speed;
+  // smallest distance between the ball and the positions the opponents can reach in time
+  double clearance;
+};
+
+/**
+ * @brief Finds the passes from the ball to the receivers that the opponents can't intercept.
+ *
+ * The ball goes straight to the receiver and slows down with a constant deceleration. At time t,
+ * an opponent can be anywhere in a disc: its center is where the opponent would be if it kept its
+ * current velocity (capped to opponent_max_speed), and with tau = t - reaction_time its radius is
+ * min(acceleration * tau^2 / 2, 2 * opponent_max_speed * tau) plus the interception radius. Whatever
+ * the opponent does with its acceleration and speed limits, it stays in the disc: the passes found
+ * are safe. The pass is intercepted if the ball enters one of these discs before reaching the receiver.
+ *
+ * The reachable radius and the distance travelled by the ball at each kick speed are tabulated
+ * once at each time step: evaluate() only compares them, in the frame of each pass line.
+ */
+class PassEvaluator
+{
+public:
+  struct Parameters
+  {
+    double ball_deceleration;
+    double opponent_acceleration;
+    double opponent_max_speed;
+    double reaction_time;
+    double interception_radius;
+    double time_step;
+    double max_time;
+    std::vector<double> kick_speeds;
+
+    Parameters();
+    bool operator==(const Parameters& other) const;
+  };
+
+private:
+  Parameters parameters_;
+  int nb_steps_;
+  // reach_[k]: radius of the disc of an opponent at time k * time_step
+  std::vector<double> reach_;
+  // travel_[s * nb_steps_ + k]: distance covered by the ball kicked at kick_speeds[s] at time k * time_step
+  std::vector<double> travel_;
+
+  Vector2d ball_;
+  std::vector<Vector2d> receivers_;
+  std::vector<Vector2d> opponents_;
+  std::vector<Vector2d> opponent_velocities_;
+  std::vector<PassOption> passes_;
+
+  // opponents in the frame of the current pass line
+  std::vector<double> along_;
+  std::vector<double> across_;
+  std::vector<double> velocity_along_;
+  std::vector<double> velocity_across_;
+
+  double clearance(int speed, int nb_steps) const;
+  void computeTables();
+
+public:
+  PassEvaluator(const Parameters& parameters = Parameters());
+
+  /**
+   * @brief Changes the parameters, the tables are computed again only if they differ from the current ones.
+   */
+  void setParameters(const Parameters& parameters);
+
+  void setBall(const Vector2d& position);
+  void clearReceivers();
+  void addReceiver(const Vector2d& position);
+  void clearOpponents();
+  void addOpponent(const Vector2d& position, const Vector2d& velocity);
+
+  /**
+   * @brief The safe passes, the largest clearance first (the shortest arrival time if they are equal).
+   *
+   * The kick speeds with which the ball stops before the receiver (or reaches it after max_time) are skipped.
+   */
+  const std::vector<PassOption>& evaluate();
+};
@@ -0,0 +1,197 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "shot_window.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+const double INFINITE = std::numeric_limits<double>::infinity();
+
+/*
+ * Shadow [min, max] on the goal line of the obstacle (ox, oy) seen from (px, py), empty if min > max.
+ *
+ * The tangents from the shooter to the obstacle are the vector d = o - p rotated by the
+ * angle asin(r / |d|): h * d -/+ r * perp(d), with h = sqrt(|d|^2 - r^2).
+ * An obstacle in front of the shooting position and closer than r to it hides the whole line.
+ * It has no branch, so the loop of ShotWindows::evaluate() over the shooters can be vectorized.
+ */
+inline void shadow(double px, double py, double ox, double oy, double r, double goal_x, double& min, double& max)
+{
+  double dx = ox - px;
+  double dy = oy - py;
+  double h2 = dx * dx + dy * dy - r * r;
+  double h = std::sqrt(h2 > 0.0 ? h2 : 0.0);
+  double lower_x = h * dx + r * dy;
+  double lower_y = h * dy - r * dx;
+  double upper_x = h * dx - r * dy;
+  double upper_y = h * dy + r * dx;
+  double length = goal_x - px;
+  // a tangent that doesn't go towards the goal line hides everything on its side
+  double lower = lower_x > 0.0 ? py + length * lower_y / lower_x : -INFINITE;
+  double upper = upper_x > 0.0 ? py + length * upper_y / upper_x : INFINITE;
+  bool hides = dx > 0.0 && ox < goal_x + r;
+  bool touches = h2 <= 0.0;
+  min = hides ? (touches ? -INFINITE : lower) : INFINITE;
+  max = hides ? (touches ? INFINITE : upper) : -INFINITE;
+}
+}  // namespace
+
+ShotWindows::ShotWindows(double goal_x, double goal_width, double obstacle_radius)
+  : goal_x_(goal_x), goal_width_(goal_width), obstacle_radius_(obstacle_radius), nb_shadows_(0)
+{
+}
+
+void ShotWindows::clearObstacles()
+{
+  obstacles_x_.clear();
+  obstacles_y_.clear();
+}
+
+void ShotWindows::addObstacle(const Vector2d& position)
+{
+  obstacles_x_.push_back(position.getX());
+  obstacles_y_.push_back(position.getY());
+}
+
+void ShotWindows::addShadow(double min, double max)
+{
+  // the empty shadows and the ones outside of the goal don't change the windows
+  if (min <= max && max > -goal_width_ / 2.0 && min < goal_width_ / 2.0)
+  {
+    shadows_[nb_shadows_++] = std::pair<double, double>(min, max);
+  }
+}
+
+ShotWindow ShotWindows::largestWindow(double shooter_x)
+{
+  double goal_min = -goal_width_ / 2.0;
+  double goal_max = goal_width_ / 2.0;
+
+  ShotWindow window;
+  window.open = false;
+  window.y_min = 0.0;
+  window.y_max = 0.0;
+  window.target = rhoban_geometry::Point(goal_x_, 0.0);
+  window.probability = 0.0;
+  if (shooter_x >= goal_x_)
+  {
+    return window;
+  }
+
+  // There are only a few shadows: insertion sort
+  for (unsigned int i = 1; i < nb_shadows_; ++i)
+  {
+    std::pair<double, double> shadow = shadows_[i];
+    unsigned int j = i;
+    for (; j > 0 && shadows_[j - 1].first > shadow.first; --j)
+    {
+      shadows_[j] = shadows_[j - 1];
+    }
+    shadows_[j] = shadow;
+  }
+
+  double free_from = goal_min;
+  double best_width = 0.0;
+  for (unsigned int i = 0; i < nb_shadows_; ++i)
+  {
+    const std::pair<double, double>& shadow = shadows_[i];
+    if (shadow.first >= goal_max)
+    {
+      break;
+    }
+    if (shadow.first - free_from > best_width)
+    {
+      best_width = shadow.first - free_from;
+      window.y_min = free_from;
+      window.y_max = shadow.first;
+    }
+    free_from = std::max(free_from, shadow.second);
+  }
+  if (goal_max - free_from > best_width)
+  {
+    best_width = goal_max - free_from;
+    window.y_min = free_from;
+    window.y_max = goal_max;
+  }
+
+  if (best_width > 0.0)
+  {
+    window.open = true;
+    window.target = rhoban_geometry::Point(goal_x_, (window.y_min + window.y_max) / 2.0);
+    window.probability = best_width / goal_width_;
+  }
+  return window;
+}
+
+ShotWindow ShotWindows::evaluate(const Vector2d& shooter)
+{
+  shadows_.resize(obstacles_x_.size());
+  nb_shadows_ = 0;
+  for (unsigned int i = 0; i < obstacles_x_.size(); ++i)
+  {
+    double min, max;
+    shadow(shooter.getX(), shooter.getY(), obstacles_x_[i], obstacles_y_[i], obstacle_radius_, goal_x_, min, max);
+    addShadow(min, max);
+  }
+  return largestWindow(shooter.getX());
+}
+
+void ShotWindows::evaluate(const std::vector<Vector2d>& shooters, std::vector<ShotWindow>& windows)
+{
+  const unsigned int nb_shooters = shooters.size();
+  const unsigned int nb_obstacles = obstacles_x_.size();
+  shooters_x_.resize(nb_shooters);
+  shooters_y_.resize(nb_shooters);
+  for (unsigned int s = 0; s < nb_shooters; ++s)
+  {
+    shooters_x_[s] = shooters[s].getX();
+    shooters_y_[s] = shooters[s].getY();
+  }
+
+  shadow_min_.resize(nb_obstacles * nb_shooters);
+  shadow_max_.resize(nb_obstacles * nb_shooters);
+  const double* xs = shooters_x_.data();
+  const double* ys = shooters_y_.data();
+  for (unsigned int i = 0; i < nb_obstacles; ++i)
+  {
+    double* mins = shadow_min_.data() + i * nb_shooters;
+    double* maxs = shadow_max_.data() + i * nb_shooters;
+    double ox = obstacles_x_[i];
+    double oy = obstacles_y_[i];
+    for (unsigned int s = 0; s < nb_shooters; ++s)
+    {
+      shadow(xs[s], ys[s], ox, oy, obstacle_radius_, goal_x_, mins[s], maxs[s]);
+    }
+  }
+
+  windows.resize(nb_shooters);
+  shadows_.resize(nb_obstacles);
+  for (unsigned int s = 0; s < nb_shooters; ++s)
+  {
+    nb_shadows_ = 0;
+    for (unsigned int i = 0; i < nb_obstacles; ++i)
+    {
+      addShadow(shadow_min_[i * nb_shooters + s], shadow_max_[i * nb_shooters + s]);
+    }
+    windows[s] = largestWindow(xs[s]);
+  }
+}
@@ -0,0 +1,91 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <math/vector2d.h>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Largest part of a goal mouth that a shot reaches without passing near an obstacle.
+ */
+struct ShotWindow
+{
+  bool open;
+  // ends of the window on the goal line
+  double y_min;
+  double y_max;
+  // middle of the window, on the goal line
+  rhoban_geometry::Point target;
+  // width of the window divided by the width of the goal
+  double probability;
+};
+
+/**
+ * @brief Computes the shot windows on a goal line (x = goal_x, y in [-goal_width/2, goal_width/2]).
+ *
+ * Seen from the shooting position, each obstacle hides an angular interval: the shots
+ * passing closer than obstacle_radius to its center. The interval is projected on the goal
+ * line with the two tangents to the obstacle (no trigonometry), the shadows are sorted and
+ * the largest gap between them is the window.
+ *
+ * Only the obstacles between the shooting position and the goal line are taken into
+ * account. An obstacle in front of the shooting position and closer than obstacle_radius to
+ * it closes the whole goal: the shooter itself must not be added as an obstacle.
+ *
+ * evaluate() with several shooting positions computes the shadows of one obstacle for all
+ * the positions at once, in plain loops over arrays that the compiler vectorizes.
+ */
+class ShotWindows
+{
+private:
+  double goal_x_;
+  double goal_width_;
+  double obstacle_radius_;
+  std::vector<double> obstacles_x_;
+  std::vector<double> obstacles_y_;
+
+  // batch evaluation, shadow_min_[obstacle * nb_shooters + shooter]
+  std::vector<double> shooters_x_;
+  std::vector<double> shooters_y_;
+  std::vector<double> shadow_min_;
+  std::vector<double> shadow_max_;
+  std::vector<std::pair<double, double>> shadows_;
+  unsigned int nb_shadows_;
+
+  void addShadow(double min, double max);
+  ShotWindow largestWindow(double shooter_x);
+
+public:
+  ShotWindows(double goal_x, double goal_width, double obstacle_radius);
+
+  void clearObstacles();
+  void addObstacle(const Vector2d& position);
+
+  /**
+   * @brief The window seen from one shooting position.
+   */
+  ShotWindow evaluate(const Vector2d& shooter);
+
+  /**
+   * @brief The windows seen from several shooting positions.
+   */
+  void evaluate(const std::vector<Vector2d>& shooters, std::vector<ShotWindow>& windows);
+};
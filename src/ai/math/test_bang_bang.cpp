@@ -0,0 +1,137 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <debug.h>
+#include "bang_bang.h"
+#include <cmath>
+
+namespace
+{
+// Checks the limits and the continuity of the position and of the velocity along a trajectory
+void checkTrajectory(const BangBangTrajectory1D& trajectory, double initial_velocity, double target,
+                     double max_velocity, double max_acceleration)
+{
+  double dt = 1e-4;
+  double vmax = std::max(max_velocity, std::fabs(initial_velocity));
+  for (double t = 0; t < trajectory.totalTime() + 0.1; t += dt)
+  {
+    EXPECT_LE(std::fabs(trajectory.velocity(t)), vmax + 1e-9);
+    EXPECT_LE(std::fabs(trajectory.acceleration(t)), max_acceleration + 1e-9);
+    EXPECT_NEAR(trajectory.position(t + dt) - trajectory.position(t), trajectory.velocity(t + dt / 2) * dt, 1e-6);
+    EXPECT_NEAR(trajectory.velocity(t + dt) - trajectory.velocity(t), trajectory.acceleration(t) * dt,
+                2 * max_acceleration * dt + 1e-9);
+  }
+  EXPECT_NEAR(trajectory.position(trajectory.totalTime()), target, 1e-9);
+  EXPECT_NEAR(trajectory.velocity(trajectory.totalTime()), 0.0, 1e-9);
+}
+}  // namespace
+
+TEST(test_bang_bang, rest_to_rest)
+{
+  BangBangTrajectory1D trajectory;
+
+  // Trapezoid: 1s to reach 2m/s, 1m each, then 2m at 2m/s
+  trajectory.generate(0.0, 0.0, 4.0, 2.0, 2.0);
+  EXPECT_NEAR(trajectory.totalTime(), 3.0, 1e-9);
+  EXPECT_NEAR(trajectory.position(1.0), 1.0, 1e-9);
+  EXPECT_NEAR(trajectory.velocity(1.5), 2.0, 1e-9);
+  checkTrajectory(trajectory, 0.0, 4.0, 2.0, 2.0);
+
+  // Triangle: the peak velocity is 1m/s
+  trajectory.generate(1.0, 0.0, 0.5, 2.0, 2.0);
+  EXPECT_NEAR(trajectory.totalTime(), 1.0, 1e-9);
+  EXPECT_NEAR(trajectory.velocity(0.5), -1.0, 1e-9);
+  checkTrajectory(trajectory, 0.0, 0.5, 2.0, 2.0);
+
+  trajectory.generate(1.0, 0.0, 1.0, 2.0, 2.0);
+  EXPECT_EQ(trajectory.totalTime(), 0.0);
+  EXPECT_EQ(trajectory.position(1.0), 1.0);
+}
+
+TEST(test_bang_bang, initial_velocity)
+{
+  BangBangTrajectory1D trajectory;
+
+  // Moving towards the target: no need to accelerate from 0
+  trajectory.generate(0.0, 2.0, 4.0, 2.0, 2.0);
+  EXPECT_NEAR(trajectory.totalTime(), 2.5, 1e-9);
+  checkTrajectory(trajectory, 2.0, 4.0, 2.0, 2.0);
+
+  // Moving away from the target
+  trajectory.generate(0.0, -1.0, 1.0, 2.0, 2.0);
+  EXPECT_NEAR(trajectory.acceleration(0.0), 2.0, 1e-9);
+  checkTrajectory(trajectory, -1.0, 1.0, 2.0, 2.0);
+
+  // Too fast to stop before the target: overshoot and come back
+  trajectory.generate(0.0, 2.0, 0.5, 2.0, 2.0);
+  EXPECT_GT(trajectory.position(1.0), 0.5);
+  checkTrajectory(trajectory, 2.0, 0.5, 2.0, 2.0);
+
+  // Faster than the velocity limit
+  trajectory.generate(0.0, 3.0, 10.0, 2.0, 2.0);
+  EXPECT_NEAR(trajectory.velocity(0.5), 2.0, 1e-9);
+  checkTrajectory(trajectory, 3.0, 10.0, 2.0, 2.0);
+
+  // Stopping on the target
+  trajectory.generate(0.0, 2.0, 1.0, 2.0, 2.0);
+  EXPECT_NEAR(trajectory.totalTime(), 1.0, 1e-6);
+  checkTrajectory(trajectory, 2.0, 1.0, 2.0, 2.0);
+}
+
+TEST(test_bang_bang, trajectory_2d)
+{
+  BangBangTrajectory2D trajectory;
+  double max_velocity = 2.0;
+  double max_acceleration = 3.0;
+
+  Vector2d starts[] = { Vector2d(0.0, 0.0), Vector2d(-3.0, 1.0), Vector2d(2.0, 2.0) };
+  Vector2d velocities[] = { Vector2d(0.0, 0.0), Vector2d(1.5, -1.0), Vector2d(0.0, -1.0) };
+  Vector2d targets[] = { Vector2d(3.0, 1.0), Vector2d(0.0, 0.0), Vector2d(2.0, 0.0) };
+
+  for (int i = 0; i < 3; ++i)
+  {
+    trajectory.generate(starts[i], velocities[i], targets[i], max_velocity, max_acceleration);
+    double total_time = trajectory.totalTime();
+    EXPECT_GT(total_time, 0.0);
+    EXPECT_NEAR((trajectory.position(total_time) - targets[i]).norm(), 0.0, 1e-6);
+    EXPECT_NEAR((trajectory.position(0.0) - starts[i]).norm(), 0.0, 1e-9);
+    for (double t = 0; t < total_time; t += 0.001)
+    {
+      if (velocities[i].norm() == 0.0)
+      {
+        EXPECT_LE(trajectory.velocity(t).norm(), max_velocity + 1e-6);
+      }
+      EXPECT_LE(trajectory.acceleration(t).norm(), max_acceleration + 1e-6);
+    }
+  }
+
+  // A straight line at rest is as fast as the 1D trajectory
+  BangBangTrajectory1D straight;
+  straight.generate(0.0, 0.0, 4.0, 2.0, 2.0);
+  trajectory.generate(Vector2d(0.0, 0.0), Vector2d(0.0, 0.0), Vector2d(4.0, 0.0), 2.0, 2.0);
+  EXPECT_NEAR(trajectory.totalTime(), straight.totalTime(), 1e-3);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -285,6 +285,50 @@ TEST(test_curve, use_cases)
   }
 }
 
+TEST(test_curve, arc_length_table)
+{
+  {
+    // Length from 0 to u of (u^2, 2u) is u*sqrt(u^2+1) + arcsinh(u)
+    double step = 0.0001;
+    Curve2d curve([](double u) { return Vector2d(u * u, 2 * u); }, step);
+    for (double u = 0.0; u <= 1.0; u += 0.0137)
+    {
+      double length = u * std::sqrt(u * u + 1) + std::asinh(u);
+      EXPECT_TRUE(eq(length, curve.arcLength(u), 1e-6));
+      EXPECT_TRUE(eq(u, curve.inverseOfArcLength(length), 1e-6));
+    }
+    EXPECT_TRUE(eq(std::sqrt(2) + std::asinh(1), curve.size(), 1e-6));
+    EXPECT_TRUE(curve.inverseOfArcLength(-1.0) == 0.0);
+    EXPECT_TRUE(curve.inverseOfArcLength(curve.size() + 1.0) == 1.0);
+
+    // A step that doesn't divide 1
+    Curve2d coarse([](double u) { return Vector2d(u * u, 2 * u); }, 0.3);
+    EXPECT_TRUE(eq(coarse.arcLength(1.0 - 1e-9), coarse.size(), 1e-6));
+    EXPECT_TRUE(eq(coarse.inverseOfArcLength(coarse.arcLength(0.95)), 0.95, 1e-9));
+  }
+
+  {
+    Curve2d segment = Curve2d::segment(Vector2d(1.0, 1.0), Vector2d(4.0, 5.0));
+    EXPECT_TRUE(segment.length_table.empty());
+    EXPECT_TRUE(eq(5.0, segment.size(), 1e-12));
+    EXPECT_TRUE(eq(2.0, segment.arcLength(0.4), 1e-12));
+    EXPECT_TRUE(eq(0.4, segment.inverseOfArcLength(2.0), 1e-12));
+    EXPECT_TRUE(eq(0.0, norm_2(segment(0.4) - Vector2d(2.2, 2.6)), 1e-12));
+
+    Curve2d arc = Curve2d::arc(Vector2d(0.0, 0.0), 2.0, 0.0, -M_PI / 2);
+    EXPECT_TRUE(eq(M_PI, arc.size(), 1e-12));
+    EXPECT_TRUE(eq(M_PI / 2, arc.arcLength(0.5), 1e-12));
+    EXPECT_TRUE(eq(0.0, norm_2(arc(1.0) - Vector2d(0.0, -2.0)), 1e-12));
+
+    // The table gives the same results
+    Curve2d table_arc(arc.curve, 0.0001);
+    for (double u = 0.0; u <= 1.0; u += 0.1)
+    {
+      EXPECT_TRUE(eq(arc.arcLength(u), table_arc.arcLength(u), 1e-6));
+    }
+  }
+}
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
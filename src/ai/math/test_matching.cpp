@@ -25,6 +25,7 @@
 #include <iostream>
 #include <core/collection.h>
 #include <cmath>
+#include <random>
 
 using namespace rhoban_ssl;
 
@@ -149,6 +150,119 @@ TEST(test_matching, gale_shapley_algorithm__use_cases_with_double)
   }
 }
 
+// Minimum cost of the assignment, by trying every choice of columns
+double bruteForceAssignment(const matching::Assignment& assignment, unsigned int row, std::vector<bool>& used)
+{
+  if (row == assignment.nbRows())
+  {
+    return 0.0;
+  }
+  double best = std::numeric_limits<double>::infinity();
+  for (unsigned int col = 0; col < assignment.nbCols(); col++)
+  {
+    if (!used[col])
+    {
+      used[col] = true;
+      best = std::min(best, assignment.cost(row, col) + bruteForceAssignment(assignment, row + 1, used));
+      used[col] = false;
+    }
+  }
+  return best;
+}
+
+TEST(test_matching, assignment__minimum_cost)
+{
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> costs(0.0, 10.0);
+  for (unsigned int nb_rows = 0; nb_rows <= 6; nb_rows++)
+  {
+    for (unsigned int nb_cols = nb_rows; nb_cols <= 7; nb_cols++)
+    {
+      matching::Assignment assignment;
+      assignment.resize(nb_rows, nb_cols);
+      for (unsigned int row = 0; row < nb_rows; row++)
+      {
+        for (unsigned int col = 0; col < nb_cols; col++)
+        {
+          assignment.cost(row, col) = costs(generator);
+        }
+      }
+      const std::vector<int>& col_of_row = assignment.solve();
+
+      std::set<int> cols(col_of_row.begin(), col_of_row.end());
+      EXPECT_EQ(cols.size(), nb_rows);
+      EXPECT_EQ(cols.count(matching::Assignment::UNASSIGNED), 0);
+      for (unsigned int row = 0; row < nb_rows; row++)
+      {
+        EXPECT_EQ(assignment.rowOfCol()[col_of_row[row]], (int)row);
+      }
+      std::vector<bool> used(nb_cols, false);
+      EXPECT_NEAR(assignment.totalCost(), bruteForceAssignment(assignment, 0, used), 1e-9);
+    }
+  }
+}
+
+TEST(test_matching, assignment__warm_start)
+{
+  std::mt19937 generator(1);
+  std::uniform_real_distribution<double> costs(0.0, 10.0);
+  std::uniform_real_distribution<double> noise(-1.0, 1.0);
+  matching::Assignment warm;
+  warm.resize(6, 8);
+  for (unsigned int row = 0; row < 6; row++)
+  {
+    for (unsigned int col = 0; col < 8; col++)
+    {
+      warm.cost(row, col) = costs(generator);
+    }
+  }
+  warm.solve();
+  // The costs change a little between two calls, the warm start must still find the optimum
+  for (int i = 0; i < 20; i++)
+  {
+    for (unsigned int row = 0; row < 6; row++)
+    {
+      for (unsigned int col = 0; col < 8; col++)
+      {
+        warm.cost(row, col) = std::max(0.0, warm.cost(row, col) + noise(generator));
+      }
+    }
+    warm.solve();
+    std::vector<bool> used(8, false);
+    EXPECT_NEAR(warm.totalCost(), bruteForceAssignment(warm, 0, used), 1e-9);
+  }
+}
+
+TEST(test_matching, assignment__switching_cost)
+{
+  matching::Assignment assignment;
+  assignment.resize(2, 2);
+  assignment.setSwitchingCost(1.0);
+  assignment.cost(0, 0) = 1.0;
+  assignment.cost(0, 1) = 2.0;
+  assignment.cost(1, 0) = 2.0;
+  assignment.cost(1, 1) = 1.0;
+  EXPECT_EQ(assignment.solve(), (std::vector<int>({ 0, 1 })));
+
+  // The other assignment is better by 0.5, less than the two switching costs
+  assignment.cost(0, 0) = 2.0;
+  assignment.cost(0, 1) = 1.75;
+  assignment.cost(1, 0) = 1.75;
+  assignment.cost(1, 1) = 2.0;
+  EXPECT_EQ(assignment.solve(), (std::vector<int>({ 0, 1 })));
+
+  // Now it is better by 3
+  assignment.cost(0, 1) = 0.5;
+  assignment.cost(1, 0) = 0.5;
+  EXPECT_EQ(assignment.solve(), (std::vector<int>({ 1, 0 })));
+
+  // Without switching cost, the assignment only depends on the costs
+  assignment.setSwitchingCost(0.0);
+  assignment.cost(0, 0) = 0.0;
+  assignment.cost(1, 1) = 0.0;
+  EXPECT_EQ(assignment.solve(), (std::vector<int>({ 0, 1 })));
+}
+
 int main(int argc, char** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
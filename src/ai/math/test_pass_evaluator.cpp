@@ -0,0 +1,192 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include "pass_evaluator.h"
+#include <cmath>
+
+TEST(test_pass_evaluator, without_opponents)
+{
+  PassEvaluator::Parameters parameters;
+  parameters.kick_speeds = { 1.0, 4.0 };
+  PassEvaluator evaluator(parameters);
+  evaluator.setBall(Vector2d(0.0, 0.0));
+  evaluator.addReceiver(Vector2d(3.0, 0.0));
+
+  // at 1 m/s, the ball stops after 1 m
+  const std::vector<PassOption>& passes = evaluator.evaluate();
+  ASSERT_EQ(passes.size(), 1);
+  EXPECT_EQ(passes[0].receiver, 0);
+  EXPECT_EQ(passes[0].kick_speed, 4.0);
+  double arrival_speed = std::sqrt(16.0 - 2.0 * parameters.ball_deceleration * 3.0);
+  EXPECT_NEAR(passes[0].arrival_speed, arrival_speed, 1e-9);
+  EXPECT_NEAR(passes[0].arrival_time, (4.0 - arrival_speed) / parameters.ball_deceleration, 1e-9);
+}
+
+TEST(test_pass_evaluator, interceptions)
+{
+  PassEvaluator evaluator;
+  evaluator.setBall(Vector2d(0.0, 0.0));
+  evaluator.addReceiver(Vector2d(4.0, 0.0));
+  evaluator.addReceiver(Vector2d(0.0, 4.0));
+
+  // an opponent on the first line
+  evaluator.addOpponent(Vector2d(2.0, 0.05), Vector2d(0.0, 0.0));
+  std::vector<PassOption> passes = evaluator.evaluate();
+  ASSERT_FALSE(passes.empty());
+  for (const PassOption& pass : passes)
+  {
+    EXPECT_EQ(pass.receiver, 1);
+  }
+  // the fastest pass leaves less time to the opponent
+  EXPECT_EQ(passes[0].kick_speed, 6.0);
+
+  // an opponent near the second line but too far to intercept a fast pass
+  evaluator.clearOpponents();
+  evaluator.addOpponent(Vector2d(0.8, 2.0), Vector2d(0.0, 0.0));
+  passes = evaluator.evaluate();
+  bool fast = false;
+  bool slow = false;
+  for (const PassOption& pass : passes)
+  {
+    fast = fast || (pass.receiver == 1 && pass.kick_speed == 6.0);
+    slow = slow || (pass.receiver == 1 && pass.kick_speed == 2.0);
+  }
+  EXPECT_TRUE(fast);
+  EXPECT_FALSE(slow);
+
+  // the same opponent running towards the line intercepts the fast pass too
+  evaluator.clearOpponents();
+  evaluator.addOpponent(Vector2d(0.8, 2.0), Vector2d(-2.0, 0.0));
+  passes = evaluator.evaluate();
+  for (const PassOption& pass : passes)
+  {
+    EXPECT_EQ(pass.receiver, 0);
+  }
+}
+
+TEST(test_pass_evaluator, coasting_opponent)
+{
+  PassEvaluator::Parameters parameters;
+  PassEvaluator evaluator(parameters);
+  evaluator.setBall(Vector2d(0.0, 0.0));
+  evaluator.addReceiver(Vector2d(4.0, 0.0));
+
+  // opponents that keep their velocity and cross the pass line must not touch the ball of a safe pass
+  for (double y = 0.1; y <= 1.5; y += 0.1)
+  {
+    for (double vy = 0.25; vy <= 2.5; vy += 0.25)
+    {
+      Vector2d opponent(2.0, y);
+      Vector2d velocity(0.0, -vy);
+      evaluator.clearOpponents();
+      evaluator.addOpponent(opponent, velocity);
+      for (const PassOption& pass : evaluator.evaluate())
+      {
+        for (double t = 0.0; t <= pass.arrival_time; t += 0.001)
+        {
+          Vector2d ball(pass.kick_speed * t - parameters.ball_deceleration * t * t / 2.0, 0.0);
+          EXPECT_GT((ball - (opponent + velocity * t)).norm(), parameters.interception_radius)
+              << "y " << y << ", vy " << vy << ", kick speed " << pass.kick_speed << ", t " << t;
+        }
+      }
+    }
+  }
+}
+
+TEST(test_pass_evaluator, set_parameters)
+{
+  PassEvaluator evaluator;
+  evaluator.setBall(Vector2d(0.0, 0.0));
+  evaluator.addReceiver(Vector2d(2.0, 0.0));
+  evaluator.addOpponent(Vector2d(1.0, 0.8), Vector2d(0.0, 0.0));
+  std::vector<PassOption> passes = evaluator.evaluate();
+  EXPECT_FALSE(passes.empty());
+
+  // with a larger interception radius, the opponent intercepts all the passes
+  PassEvaluator::Parameters parameters;
+  parameters.interception_radius = 1.0;
+  evaluator.setParameters(parameters);
+  EXPECT_TRUE(evaluator.evaluate().empty());
+
+  evaluator.setParameters(PassEvaluator::Parameters());
+  passes = evaluator.evaluate();
+  EXPECT_FALSE(passes.empty());
+}
+
+TEST(test_pass_evaluator, against_sampling)
+{
+  PassEvaluator::Parameters parameters;
+  PassEvaluator evaluator(parameters);
+  evaluator.setBall(Vector2d(-1.0, 0.5));
+  Vector2d receiver(2.0, -1.0);
+  evaluator.addReceiver(receiver);
+  Vector2d opponent(0.5, 0.5);
+  Vector2d velocity(0.3, -0.8);
+  evaluator.addOpponent(opponent, velocity);
+  const std::vector<PassOption>& passes = evaluator.evaluate();
+
+  for (double speed : parameters.kick_speeds)
+  {
+    // samples the trajectory finely
+    Vector2d line = receiver - Vector2d(-1.0, 0.5);
+    double distance = line.norm();
+    double square = speed * speed - 2.0 * parameters.ball_deceleration * distance;
+    if (square < 0.0)
+    {
+      continue;
+    }
+    double arrival_time = (speed - std::sqrt(square)) / parameters.ball_deceleration;
+    double clearance = 1e9;
+    for (double t = 0.0; t <= arrival_time; t += 0.0001)
+    {
+      Vector2d ball = Vector2d(-1.0, 0.5) + line / distance * (speed * t - parameters.ball_deceleration * t * t / 2.0);
+      double tau = std::max(0.0, t - parameters.reaction_time);
+      double reach = std::min(parameters.opponent_acceleration * tau * tau / 2.0,
+                              2.0 * parameters.opponent_max_speed * tau);
+      Vector2d center = opponent + velocity * t;
+      clearance = std::min(clearance, (ball - center).norm() - reach - parameters.interception_radius);
+    }
+    bool found = false;
+    for (const PassOption& pass : passes)
+    {
+      if (pass.kick_speed == speed)
+      {
+        found = true;
+        EXPECT_NEAR(pass.clearance, clearance, 0.05);
+      }
+    }
+    // the time steps are coarser: only check the clear cases
+    if (clearance > 0.05)
+    {
+      EXPECT_TRUE(found);
+    }
+    if (clearance < -0.05)
+    {
+      EXPECT_FALSE(found);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,147 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include "shot_window.h"
+#include <cmath>
+#include <random>
+
+namespace
+{
+const double GOAL_X = 4.5;
+const double GOAL_WIDTH = 1.0;
+const double RADIUS = 0.15;
+
+// Largest free part of the goal line, by sampling the shots
+double sampledWidth(const Vector2d& shooter, const std::vector<Vector2d>& obstacles, int nb_samples)
+{
+  double best = 0.0;
+  double run = 0.0;
+  double step = GOAL_WIDTH / nb_samples;
+  for (int i = 0; i < nb_samples; i++)
+  {
+    Vector2d target(GOAL_X, -GOAL_WIDTH / 2.0 + (i + 0.5) * step);
+    Vector2d u = (target - shooter) / (target - shooter).norm();
+    bool free = true;
+    for (const Vector2d& obstacle : obstacles)
+    {
+      Vector2d d = obstacle - shooter;
+      bool considered = d.getX() > 0 && obstacle.getX() < GOAL_X + RADIUS;
+      if (considered && std::fabs(vectorialProduct(u, d)) <= RADIUS)
+      {
+        free = false;
+      }
+    }
+    run = free ? run + step : 0.0;
+    best = std::max(best, run);
+  }
+  return best;
+}
+}  // namespace
+
+TEST(test_shot_window, empty_goal)
+{
+  ShotWindows shot_windows(GOAL_X, GOAL_WIDTH, RADIUS);
+  ShotWindow window = shot_windows.evaluate(Vector2d(0.0, 1.0));
+  EXPECT_TRUE(window.open);
+  EXPECT_DOUBLE_EQ(window.probability, 1.0);
+  EXPECT_DOUBLE_EQ(window.target.getX(), GOAL_X);
+  EXPECT_DOUBLE_EQ(window.target.getY(), 0.0);
+
+  // behind the goal line
+  EXPECT_FALSE(shot_windows.evaluate(Vector2d(5.0, 0.0)).open);
+}
+
+TEST(test_shot_window, obstacles)
+{
+  ShotWindows shot_windows(GOAL_X, GOAL_WIDTH, RADIUS);
+  // the keeper on the left part of the goal, the robot behind the shooting position is ignored
+  shot_windows.addObstacle(Vector2d(4.3, 0.2));
+  shot_windows.addObstacle(Vector2d(-1.0, 0.0));
+  ShotWindow window = shot_windows.evaluate(Vector2d(0.0, 0.0));
+  EXPECT_TRUE(window.open);
+  EXPECT_DOUBLE_EQ(window.y_min, -GOAL_WIDTH / 2.0);
+  // the shadow of the keeper is scaled on the goal line
+  EXPECT_NEAR(window.y_max, (0.2 - RADIUS) * 4.5 / 4.3, 0.001);
+
+  // a wall in front of the goal
+  for (double y = -0.6; y <= 0.6; y += 0.2)
+  {
+    shot_windows.addObstacle(Vector2d(4.0, y));
+  }
+  EXPECT_FALSE(shot_windows.evaluate(Vector2d(0.0, 0.0)).open);
+}
+
+TEST(test_shot_window, obstacle_against_the_ball)
+{
+  ShotWindows shot_windows(GOAL_X, GOAL_WIDTH, RADIUS);
+  // an opponent pressed against the ball, between the ball and the goal
+  shot_windows.addObstacle(Vector2d(0.11, 0.0));
+  EXPECT_FALSE(shot_windows.evaluate(Vector2d(0.0, 0.0)).open);
+
+  std::vector<ShotWindow> windows;
+  shot_windows.evaluate(std::vector<Vector2d>{ Vector2d(0.0, 0.0), Vector2d(0.0, 1.0) }, windows);
+  EXPECT_FALSE(windows[0].open);
+  EXPECT_TRUE(windows[1].open);
+}
+
+TEST(test_shot_window, random_against_sampling)
+{
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> xs(-4.5, 4.5);
+  std::uniform_real_distribution<double> ys(-3.0, 3.0);
+  std::uniform_real_distribution<double> near_goal_xs(2.0, 4.5);
+  std::uniform_real_distribution<double> near_goal_ys(-1.0, 1.0);
+  for (int test = 0; test < 200; test++)
+  {
+    ShotWindows shot_windows(GOAL_X, GOAL_WIDTH, RADIUS);
+    std::vector<Vector2d> obstacles;
+    for (int i = 0; i < 6; i++)
+    {
+      obstacles.push_back(Vector2d(near_goal_xs(generator), near_goal_ys(generator)));
+      shot_windows.addObstacle(obstacles.back());
+    }
+    std::vector<Vector2d> shooters;
+    for (int i = 0; i < 10; i++)
+    {
+      shooters.push_back(Vector2d(xs(generator), ys(generator)));
+    }
+
+    std::vector<ShotWindow> windows;
+    shot_windows.evaluate(shooters, windows);
+    ASSERT_EQ(windows.size(), shooters.size());
+    for (unsigned int i = 0; i < shooters.size(); i++)
+    {
+      ShotWindow window = shot_windows.evaluate(shooters[i]);
+      EXPECT_EQ(window.open, windows[i].open);
+      EXPECT_DOUBLE_EQ(window.probability, windows[i].probability);
+
+      int nb_samples = 2000;
+      EXPECT_NEAR(window.probability * GOAL_WIDTH, sampledWidth(shooters[i], obstacles, nb_samples),
+                  2.0 * GOAL_WIDTH / nb_samples);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
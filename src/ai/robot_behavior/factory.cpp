@@ -22,11 +22,27 @@
 #include "position_follower.h"
 #include "navigation_with_obstacle_avoidance.h"
 #include "navigation_inside_the_field.h"
+#include "navigation_with_path_planning.h"
 
 namespace rhoban_ssl
 {
 namespace robot_behavior
 {
+namespace
+{
+template <typename FOLLOWER>
+void setConsign(FOLLOWER& follower, const rhoban_geometry::Point& position, const ContinuousAngle& angle,
+                bool ignore_the_ball)
+{
+  follower.setTranslationPid(ai::Config::p_translation, ai::Config::i_translation, ai::Config::d_translation);
+  follower.setOrientationPid(ai::Config::p_orientation, ai::Config::i_orientation, ai::Config::d_orientation);
+  follower.setLimits(ai::Config::translation_velocity_limit, ai::Config::rotation_velocity_limit,
+                     ai::Config::translation_acceleration_limit, ai::Config::rotation_acceleration_limit);
+  follower.setFollowingPosition(position, angle);
+  follower.avoidTheBall(not(ignore_the_ball));
+}
+}  // namespace
+
 ConsignFollower* Factory::fixedConsignFollower(const rhoban_geometry::Point& position, const ContinuousAngle& angle,
                                                bool ignore_the_ball)
 {
@@ -42,12 +58,24 @@ ConsignFollower* Factory::fixedConsignFollowerWithoutRepsectingAuthorizedLocatio
   // Navigation_with_obstacle_avoidance* follower = new Navigation_with_obstacle_avoidance(ai_data, ai_data.time,
   // ai_data.dt);
   // PositionFollower* follower = new PositionFollower(ai_data, ai_data.time, ai_data.dt);
-  follower->setTranslationPid(ai::Config::p_translation, ai::Config::i_translation, ai::Config::d_translation);
-  follower->setOrientationPid(ai::Config::p_orientation, ai::Config::i_orientation, ai::Config::d_orientation);
-  follower->setLimits(ai::Config::translation_velocity_limit, ai::Config::rotation_velocity_limit,
-                      ai::Config::translation_acceleration_limit, ai::Config::rotation_acceleration_limit);
-  follower->setFollowingPosition(position, angle);
-  follower->avoidTheBall(not(ignore_the_ball));
+  setConsign(*follower, position, angle, ignore_the_ball);
+  return follower;
+}
+
+std::shared_ptr<ConsignFollower> Factory::fixedConsignFollower(ObjectPool<NavigationInsideTheField>& pool,
+                                                               const rhoban_geometry::Point& position,
+                                                               const ContinuousAngle& angle, bool ignore_the_ball)
+{
+  std::shared_ptr<NavigationInsideTheField> follower = pool.make(Data::get()->time.now(), 0, true);
+  setConsign(*follower, position, angle, ignore_the_ball);
+  return follower;
+}
+
+ConsignFollower* Factory::plannedConsignFollower(const rhoban_geometry::Point& position, const ContinuousAngle& angle,
+                                                 bool ignore_the_ball)
+{
+  NavigationWithPathPlanning* follower = new NavigationWithPathPlanning(Data::get()->time.now(), 0);
+  setConsign(*follower, position, angle, ignore_the_ball);
   return follower;
 }
 
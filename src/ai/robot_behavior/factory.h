@@ -20,11 +20,14 @@
 #pragma once
 
 #include "consign_follower.h"
+#include <core/object_pool.h>
 
 namespace rhoban_ssl
 {
 namespace robot_behavior
 {
+class NavigationInsideTheField;
+
 class Factory
 {
 public:
@@ -36,6 +39,22 @@ public:
   static ConsignFollower* fixedConsignFollowerWithoutRepsectingAuthorizedLocation(
       const rhoban_geometry::Point& position = rhoban_geometry::Point(0.0, 0.0),
       const ContinuousAngle& angle = ContinuousAngle(0.0), bool ignore_the_ball = false);
+
+  /**
+   * @brief Same as fixedConsignFollower(), the follower is made in a block of the pool.
+   */
+  static std::shared_ptr<ConsignFollower> fixedConsignFollower(ObjectPool<NavigationInsideTheField>& pool,
+                                                               const rhoban_geometry::Point& position,
+                                                               const ContinuousAngle& angle,
+                                                               bool ignore_the_ball = false);
+
+  /**
+   * @brief A follower that plans a path around all the obstacles (see NavigationWithPathPlanning).
+   */
+  static ConsignFollower* plannedConsignFollower(const rhoban_geometry::Point& position = rhoban_geometry::Point(0.0,
+                                                                                                                 0.0),
+                                                 const ContinuousAngle& angle = ContinuousAngle(0.0),
+                                                 bool ignore_the_ball = false);
 };
 
 };  // namespace robot_behavior
@@ -0,0 +1,169 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "navigation_with_path_planning.h"
+#include <math/box.h>
+
+namespace rhoban_ssl
+{
+namespace robot_behavior
+{
+NavigationWithPathPlanning::NavigationWithPathPlanning(double time, double dt)
+  : ConsignFollower()
+  , ignore_the_ball_(false)
+  , ignore_robot_()
+  , ball_radius_avoidance_(ai::Config::robot_radius)
+  , target_position_(0.0, 0.0)
+  , target_angle_(0.0)
+  , position_follower_(time, dt)
+{
+}
+
+void NavigationWithPathPlanning::setFollowingPosition(const rhoban_geometry::Point& position_to_follow,
+                                                      const ContinuousAngle& angle)
+{
+  target_position_ = position_to_follow;
+  target_angle_ = angle;
+}
+
+void NavigationWithPathPlanning::setObstacles(double time, const data::Robot& robot, const data::Ball& ball)
+{
+  planner_.clearObstacles();
+
+  double robot_obstacle_radius = 2 * ai::Config::robot_radius + ai::Config::radius_security_for_avoidance;
+  for (unsigned int i = 0; i < Data::get()->all_robots.size(); i++)
+  {
+    const data::Robot* obstacle = Data::get()->all_robots[i].second;
+    if (obstacle == &robot || ignore_robot_[i] || not(obstacle->isActive()))
+    {
+      continue;
+    }
+    planner_.addCircle(obstacle->getMovement().linearPosition(time), robot_obstacle_radius);
+  }
+
+  if (not(ignore_the_ball_))
+  {
+    planner_.addCircle(ball.getMovement().linearPosition(time), ai::Config::robot_radius + ball_radius_avoidance_);
+  }
+
+  Box opponent_penalty = Data::get()->field.getPenaltyArea(Opponent).increase(ai::Config::robot_radius);
+  planner_.addBox(opponent_penalty.getSW(), opponent_penalty.getNE());
+  if (not(robot.is_goalie))
+  {
+    Box ally_penalty = Data::get()->field.getPenaltyArea(Ally).increase(ai::Config::robot_radius);
+    planner_.addBox(ally_penalty.getSW(), ally_penalty.getNE());
+  }
+
+  // Same margins as NavigationInsideTheField
+  double marge = 2 * ai::Config::ball_radius;
+  planner_.setBounds(Vector2d(Data::get()->field.getSW()) - Vector2d(marge, marge),
+                     Vector2d(Data::get()->field.getNE()) + Vector2d(marge, marge));
+}
+
+void NavigationWithPathPlanning::update(double time, const data::Robot& robot, const data::Ball& ball)
+{
+  // At First, we update time and update potition from the abstract class robot_behavior.
+  // DO NOT REMOVE THAT LINE
+  RobotBehavior::updateTimeAndPosition(time, robot, ball);
+
+  setObstacles(time, robot, ball);
+  planner_.plan(robot_linear_position_, Vector2d(target_position_));
+
+  position_follower_.setFollowingPosition(vector2point(planner_.nextWaypoint()), target_angle_);
+  position_follower_.update(time, robot, ball);
+}
+
+Control NavigationWithPathPlanning::control() const
+{
+  return position_follower_.control();
+}
+
+void NavigationWithPathPlanning::setTranslationPid(double kp, double ki, double kd)
+{
+  position_follower_.setTranslationPid(kp, ki, kd);
+}
+
+void NavigationWithPathPlanning::setOrientationPid(double kp, double ki, double kd)
+{
+  position_follower_.setOrientationPid(kp, ki, kd);
+}
+
+void NavigationWithPathPlanning::setLimits(double translation_velocity_limit, double rotation_velocity_limit,
+                                           double translation_acceleration_limit, double rotation_acceleration_limit)
+{
+  position_follower_.setLimits(translation_velocity_limit, rotation_velocity_limit, translation_acceleration_limit,
+                               rotation_acceleration_limit);
+}
+
+void NavigationWithPathPlanning::setPlanningTimeBudget(double time_budget)
+{
+  planner_.setTimeBudget(time_budget);
+}
+
+void NavigationWithPathPlanning::avoidTheBall(bool value)
+{
+  ignore_the_ball_ = not(value);
+}
+
+void NavigationWithPathPlanning::avoidAlly(bool value)
+{
+  for (int i = 0; i < ai::Config::NB_OF_ROBOTS_BY_TEAM; i++)
+  {
+    ignore_robot_[i] = not(value);
+  }
+}
+
+void NavigationWithPathPlanning::avoidOpponent(bool value)
+{
+  for (int i = ai::Config::NB_OF_ROBOTS_BY_TEAM; i < 2 * ai::Config::NB_OF_ROBOTS_BY_TEAM; i++)
+  {
+    ignore_robot_[i] = not(value);
+  }
+}
+
+void NavigationWithPathPlanning::avoidRobot(int id, bool value)
+{
+  ignore_robot_[id] = not(value);
+}
+
+void NavigationWithPathPlanning::setRadiusAvoidanceForTheBall(double radius)
+{
+  ball_radius_avoidance_ = radius;
+}
+
+const PathPlanner& NavigationWithPathPlanning::planner() const
+{
+  return planner_;
+}
+
+rhoban_ssl::annotations::Annotations NavigationWithPathPlanning::getAnnotations() const
+{
+  rhoban_ssl::annotations::Annotations annotations;
+  Vector2d previous = robot_linear_position_;
+  for (const Vector2d& waypoint : planner_.path())
+  {
+    annotations.addArrow(previous, waypoint, "cyan", true);
+    previous = waypoint;
+  }
+  annotations.addAnnotations(position_follower_.getAnnotations());
+  return annotations;
+}
+
+}  // namespace robot_behavior
+}  // namespace rhoban_ssl
@@ -0,0 +1,83 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "consign_follower.h"
+#include "position_follower.h"
+#include "path_planner.h"
+
+namespace rhoban_ssl
+{
+namespace robot_behavior
+{
+/**
+ * @brief Goes to the consign on a path around all the robots, the ball, the penalty areas
+ * and inside the field bounds.
+ *
+ * The path is updated at each tick by a PathPlanner (which reuses the path of the previous tick)
+ * and a PositionFollower goes to its next waypoint.
+ */
+class NavigationWithPathPlanning : public ConsignFollower
+{
+private:
+  bool ignore_the_ball_;
+  bool ignore_robot_[2 * ai::Config::NB_OF_ROBOTS_BY_TEAM];  // 2 *  because there is 2 teams.
+  double ball_radius_avoidance_;
+
+  rhoban_geometry::Point target_position_;
+  ContinuousAngle target_angle_;
+
+  PathPlanner planner_;
+  PositionFollower position_follower_;
+
+  void setObstacles(double time, const data::Robot& robot, const data::Ball& ball);
+
+public:
+  NavigationWithPathPlanning(double time, double dt);
+
+  virtual void update(double time, const data::Robot& robot, const data::Ball& ball);
+
+  virtual Control control() const;
+
+  void setTranslationPid(double kp, double ki, double kd);
+  void setOrientationPid(double kp, double ki, double kd);
+
+  void setLimits(double translation_velocity_limit, double rotation_velocity_limit,
+                 double translation_acceleration_limit, double rotation_acceleration_limit);
+
+  /**
+   * @brief Sets the maximal duration of the planning of each tick, in seconds.
+   */
+  void setPlanningTimeBudget(double time_budget);
+
+  virtual void setFollowingPosition(const rhoban_geometry::Point& position_to_follow, const ContinuousAngle& angle);
+  virtual void avoidTheBall(bool value = true);
+  virtual void avoidAlly(bool value);
+  virtual void avoidOpponent(bool value);
+  virtual void avoidRobot(int id, bool value);
+
+  virtual void setRadiusAvoidanceForTheBall(double radius);
+
+  const PathPlanner& planner() const;
+
+  virtual rhoban_ssl::annotations::Annotations getAnnotations() const;
+};
+
+};  // namespace robot_behavior
+};  // namespace rhoban_ssl
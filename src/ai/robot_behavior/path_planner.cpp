@@ -0,0 +1,575 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "path_planner.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace rhoban_ssl
+{
+namespace robot_behavior
+{
+namespace
+{
+// Distance between the nodes and the obstacles (m)
+constexpr double NODE_MARGIN = 0.01;
+
+// Written on the coordinates: it is the inner loop of the planner
+double squareDistanceToSegment(const Vector2d& point, const Vector2d& a, const Vector2d& b)
+{
+  double abx = b.vec[0] - a.vec[0];
+  double aby = b.vec[1] - a.vec[1];
+  double apx = point.vec[0] - a.vec[0];
+  double apy = point.vec[1] - a.vec[1];
+  double square_length = abx * abx + aby * aby;
+  double t = 0.0;
+  if (square_length > 0.0)
+  {
+    t = std::min(1.0, std::max(0.0, (apx * abx + apy * aby) / square_length));
+  }
+  double dx = apx - t * abx;
+  double dy = apy - t * aby;
+  return dx * dx + dy * dy;
+}
+
+// Liang-Barsky clipping: the segment crosses the interior of the box
+bool segmentCrossesBox(const Vector2d& a, const Vector2d& b, const Vector2d& sw, const Vector2d& ne)
+{
+  double t_min = 0.0;
+  double t_max = 1.0;
+  for (int axis = 0; axis < 2; ++axis)
+  {
+    double delta = b[axis] - a[axis];
+    if (delta == 0.0)
+    {
+      if (a[axis] <= sw[axis] || a[axis] >= ne[axis])
+      {
+        return false;
+      }
+      continue;
+    }
+    double t1 = (sw[axis] - a[axis]) / delta;
+    double t2 = (ne[axis] - a[axis]) / delta;
+    t_min = std::max(t_min, std::min(t1, t2));
+    t_max = std::min(t_max, std::max(t1, t2));
+    if (t_min >= t_max)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool isInsideBox(const Vector2d& point, const Vector2d& sw, const Vector2d& ne)
+{
+  return sw[0] < point[0] && point[0] < ne[0] && sw[1] < point[1] && point[1] < ne[1];
+}
+}  // namespace
+
+PathPlanner::PathPlanner()
+  : has_bounds_(false)
+  , time_budget_(DEFAULT_TIME_BUDGET)
+  , goal_(0.0, 0.0)
+  , ticks_since_search_(0)
+  , last_result_(DIRECT)
+  , last_planning_time_(0.0)
+  , results_()
+{
+}
+
+void PathPlanner::setTimeBudget(double time_budget)
+{
+  time_budget_ = time_budget;
+}
+
+void PathPlanner::clearObstacles()
+{
+  circles_.clear();
+  boxes_.clear();
+}
+
+void PathPlanner::addCircle(const Vector2d& center, double radius)
+{
+  circles_.push_back({ center, radius });
+}
+
+void PathPlanner::addBox(const Vector2d& sw, const Vector2d& ne)
+{
+  boxes_.push_back({ sw, ne });
+}
+
+void PathPlanner::setBounds(const Vector2d& sw, const Vector2d& ne)
+{
+  has_bounds_ = true;
+  bounds_sw_ = sw;
+  bounds_ne_ = ne;
+}
+
+bool PathPlanner::outOfTime() const
+{
+  return std::chrono::steady_clock::now() > deadline_;
+}
+
+bool PathPlanner::isInsideBounds(const Vector2d& point) const
+{
+  return !has_bounds_ || (bounds_sw_[0] <= point[0] && point[0] <= bounds_ne_[0] && bounds_sw_[1] <= point[1] &&
+                          point[1] <= bounds_ne_[1]);
+}
+
+bool PathPlanner::isFree(const Vector2d& point) const
+{
+  if (!isInsideBounds(point))
+  {
+    return false;
+  }
+  for (size_t i = 0; i < circles_.size(); ++i)
+  {
+    if (!ignored_circles_[i] && (point - circles_[i].center).normSquare() < circles_[i].radius * circles_[i].radius)
+    {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < boxes_.size(); ++i)
+  {
+    if (!ignored_boxes_[i] && isInsideBox(point, boxes_[i].sw, boxes_[i].ne))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PathPlanner::segmentIsFree(const Vector2d& a, const Vector2d& b) const
+{
+  for (size_t i = 0; i < circles_.size(); ++i)
+  {
+    if (!ignored_circles_[i] &&
+        squareDistanceToSegment(circles_[i].center, a, b) < circles_[i].radius * circles_[i].radius)
+    {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < boxes_.size(); ++i)
+  {
+    if (!ignored_boxes_[i] && segmentCrossesBox(a, b, boxes_[i].sw, boxes_[i].ne))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+Vector2d PathPlanner::fixGoal(const Vector2d& goal) const
+{
+  Vector2d fixed = goal;
+  if (has_bounds_)
+  {
+    for (int axis = 0; axis < 2; ++axis)
+    {
+      fixed[axis] = std::min(bounds_ne_[axis], std::max(bounds_sw_[axis], fixed[axis]));
+    }
+  }
+  for (const Rectangle& box : boxes_)
+  {
+    if (!isInsideBox(fixed, box.sw, box.ne))
+    {
+      continue;
+    }
+    // We leave the box by its closest side that is inside the bounds.
+    double best_distance = std::numeric_limits<double>::infinity();
+    Vector2d best = fixed;
+    for (int axis = 0; axis < 2; ++axis)
+    {
+      Vector2d candidates[2] = { fixed, fixed };
+      candidates[0][axis] = box.sw[axis] - NODE_MARGIN;
+      candidates[1][axis] = box.ne[axis] + NODE_MARGIN;
+      for (const Vector2d& candidate : candidates)
+      {
+        double distance = (candidate - fixed).norm();
+        if (isInsideBounds(candidate) && distance < best_distance)
+        {
+          best_distance = distance;
+          best = candidate;
+        }
+      }
+    }
+    fixed = best;
+  }
+  return fixed;
+}
+
+void PathPlanner::ignoreObstaclesContaining(const Vector2d& start, const Vector2d& goal)
+{
+  ignored_circles_.assign(circles_.size(), false);
+  for (size_t i = 0; i < circles_.size(); ++i)
+  {
+    double square_radius = circles_[i].radius * circles_[i].radius;
+    ignored_circles_[i] = (start - circles_[i].center).normSquare() < square_radius ||
+                          (goal - circles_[i].center).normSquare() < square_radius;
+  }
+  ignored_boxes_.assign(boxes_.size(), false);
+  for (size_t i = 0; i < boxes_.size(); ++i)
+  {
+    ignored_boxes_[i] = isInsideBox(start, boxes_[i].sw, boxes_[i].ne);
+  }
+}
+
+void PathPlanner::addCircleNodes(const Circle& circle, std::vector<Vector2d>& nodes) const
+{
+  // The polygon of the nodes contains the circle
+  double radius = circle.radius / std::cos(M_PI / NB_CIRCLE_NODES) + NODE_MARGIN;
+  for (int i = 0; i < NB_CIRCLE_NODES; ++i)
+  {
+    double angle = 2 * M_PI * i / NB_CIRCLE_NODES;
+    Vector2d node = circle.center + Vector2d(std::cos(angle), std::sin(angle)) * radius;
+    if (isFree(node))
+    {
+      nodes.push_back(node);
+    }
+  }
+}
+
+void PathPlanner::addBoxNodes(const Rectangle& box, std::vector<Vector2d>& nodes) const
+{
+  Vector2d corners[4] = { Vector2d(box.sw[0] - NODE_MARGIN, box.sw[1] - NODE_MARGIN),
+                          Vector2d(box.ne[0] + NODE_MARGIN, box.sw[1] - NODE_MARGIN),
+                          Vector2d(box.ne[0] + NODE_MARGIN, box.ne[1] + NODE_MARGIN),
+                          Vector2d(box.sw[0] - NODE_MARGIN, box.ne[1] + NODE_MARGIN) };
+  for (const Vector2d& corner : corners)
+  {
+    if (isFree(corner))
+    {
+      nodes.push_back(corner);
+    }
+  }
+}
+
+bool PathPlanner::reusePath(const Vector2d& start)
+{
+  // Shortcut: the furthest waypoint that is visible from the start
+  size_t first = path_.size();
+  for (size_t i = path_.size(); i-- > 0;)
+  {
+    if (segmentIsFree(start, path_[i]))
+    {
+      first = i;
+      break;
+    }
+  }
+  if (first == path_.size())
+  {
+    return false;
+  }
+  for (size_t i = first; i + 1 < path_.size(); ++i)
+  {
+    if (!segmentIsFree(path_[i], path_[i + 1]))
+    {
+      return false;
+    }
+  }
+  path_.erase(path_.begin(), path_.begin() + first);
+  return true;
+}
+
+bool PathPlanner::repairPath(const Vector2d& start)
+{
+  // First blocked segment of start -> path_[0] -> ... -> goal
+  size_t blocked = 0;
+  Vector2d a = start;
+  while (blocked < path_.size() && segmentIsFree(a, path_[blocked]))
+  {
+    a = path_[blocked];
+    blocked++;
+  }
+  if (blocked == path_.size())
+  {
+    return true;
+  }
+  const Vector2d b = path_[blocked];
+
+  // One detour around an obstacle that blocks the segment, the shortest first
+  nodes_.clear();
+  for (size_t i = 0; i < circles_.size(); ++i)
+  {
+    if (!ignored_circles_[i] &&
+        squareDistanceToSegment(circles_[i].center, a, b) < circles_[i].radius * circles_[i].radius)
+    {
+      addCircleNodes(circles_[i], nodes_);
+    }
+  }
+  for (size_t i = 0; i < boxes_.size(); ++i)
+  {
+    if (!ignored_boxes_[i] && segmentCrossesBox(a, b, boxes_[i].sw, boxes_[i].ne))
+    {
+      addBoxNodes(boxes_[i], nodes_);
+    }
+  }
+  std::sort(nodes_.begin(), nodes_.end(), [&](const Vector2d& n1, const Vector2d& n2) {
+    return (n1 - a).norm() + (b - n1).norm() < (n2 - a).norm() + (b - n2).norm();
+  });
+  for (const Vector2d& node : nodes_)
+  {
+    if (outOfTime())
+    {
+      return false;
+    }
+    if (segmentIsFree(a, node) && segmentIsFree(node, b))
+    {
+      path_.insert(path_.begin() + blocked, node);
+      // The rest of the path must be free too
+      for (size_t i = blocked + 1; i + 1 < path_.size(); ++i)
+      {
+        if (!segmentIsFree(path_[i], path_[i + 1]))
+        {
+          return false;
+        }
+      }
+      // The waypoints before the detour that are not visible anymore are dropped by the next reuse.
+      return true;
+    }
+  }
+  return false;
+}
+
+bool PathPlanner::search(const Vector2d& start, const Vector2d& goal)
+{
+  // node 0 is the start, node 1 is the goal
+  nodes_.clear();
+  nodes_.push_back(start);
+  nodes_.push_back(goal);
+  for (size_t i = 0; i < circles_.size(); ++i)
+  {
+    if (!ignored_circles_[i])
+    {
+      addCircleNodes(circles_[i], nodes_);
+    }
+  }
+  for (size_t i = 0; i < boxes_.size(); ++i)
+  {
+    if (!ignored_boxes_[i])
+    {
+      addBoxNodes(boxes_[i], nodes_);
+    }
+  }
+
+  size_t nb_nodes = nodes_.size();
+  cost_.assign(nb_nodes, std::numeric_limits<double>::infinity());
+  parent_.assign(nb_nodes, -1);
+  closed_.assign(nb_nodes, false);
+  cost_[0] = 0.0;
+
+  while (true)
+  {
+    if (outOfTime())
+    {
+      return false;
+    }
+    // The graph is small: a linear scan is faster than a heap
+    int current = -1;
+    double best = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < nb_nodes; ++i)
+    {
+      if (!closed_[i] && cost_[i] < std::numeric_limits<double>::infinity())
+      {
+        double estimation = cost_[i] + (goal - nodes_[i]).norm();
+        if (estimation < best)
+        {
+          best = estimation;
+          current = i;
+        }
+      }
+    }
+    if (current == -1)
+    {
+      return false;
+    }
+
+    // The edges are only checked when a node is selected (lazy edges): if the edge from its parent
+    // is blocked, its cost is computed again from the best free edge from a closed node.
+    if (current != 0 && !segmentIsFree(nodes_[parent_[current]], nodes_[current]))
+    {
+      candidates_.clear();
+      for (size_t i = 0; i < nb_nodes; ++i)
+      {
+        if (closed_[i] && static_cast<int>(i) != parent_[current])
+        {
+          candidates_.push_back(std::make_pair(cost_[i] + (nodes_[current] - nodes_[i]).norm(), i));
+        }
+      }
+      std::sort(candidates_.begin(), candidates_.end());
+      cost_[current] = std::numeric_limits<double>::infinity();
+      parent_[current] = -1;
+      for (const std::pair<double, int>& candidate : candidates_)
+      {
+        if (segmentIsFree(nodes_[candidate.second], nodes_[current]))
+        {
+          cost_[current] = candidate.first;
+          parent_[current] = candidate.second;
+          break;
+        }
+      }
+      continue;
+    }
+
+    if (current == 1)
+    {
+      break;
+    }
+    closed_[current] = true;
+    for (size_t i = 1; i < nb_nodes; ++i)
+    {
+      if (closed_[i])
+      {
+        continue;
+      }
+      double cost = cost_[current] + (nodes_[i] - nodes_[current]).norm();
+      if (cost < cost_[i])
+      {
+        cost_[i] = cost;
+        parent_[i] = current;
+      }
+    }
+  }
+
+  search_path_.clear();
+  for (int node = 1; node != 0; node = parent_[node])
+  {
+    search_path_.push_back(nodes_[node]);
+  }
+  std::reverse(search_path_.begin(), search_path_.end());
+  return true;
+}
+
+void PathPlanner::finish(Result result, std::chrono::steady_clock::time_point start_time)
+{
+  last_result_ = result;
+  results_[result]++;
+  last_planning_time_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+PathPlanner::Result PathPlanner::plan(const Vector2d& start, const Vector2d& goal)
+{
+  std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+  deadline_ = start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                               std::chrono::duration<double>(time_budget_));
+
+  Vector2d fixed_goal = fixGoal(goal);
+  ignoreObstaclesContaining(start, fixed_goal);
+  bool same_goal = !path_.empty() && (fixed_goal - goal_).norm() < GOAL_TOLERANCE;
+  goal_ = fixed_goal;
+
+  if (segmentIsFree(start, fixed_goal))
+  {
+    path_.assign(1, fixed_goal);
+    finish(DIRECT, start_time);
+    return DIRECT;
+  }
+
+  if (same_goal)
+  {
+    // The last waypoint follows the goal
+    path_.back() = fixed_goal;
+    if (reusePath(start))
+    {
+      ticks_since_search_++;
+      if (ticks_since_search_ < REPLANNING_PERIOD)
+      {
+        finish(REUSED, start_time);
+        return REUSED;
+      }
+      // Looking for a better path from time to time
+      ticks_since_search_ = 0;
+      if (search(start, fixed_goal))
+      {
+        double reused_length = pathLength(start);
+        path_.swap(search_path_);
+        if (pathLength(start) < (1.0 - HYSTERESIS) * reused_length)
+        {
+          finish(PLANNED, start_time);
+          return PLANNED;
+        }
+        path_.swap(search_path_);
+      }
+      finish(REUSED, start_time);
+      return REUSED;
+    }
+    if (repairPath(start))
+    {
+      finish(REPAIRED, start_time);
+      return REPAIRED;
+    }
+  }
+
+  ticks_since_search_ = 0;
+  if (search(start, fixed_goal))
+  {
+    path_.swap(search_path_);
+    finish(PLANNED, start_time);
+    return PLANNED;
+  }
+  Result result = outOfTime() ? TIMEOUT : NO_PATH;
+  if (result == NO_PATH || !same_goal)
+  {
+    path_.assign(1, fixed_goal);
+  }
+  finish(result, start_time);
+  return result;
+}
+
+const std::vector<Vector2d>& PathPlanner::path() const
+{
+  return path_;
+}
+
+const Vector2d& PathPlanner::nextWaypoint() const
+{
+  return path_.empty() ? goal_ : path_.front();
+}
+
+double PathPlanner::pathLength(const Vector2d& start) const
+{
+  double length = 0.0;
+  Vector2d previous = start;
+  for (const Vector2d& waypoint : path_)
+  {
+    length += (waypoint - previous).norm();
+    previous = waypoint;
+  }
+  return length;
+}
+
+PathPlanner::Result PathPlanner::lastResult() const
+{
+  return last_result_;
+}
+
+double PathPlanner::lastPlanningTime() const
+{
+  return last_planning_time_;
+}
+
+unsigned long PathPlanner::nbResults(Result result) const
+{
+  return results_[result];
+}
+
+}  // namespace robot_behavior
+}  // namespace rhoban_ssl
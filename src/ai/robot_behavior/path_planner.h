@@ -0,0 +1,167 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <math/vector2d.h>
+#include <chrono>
+#include <vector>
+#include <utility>
+
+namespace rhoban_ssl
+{
+namespace robot_behavior
+{
+/**
+ * @brief Global path planner on a visibility graph around circles and boxes.
+ *
+ * The nodes of the graph are points around the inflated obstacles (circles for the robots and the ball,
+ * axis-aligned boxes for the penalty areas), the field bounds limit where the nodes can be.
+ * The search is an A* where an edge is only checked when its end node is selected (lazy edges).
+ *
+ * The path of the previous tick is reused when it is still free (shortcutting the waypoints
+ * that became visible) and repaired with one detour when one of its segments got blocked.
+ * The graph search is only done when there is no path to reuse, and every REPLANNING_PERIOD
+ * ticks to look for a better path (it replaces the reused one only if it is clearly shorter,
+ * so the robot doesn't oscillate between two ways around an obstacle).
+ *
+ * Everything is done in a time budget: when it is exceeded, the planner keeps the previous path
+ * or goes straight to the goal.
+ */
+class PathPlanner
+{
+public:
+  enum Result
+  {
+    DIRECT = 0,    // the goal is visible from the start
+    REUSED = 1,    // the previous path is still free
+    REPAIRED = 2,  // the previous path got one detour
+    PLANNED = 3,   // a new path was found by the search
+    TIMEOUT = 4,   // the time budget was exceeded, the previous path (or the goal) is kept
+    NO_PATH = 5,   // the search found no path, the robot goes straight to the goal
+    NB_RESULTS
+  };
+
+  static constexpr double DEFAULT_TIME_BUDGET = 200e-6;
+  // Number of nodes around each circle
+  static constexpr int NB_CIRCLE_NODES = 8;
+  // The previous path is kept while the goal moves less than this distance (m)
+  static constexpr double GOAL_TOLERANCE = 0.1;
+  static constexpr int REPLANNING_PERIOD = 10;
+  // A new path replaces the reused one if it is shorter by this ratio
+  static constexpr double HYSTERESIS = 0.1;
+
+private:
+  struct Circle
+  {
+    Vector2d center;
+    double radius;
+  };
+  struct Rectangle
+  {
+    Vector2d sw;
+    Vector2d ne;
+  };
+
+  std::vector<Circle> circles_;
+  std::vector<Rectangle> boxes_;
+  // obstacles that contain the start or the goal are ignored during a planning
+  std::vector<bool> ignored_circles_;
+  std::vector<bool> ignored_boxes_;
+  bool has_bounds_;
+  Vector2d bounds_sw_;
+  Vector2d bounds_ne_;
+
+  double time_budget_;
+  std::chrono::steady_clock::time_point deadline_;
+
+  // waypoints after the start, the last one is the goal
+  std::vector<Vector2d> path_;
+  Vector2d goal_;
+  int ticks_since_search_;
+  Result last_result_;
+  double last_planning_time_;
+  unsigned long results_[NB_RESULTS];
+
+  // buffers of the search
+  std::vector<Vector2d> nodes_;
+  std::vector<double> cost_;
+  std::vector<int> parent_;
+  std::vector<bool> closed_;
+  std::vector<std::pair<double, int>> candidates_;
+  std::vector<Vector2d> search_path_;
+
+  bool outOfTime() const;
+  bool isInsideBounds(const Vector2d& point) const;
+  bool isFree(const Vector2d& point) const;
+  Vector2d fixGoal(const Vector2d& goal) const;
+  void ignoreObstaclesContaining(const Vector2d& start, const Vector2d& goal);
+  void addCircleNodes(const Circle& circle, std::vector<Vector2d>& nodes) const;
+  void addBoxNodes(const Rectangle& box, std::vector<Vector2d>& nodes) const;
+  bool reusePath(const Vector2d& start);
+  bool repairPath(const Vector2d& start);
+  bool search(const Vector2d& start, const Vector2d& goal);
+  void finish(Result result, std::chrono::steady_clock::time_point start_time);
+
+public:
+  PathPlanner();
+
+  /**
+   * @brief Sets the maximal duration of a planning, in seconds.
+   */
+  void setTimeBudget(double time_budget);
+
+  /**
+   * @brief Removes the obstacles before they are given for a new tick (the previous path is kept).
+   */
+  void clearObstacles();
+  void addCircle(const Vector2d& center, double radius);
+  void addBox(const Vector2d& sw, const Vector2d& ne);
+  void setBounds(const Vector2d& sw, const Vector2d& ne);
+
+  /**
+   * @brief Checks that a segment doesn't cross an obstacle (ignored obstacles excepted).
+   */
+  bool segmentIsFree(const Vector2d& a, const Vector2d& b) const;
+
+  /**
+   * @brief Updates the path from start to goal.
+   *
+   * The goal is moved out of the boxes and inside the bounds.
+   */
+  Result plan(const Vector2d& start, const Vector2d& goal);
+
+  /**
+   * @brief Waypoints after the start, the last one is the goal.
+   */
+  const std::vector<Vector2d>& path() const;
+
+  /**
+   * @brief The waypoint to follow now.
+   */
+  const Vector2d& nextWaypoint() const;
+
+  double pathLength(const Vector2d& start) const;
+
+  Result lastResult() const;
+  double lastPlanningTime() const;
+  unsigned long nbResults(Result result) const;
+};
+
+};  // namespace robot_behavior
+};  // namespace rhoban_ssl
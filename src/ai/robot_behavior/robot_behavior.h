@@ -26,6 +26,8 @@
 #include <rhoban_utils/angle.h>
 #include <data.h>
 #include <annotations/annotations.h>
+#include <array>
+#include <memory>
 
 namespace rhoban_ssl
 {
@@ -53,6 +55,10 @@ public:
 
   void updateTimeAndPosition(double time, const data::Robot& robot, const data::Ball& ball);
 
+  /**
+   * update() and control() can run concurrently for different robots (see ai::Config::behavior_threads):
+   * they must only read the shared state (Data, GameInformations) and write the members of the behavior.
+   */
   virtual void update(double time, const data::Robot& robot, const data::Ball& ball) = 0;
   virtual Control control() const = 0;
 
@@ -83,6 +89,11 @@ public:
   bool infraRed() const;
 };
 
+/**
+ * @brief The behaviors of the allied robots, indexed by the robot ids.
+ */
+typedef std::array<std::shared_ptr<RobotBehavior>, ai::Config::NB_OF_ROBOTS_BY_TEAM> RobotBehaviors;
+
 class RobotBehaviorTask : public Task
 {
 private:
@@ -27,11 +27,26 @@ namespace rhoban_ssl
 {
 namespace robot_behavior
 {
+namespace
+{
+data::ValueMaps::Weights positionWeights()
+{
+  data::ValueMaps::Weights weights;
+  weights.fill(0.0f);
+  weights[data::ValueMaps::ShotQuality] = 1.0f;
+  weights[data::ValueMaps::PassReachability] = 0.5f;
+  return weights;
+}
+}  // namespace
+
 SearchShootArea::SearchShootArea()
   : RobotBehavior()
   , obstructed_view_(-1)
   , period_(3)
   , last_time_changement_(0)
+  , has_declared_target_(false)
+  , value_weights_(positionWeights())
+  , value_maps_subscription_(Data::get()->value_maps, value_weights_)
   , follower_(Factory::fixedConsignFollower())
   , well_positioned(false)
 {
@@ -54,7 +69,8 @@ void SearchShootArea::update(double time, const data::Robot& robot, const data::
   const rhoban_geometry::Point& robot_position = robot.getMovement().linearPosition(time);
   // Vector2d opponent_goal_robot_vector = robot_position - opponent_goal_center();
 
-  std::pair<rhoban_geometry::Point, double> results = GameInformations::findGoalBestMove(robot_position);
+  std::pair<rhoban_geometry::Point, double> results =
+      GameInformations::findGoalBestMove(robot_position, rhoban_geometry::Point(66, 66), robot.id);
 
   annotations_.addArrow(robot_position, results.first, "red");
 
@@ -78,9 +94,20 @@ void SearchShootArea::update(double time, const data::Robot& robot, const data::
   {
     if (time > last_time_changement_ + period_)
     {
-      std::uniform_real_distribution<double> distribution_x(p1_.x, p2_.x);
-      std::uniform_real_distribution<double> distribution_y(p1_.y, p2_.y);
-      target_position_ = rhoban_geometry::Point(distribution_x(generator_), distribution_y(generator_));
+      const data::ValueMaps& value_maps = Data::get()->value_maps;
+      if (value_maps.available(data::ValueMaps::ShotQuality))
+      {
+        // The robot goes to the position of the area with the largest view of the goal
+        // and a free pass from the ball
+        target_position_ = value_maps.argmax(value_weights_, p1_, p2_);
+      }
+      else
+      {
+        // the maps are computed from the next tick
+        std::uniform_real_distribution<double> distribution_x(p1_.x, p2_.x);
+        std::uniform_real_distribution<double> distribution_y(p1_.y, p2_.y);
+        target_position_ = rhoban_geometry::Point(distribution_x(generator_), distribution_y(generator_));
+      }
       last_time_changement_ = time;
       well_positioned = false;
     }
@@ -89,6 +116,11 @@ void SearchShootArea::update(double time, const data::Robot& robot, const data::
   // target_position = robot_position;
   // target_position = robot_position;
 
+  if (has_declared_target_)
+  {
+    target_position_ = declared_target_;
+  }
+
   annotations_.addCross(target_position_.x, target_position_.y);
 
   follower_->avoidTheBall(false);
@@ -108,6 +140,17 @@ void SearchShootArea::declareArea(rhoban_geometry::Point p1, rhoban_geometry::Po
   this->p2_ = p2;
 }
 
+void SearchShootArea::declareTargetPosition(const rhoban_geometry::Point& target)
+{
+  has_declared_target_ = true;
+  declared_target_ = target;
+}
+
+void SearchShootArea::clearTargetPosition()
+{
+  has_declared_target_ = false;
+}
+
 SearchShootArea::~SearchShootArea()
 {
   delete follower_;
@@ -40,6 +40,12 @@ private:
   double last_time_changement_;
 
   rhoban_geometry::Point target_position_;
+  bool has_declared_target_;
+  rhoban_geometry::Point declared_target_;
+
+  // the target is the best cell of the area in the value maps
+  data::ValueMaps::Weights value_weights_;
+  data::ValueMaps::Subscription value_maps_subscription_;
 
   ConsignFollower* follower_;
   rhoban_ssl::annotations::Annotations annotations_;
@@ -58,6 +64,12 @@ public:
 
   void declareArea(rhoban_geometry::Point p1, rhoban_geometry::Point p2);
 
+  /**
+   * @brief The robot goes to this position instead of the one it chose in its area, until clearTargetPosition().
+   */
+  void declareTargetPosition(const rhoban_geometry::Point& target);
+  void clearTargetPosition();
+
   virtual Control control() const;
   virtual rhoban_ssl::annotations::Annotations getAnnotations() const;
   virtual ~SearchShootArea();
@@ -41,7 +41,8 @@ void StrikerAi::update(double time, const data::Robot& robot, const data::Ball&
 
   const rhoban_geometry::Point& robot_position = robot.getMovement().linearPosition(time);
 
-  std::pair<rhoban_geometry::Point, double> results = GameInformations::findGoalBestMove(ballPosition());
+  std::pair<rhoban_geometry::Point, double> results =
+      GameInformations::findGoalBestMove(ballPosition(), rhoban_geometry::Point(66, 66), robot.id);
   rhoban_geometry::Point goal_point = results.first;
 
   Vector2d ball_goal_vector = goal_point - ballPosition();
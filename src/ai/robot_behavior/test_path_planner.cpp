@@ -0,0 +1,166 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include <debug.h>
+#include "path_planner.h"
+#include <cmath>
+
+using namespace rhoban_ssl::robot_behavior;
+
+namespace
+{
+// Checks that the path goes from start to goal without crossing an obstacle
+void checkPath(const PathPlanner& planner, const Vector2d& start, const Vector2d& goal)
+{
+  const std::vector<Vector2d>& path = planner.path();
+  ASSERT_FALSE(path.empty());
+  EXPECT_NEAR((path.back() - goal).norm(), 0.0, 1e-9);
+  Vector2d previous = start;
+  for (const Vector2d& waypoint : path)
+  {
+    EXPECT_TRUE(planner.segmentIsFree(previous, waypoint));
+    previous = waypoint;
+  }
+}
+}  // namespace
+
+TEST(test_path_planner, direct_and_detour)
+{
+  PathPlanner planner;
+  planner.setTimeBudget(1.0);
+  planner.setBounds(Vector2d(-5.0, -4.0), Vector2d(5.0, 4.0));
+
+  Vector2d start(-2.0, 0.0);
+  Vector2d goal(2.0, 0.0);
+  EXPECT_EQ(planner.plan(start, goal), PathPlanner::DIRECT);
+  EXPECT_EQ(planner.path().size(), 1u);
+
+  planner.addCircle(Vector2d(0.0, 0.0), 0.5);
+  // The previous path (straight to the goal) gets a detour
+  EXPECT_EQ(planner.plan(start, goal), PathPlanner::REPAIRED);
+  EXPECT_GT(planner.path().size(), 1u);
+  checkPath(planner, start, goal);
+  // Not much longer than the tangents around the circle
+  EXPECT_LT(planner.pathLength(start), 4.3);
+
+  // A wall of robots
+  planner.clearObstacles();
+  for (int i = -3; i <= 3; ++i)
+  {
+    planner.addCircle(Vector2d(0.0, i * 0.3), 0.2);
+  }
+  // The previous path is blocked, it is repaired or planned again
+  PathPlanner::Result result = planner.plan(start, goal);
+  EXPECT_TRUE(result == PathPlanner::REPAIRED || result == PathPlanner::PLANNED);
+  checkPath(planner, start, goal);
+  for (const Vector2d& waypoint : planner.path())
+  {
+    EXPECT_TRUE(std::fabs(waypoint[1]) > 0.9 || std::fabs(waypoint[0]) > 0.2);
+  }
+}
+
+TEST(test_path_planner, reuse_and_repair)
+{
+  PathPlanner planner;
+  planner.setTimeBudget(1.0);
+  Vector2d start(-2.0, 0.0);
+  Vector2d goal(2.0, 0.0);
+
+  planner.addCircle(Vector2d(0.0, 0.0), 0.5);
+  EXPECT_EQ(planner.plan(start, goal), PathPlanner::PLANNED);
+  std::vector<Vector2d> first_path = planner.path();
+
+  // Same obstacles, the robot moved a bit and the goal moved a bit
+  planner.clearObstacles();
+  planner.addCircle(Vector2d(0.0, 0.0), 0.5);
+  Vector2d moved_start(-1.9, 0.0);
+  Vector2d moved_goal(2.0, 0.05);
+  EXPECT_EQ(planner.plan(moved_start, moved_goal), PathPlanner::REUSED);
+  checkPath(planner, moved_start, moved_goal);
+
+  // An obstacle appears on the path
+  planner.clearObstacles();
+  planner.addCircle(Vector2d(0.0, 0.0), 0.5);
+  Vector2d middle = 0.5 * (planner.path()[0] + moved_start);
+  planner.addCircle(middle, 0.1);
+  PathPlanner::Result result = planner.plan(moved_start, moved_goal);
+  EXPECT_TRUE(result == PathPlanner::REPAIRED || result == PathPlanner::PLANNED);
+  checkPath(planner, moved_start, moved_goal);
+
+  // The goal changed: new search
+  planner.clearObstacles();
+  planner.addCircle(Vector2d(0.0, 0.0), 0.5);
+  EXPECT_EQ(planner.plan(moved_start, Vector2d(2.0, 0.5)), PathPlanner::PLANNED);
+  checkPath(planner, moved_start, Vector2d(2.0, 0.5));
+}
+
+TEST(test_path_planner, goal_and_budget)
+{
+  PathPlanner planner;
+  planner.setTimeBudget(1.0);
+  planner.setBounds(Vector2d(-5.0, -4.0), Vector2d(5.0, 4.0));
+  planner.addBox(Vector2d(3.8, -1.0), Vector2d(5.0, 1.0));
+
+  // The goal is moved out of the box and the bounds
+  planner.plan(Vector2d(0.0, 0.0), Vector2d(4.5, 0.2));
+  EXPECT_LT(planner.path().back()[0], 3.8);
+  planner.plan(Vector2d(0.0, 0.0), Vector2d(0.0, 6.0));
+  EXPECT_NEAR(planner.path().back()[1], 4.0, 1e-9);
+
+  // Going around the box
+  Vector2d start(4.5, -2.0);
+  Vector2d goal(4.5, 2.0);
+  EXPECT_EQ(planner.plan(start, goal), PathPlanner::PLANNED);
+  checkPath(planner, start, goal);
+
+  // Without budget, the robot goes to the goal
+  PathPlanner late_planner;
+  late_planner.setTimeBudget(0.0);
+  late_planner.addCircle(Vector2d(0.0, 0.0), 0.5);
+  EXPECT_EQ(late_planner.plan(Vector2d(-2.0, 0.0), Vector2d(2.0, 0.0)), PathPlanner::TIMEOUT);
+  EXPECT_EQ(late_planner.path().size(), 1u);
+}
+
+TEST(test_path_planner, crowded_field_budget)
+{
+  PathPlanner planner;
+  planner.setBounds(Vector2d(-6.2, -4.7), Vector2d(6.2, 4.7));
+  planner.addBox(Vector2d(-6.0, -1.2), Vector2d(-4.6, 1.2));
+  planner.addBox(Vector2d(4.6, -1.2), Vector2d(6.0, 1.2));
+  // A defence in front of the goal and the other robots on the field
+  for (int i = 0; i < 6; ++i)
+  {
+    planner.addCircle(Vector2d(4.2, -1.25 + i * 0.5), 0.2);
+    planner.addCircle(Vector2d(-3.0 + i, 2.0 - i * 0.7), 0.2);
+  }
+  planner.addCircle(Vector2d(0.5, 0.5), 0.15);
+
+  PathPlanner::Result result = planner.plan(Vector2d(-4.0, 0.0), Vector2d(5.0, 1.6));
+  EXPECT_TRUE(result == PathPlanner::PLANNED || result == PathPlanner::TIMEOUT);
+  // The budget is respected, up to the last check
+  EXPECT_LT(planner.lastPlanningTime(), 2 * PathPlanner::DEFAULT_TIME_BUDGET);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
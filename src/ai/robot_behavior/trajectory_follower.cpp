@@ -0,0 +1,103 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "trajectory_follower.h"
+
+namespace rhoban_ssl
+{
+namespace robot_behavior
+{
+namespace
+{
+// Number of points used to draw the planned trajectory
+constexpr int NB_ANNOTATION_POINTS = 10;
+}  // namespace
+
+TrajectoryFollower::TrajectoryFollower()
+  : ConsignFollower()
+  , position_(0.0, 0.0)
+  , angle_(0.0)
+  , translation_velocity_limit_(ai::Config::translation_velocity_limit)
+  , rotation_velocity_limit_(ai::Config::rotation_velocity_limit)
+  , translation_acceleration_limit_(ai::Config::translation_acceleration_limit)
+  , rotation_acceleration_limit_(ai::Config::rotation_acceleration_limit)
+{
+}
+
+void TrajectoryFollower::setLimits(double translation_velocity_limit, double rotation_velocity_limit,
+                                   double translation_acceleration_limit, double rotation_acceleration_limit)
+{
+  translation_velocity_limit_ = translation_velocity_limit;
+  rotation_velocity_limit_ = rotation_velocity_limit;
+  translation_acceleration_limit_ = translation_acceleration_limit;
+  rotation_acceleration_limit_ = rotation_acceleration_limit;
+}
+
+void TrajectoryFollower::setFollowingPosition(const rhoban_geometry::Point& position_to_follow,
+                                              const ContinuousAngle& angle)
+{
+  position_ = position_to_follow;
+  angle_ = angle;
+}
+
+const BangBangTrajectory2D& TrajectoryFollower::trajectory() const
+{
+  return trajectory_;
+}
+
+void TrajectoryFollower::update(double time, const data::Robot& robot, const data::Ball& ball)
+{
+  // At First, we update time and update potition from the abstract class robot_behavior.
+  // DO NOT REMOVE THAT LINE
+  RobotBehavior::updateTimeAndPosition(time, robot, ball);
+
+  trajectory_.generate(robot_linear_position_, robot_linear_velocity_, Vector2d(position_),
+                       translation_velocity_limit_, translation_acceleration_limit_);
+
+  ContinuousAngle goal = robot_angular_position_;
+  goal.setToNearest(angle_);
+  rotation_.generate(robot_angular_position_.value(), robot_angular_velocity_.value(), goal.value(),
+                     rotation_velocity_limit_, rotation_acceleration_limit_);
+
+  // The command is applied during the next period: we send the velocity the robot should have at its end.
+  control_ = Control(trajectory_.velocity(ai::Config::period), ContinuousAngle(rotation_.velocity(ai::Config::period)));
+}
+
+Control TrajectoryFollower::control() const
+{
+  return control_;
+}
+
+rhoban_ssl::annotations::Annotations TrajectoryFollower::getAnnotations() const
+{
+  rhoban_ssl::annotations::Annotations annotations;
+  bool dashed = true;
+  double step = trajectory_.totalTime() / NB_ANNOTATION_POINTS;
+  for (int i = 0; i < NB_ANNOTATION_POINTS; ++i)
+  {
+    annotations.addArrow(trajectory_.position(i * step), trajectory_.position((i + 1) * step), "magenta", dashed);
+  }
+  annotations.addArrow(position_, position_ + Vector2d(std::cos(angle_.value()), std::sin(angle_.value())), "magenta",
+                       dashed);
+  annotations.addArrow(linearPosition(), linearPosition() + control_.linear_velocity, "orange", false);
+  return annotations;
+}
+
+}  // namespace robot_behavior
+}  // namespace rhoban_ssl
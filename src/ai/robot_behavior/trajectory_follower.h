@@ -0,0 +1,70 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "consign_follower.h"
+#include <math/bang_bang.h>
+
+namespace rhoban_ssl
+{
+namespace robot_behavior
+{
+/**
+ * @brief Follows a consign with a time-optimal bang-bang trajectory.
+ *
+ * The trajectory is planned again at each update from the current position and velocity of the robot,
+ * so there is no PID: the commanded velocity is the velocity of the trajectory one period ahead.
+ * The orientation follows a 1D bang-bang trajectory with the rotation limits.
+ */
+class TrajectoryFollower : public ConsignFollower
+{
+private:
+  rhoban_geometry::Point position_;
+  ContinuousAngle angle_;
+
+  double translation_velocity_limit_;
+  double rotation_velocity_limit_;
+  double translation_acceleration_limit_;
+  double rotation_acceleration_limit_;
+
+  BangBangTrajectory2D trajectory_;
+  BangBangTrajectory1D rotation_;
+  Control control_;
+
+public:
+  TrajectoryFollower();
+
+  void setLimits(double translation_velocity_limit, double rotation_velocity_limit,
+                 double translation_acceleration_limit, double rotation_acceleration_limit);
+
+  virtual void setFollowingPosition(const rhoban_geometry::Point& position_to_follow, const ContinuousAngle& angle);
+
+  /**
+   * @brief The translation trajectory planned during the last update.
+   */
+  const BangBangTrajectory2D& trajectory() const;
+
+  virtual void update(double time, const data::Robot& robot, const data::Ball& ball);
+
+  virtual Control control() const;
+  virtual rhoban_ssl::annotations::Annotations getAnnotations() const;
+};
+
+};  // namespace robot_behavior
+};  // namespace rhoban_ssl
@@ -19,6 +19,8 @@ along with SSL.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "attackms.h"
 #include "core/print_collection.h"
+#include <algorithm>
+#include <cmath>
 
 namespace rhoban_ssl
 {
@@ -47,7 +49,23 @@ AttaqueWithSupportMs::AttaqueWithSupportMs()
   , begin_time_(0)
   , diff_distance_constante_(0.5)
   , fgbm_constante_(0.05)
+  , pass_receiver_(-1)
+  , next_pass_candidate_(0)
+  , pass_round_time_(0.0)
+  , round_best_score_(-1.0)
+  , round_best_offset_(0.0, 0.0)
+  , pass_anchor_fixed_(false)
+  , pass_offset_(0.0, 0.0)
 {
+  pass_candidates_.push_back(Vector2d(0.0, 0.0));
+  for (unsigned int i = 1; i < NB_PASS_CANDIDATES; ++i)
+  {
+    double angle = 2.0 * M_PI * (i - 1) / (NB_PASS_CANDIDATES - 1);
+    pass_candidates_.push_back(Vector2d(PASS_CANDIDATES_RADIUS * std::cos(angle),
+                                        PASS_CANDIDATES_RADIUS * std::sin(angle)));
+  }
+  next_pass_candidate_ = pass_candidates_.size();
+
   // STATES
   machine_.addState(state_name::strike_search,
                     [this](const data::AiData& data, unsigned int run_number, unsigned int atomic_run_number) {
@@ -189,6 +207,9 @@ void AttaqueWithSupportMs::start(double time)
   machine_.start();
 
   behaviors_are_assigned_ = false;
+  pass_receiver_ = -1;
+  pass_anchor_fixed_ = false;
+  search_behavior_->clearTargetPosition();
 }
 void AttaqueWithSupportMs::stop(double time)
 {
@@ -199,6 +220,106 @@ void AttaqueWithSupportMs::update(double time)
 {
 }
 
+int AttaqueWithSupportMs::passReceiver()
+{
+  if (machine_.currentStates().empty())
+  {
+    return -1;
+  }
+  // the striker passes to the robot that searches a shoot area
+  const std::string& state = *machine_.currentStates().begin();
+  if (state == state_name::strike_search || state == state_name::pass_search)
+  {
+    return ID2_;
+  }
+  if (state == state_name::search_strike || state == state_name::search_pass)
+  {
+    return ID1_;
+  }
+  return -1;
+}
+
+/*
+ * The receiver searches a shoot area until the pass is prepared: the anchor follows it. Then the
+ * anchor is fixed and the receiver goes to the point of the pass.
+ */
+void AttaqueWithSupportMs::updatePassAnchor()
+{
+  int receiver = passReceiver();
+  if (receiver != pass_receiver_)
+  {
+    // the previous offsets were computed for the other robot
+    pass_receiver_ = receiver;
+    pass_offset_ = Vector2d(0.0, 0.0);
+    next_pass_candidate_ = pass_candidates_.size();
+    pass_anchor_fixed_ = false;
+  }
+  if (pass_receiver_ < 0)
+  {
+    return;
+  }
+  const std::string& state = *machine_.currentStates().begin();
+  bool passing = (state == state_name::pass_search || state == state_name::search_pass);
+  if (!passing)
+  {
+    pass_anchor_fixed_ = false;
+  }
+  if (!pass_anchor_fixed_)
+  {
+    pass_anchor_ = getRobot(pass_receiver_, Ally).getMovement().linearPosition(time());
+    pass_anchor_fixed_ = passing;
+  }
+}
+
+/*
+ * The point of the pass is chosen around the anchor: the one with the largest view of the
+ * opponent goal (the anchor on a tie). A round evaluates all the candidates over several ticks
+ * if the budget is short, the pass and the receiver use the best point of the last complete round.
+ */
+bool AttaqueWithSupportMs::refine(double time)
+{
+  updatePassAnchor();
+  if (pass_receiver_ < 0)
+  {
+    return false;
+  }
+  if (next_pass_candidate_ == pass_candidates_.size())
+  {
+    if (time == pass_round_time_)
+    {
+      // the round of this tick is complete
+      return false;
+    }
+    pass_round_time_ = time;
+    next_pass_candidate_ = 0;
+    round_best_score_ = -1.0;
+  }
+
+  unsigned int end = std::min<unsigned int>(next_pass_candidate_ + PASS_CANDIDATES_BY_STEP, pass_candidates_.size());
+  for (; next_pass_candidate_ < end; ++next_pass_candidate_)
+  {
+    const Vector2d& offset = pass_candidates_[next_pass_candidate_];
+    double score = findGoalBestMove(pass_anchor_ + offset, rhoban_geometry::Point(66, 66), pass_receiver_).second;
+    if (score > round_best_score_)
+    {
+      round_best_score_ = score;
+      round_best_offset_ = offset;
+    }
+  }
+
+  if (next_pass_candidate_ == pass_candidates_.size())
+  {
+    pass_offset_ = round_best_offset_;
+    return false;
+  }
+  return true;
+}
+
+rhoban_geometry::Point AttaqueWithSupportMs::passTarget() const
+{
+  return pass_anchor_ + pass_offset_;
+}
+
 void AttaqueWithSupportMs::assignBehaviorToRobots(
     std::function<void(int, std::shared_ptr<robot_behavior::RobotBehavior>)> assign_behavior, double time, double dt)
 {
@@ -212,6 +333,9 @@ void AttaqueWithSupportMs::assignBehaviorToRobots(
   machine_.run();
 
   std::string state = *machine_.currentStates().begin();
+  // the receiver goes to the point of the pass only while it is prepared
+  updatePassAnchor();
+  search_behavior_->clearTargetPosition();
   // DEBUG(machine.current_states());
   if (state == state_name::strike_search)
   {
@@ -227,7 +351,8 @@ void AttaqueWithSupportMs::assignBehaviorToRobots(
   {
     assign_behavior(ID1_, pass_behavior_);
     // pass_behavior->declare_robot_to_pass( ID2, Vision::Ally );
-    pass_behavior_->declarePointToStrike(robot_2_position_);
+    pass_behavior_->declarePointToStrike(passTarget());
+    search_behavior_->declareTargetPosition(passTarget());
     assign_behavior(ID2_, search_behavior_);
   }
   else if (state == state_name::search_pass)
@@ -235,7 +360,8 @@ void AttaqueWithSupportMs::assignBehaviorToRobots(
     assign_behavior(ID1_, search_behavior_);
     assign_behavior(ID2_, pass_behavior_);
     // pass_behavior->declare_robot_to_pass( ID1, Vision::Ally );
-    pass_behavior_->declarePointToStrike(robot_1_position_);
+    pass_behavior_->declarePointToStrike(passTarget());
+    search_behavior_->declareTargetPosition(passTarget());
   }
   else if (state == state_name::search_waitpass)
   {
@@ -299,35 +425,37 @@ bool AttaqueWithSupportMs::isDb1InfDb2()
 bool AttaqueWithSupportMs::isFgbmScoreInfSeuil_1()
 {
   DEBUG(fgbm_score_);
-  std::vector<int> vect_obstruct = getRobotInLine(robot_1_position_, robot_2_position_);
-  bool free_for_pass = vect_obstruct.empty();
+  bool free_for_pass = isPassSafe(ID2_);
   bool ready_for_pass = search_behavior_->well_positioned;
   return (fgbm_score_ < seuil_fgbm_) and free_for_pass and ready_for_pass;
 }
 bool AttaqueWithSupportMs::isFgbmScoreInfSeuil_2()
 {
   DEBUG(fgbm_score_);
-  std::vector<int> vect_obstruct = getRobotInLine(robot_2_position_, robot_1_position_);
-  bool free_for_pass = vect_obstruct.empty();
+  bool free_for_pass = isPassSafe(ID1_);
   bool ready_for_pass = search_behavior_->well_positioned;
   return (fgbm_score_ >= seuil_fgbm_ + fgbm_constante_) and free_for_pass and ready_for_pass;
 }
 
 bool AttaqueWithSupportMs::fgbmScoreSupSeuil_1PlusConstante()
 {
-  std::vector<int> vect_obstruct = getRobotInLine(robot_1_position_, robot_2_position_);
-  bool free_for_pass = vect_obstruct.empty();
+  bool free_for_pass = isPassSafe(ID2_);
   // bool ready_for_pass = search_behavior->well_positioned;
   return (fgbm_score_ >= seuil_fgbm_ + fgbm_constante_) or not(free_for_pass);
 }
 bool AttaqueWithSupportMs::fgbmScoreSupSeuil_2PlusConstante()
 {
-  std::vector<int> vect_obstruct = getRobotInLine(robot_2_position_, robot_1_position_);
-  bool free_for_pass = vect_obstruct.empty();
+  bool free_for_pass = isPassSafe(ID1_);
   // bool ready_for_pass = search_behavior->well_positioned;
   return (fgbm_score_ >= seuil_fgbm_ + fgbm_constante_) or not(free_for_pass);
 }
 
+bool AttaqueWithSupportMs::isPassSafe(int receiver)
+{
+  // no opponent can reach the ball before the receiver
+  return not findSafePasses({ receiver }).empty();
+}
+
 bool AttaqueWithSupportMs::isInfra_1On()
 {
   return infraRed(ID1_, Ally);
@@ -103,6 +103,27 @@ private:
   rhoban_geometry::Point robot_1_position_;
   rhoban_geometry::Point robot_2_position_;
 
+  // Anytime choice of the point of the pass, where the receiver goes (see refine()): the
+  // anchor and NB_PASS_CANDIDATES - 1 points around it, PASS_CANDIDATES_BY_STEP by step.
+  static constexpr unsigned int NB_PASS_CANDIDATES = 17;
+  static constexpr unsigned int PASS_CANDIDATES_BY_STEP = 4;
+  static constexpr double PASS_CANDIDATES_RADIUS = 0.3;
+  int pass_receiver_;
+  std::vector<Vector2d> pass_candidates_;
+  unsigned int next_pass_candidate_;
+  double pass_round_time_;
+  double round_best_score_;
+  Vector2d round_best_offset_;
+  // the receiver position, fixed while the pass is prepared so that the receiver doesn't drift
+  rhoban_geometry::Point pass_anchor_;
+  bool pass_anchor_fixed_;
+  // offset from the anchor of the best point of the last complete round
+  Vector2d pass_offset_;
+
+  int passReceiver();
+  void updatePassAnchor();
+  rhoban_geometry::Point passTarget() const;
+
 public:
   AttaqueWithSupportMs();
   virtual ~AttaqueWithSupportMs();
@@ -117,6 +138,7 @@ public:
   virtual void stop(double time);
 
   virtual void update(double time);
+  virtual bool refine(double time);
 
   virtual void assignBehaviorToRobots(
       std::function<void(int, std::shared_ptr<robot_behavior::RobotBehavior>)> assign_behavior, double time, double dt);
@@ -134,6 +156,8 @@ public:
   bool fgbmScoreSupSeuil_1PlusConstante();
   bool fgbmScoreSupSeuil_2PlusConstante();
 
+  bool isPassSafe(int receiver);
+
   bool isInfra_1On();
   bool isInfra_2On();
 
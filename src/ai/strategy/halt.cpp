@@ -56,11 +56,11 @@ void Halt::assignBehaviorToRobots(
 {
   if (haveToManageTheGoalie())
   {
-    assign_behavior(getGoalie(), std::shared_ptr<robot_behavior::RobotBehavior>(new robot_behavior::DoNothing()));
+    assign_behavior(getGoalie(), do_nothing_pool_.make());
   }
   for (int id : getPlayerIds())
   {
-    assign_behavior(id, std::shared_ptr<robot_behavior::RobotBehavior>(new robot_behavior::DoNothing()));
+    assign_behavior(id, do_nothing_pool_.make());
   }
 }
 
@@ -20,6 +20,8 @@
 #pragma once
 
 #include "strategy.h"
+#include <core/object_pool.h>
+#include <robot_behavior/do_nothing.h>
 #include <string>
 
 namespace rhoban_ssl
@@ -28,6 +30,10 @@ namespace strategy
 {
 class Halt : public Strategy
 {
+private:
+  // the robots are reassigned at each tick
+  ObjectPool<robot_behavior::DoNothing> do_nothing_pool_;
+
 public:
   Halt();
 
@@ -60,7 +60,7 @@ const std::string KeeperStrat::name = "goalie_strat";
 void KeeperStrat::start(double time)
 {
   DEBUG("START KEEPER STRAT");
-  goalie_ = std::shared_ptr<robot_behavior::Keeper>(new robot_behavior::Keeper());
+  goalie_ = goalie_pool_.make();
   behaviors_are_assigned_ = false;
 }
 void KeeperStrat::stop(double time)
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "../strategy.h"
+#include <core/object_pool.h>
 #include <robot_behavior/keeper/clearer.h>
 #include <robot_behavior/keeper/keeper.h>
 
@@ -33,6 +34,7 @@ private:
   bool behaviors_are_assigned_;
   std::shared_ptr<robot_behavior::keeper::Clearer> clearer_;
   std::shared_ptr<robot_behavior::Keeper> goalie_;
+  ObjectPool<robot_behavior::Keeper> goalie_pool_;
 
 public:
   KeeperStrat();
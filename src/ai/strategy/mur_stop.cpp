@@ -78,16 +78,16 @@ void MurStop::update(double time)
 void MurStop::assignBehaviorToRobots(
     std::function<void(int, std::shared_ptr<robot_behavior::RobotBehavior>)> assign_behavior, double time, double dt)
 {
-  std::shared_ptr<robot_behavior::RobotBehavior> mur1(new robot_behavior::KickWall(1));
-  static_cast<robot_behavior::KickWall*>(mur1.get())->declareMurRobotId(0, 2);
-
-  std::shared_ptr<robot_behavior::RobotBehavior> mur2(new robot_behavior::KickWall(1));
-  static_cast<robot_behavior::KickWall*>(mur2.get())->declareMurRobotId(1, 2);
-
   if (not(behaviors_are_assigned_))
   {
     assert(getPlayerIds().size() == 2);
 
+    std::shared_ptr<robot_behavior::KickWall> mur1 = wall_pool_.make(1);
+    mur1->declareMurRobotId(0, 2);
+
+    std::shared_ptr<robot_behavior::KickWall> mur2 = wall_pool_.make(1);
+    mur2->declareMurRobotId(1, 2);
+
     assign_behavior(playerId(0), mur1);
     assign_behavior(playerId(1), mur2);
 
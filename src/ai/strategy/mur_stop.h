@@ -20,6 +20,8 @@
 #pragma once
 
 #include "strategy.h"
+#include <core/object_pool.h>
+#include <robot_behavior/defender/kick_wall.h>
 
 namespace rhoban_ssl
 {
@@ -31,6 +33,7 @@ private:
   bool behaviors_are_assigned_;
   bool is_closest_0_;
   bool is_closest_1_;
+  ObjectPool<robot_behavior::KickWall> wall_pool_;
 
 public:
   MurStop();
@@ -59,8 +59,8 @@ const std::string Offensive::name = "offensive";
 void Offensive::start(double time)
 {
   DEBUG("START PREPARE KICKOFF");
-  search_ = std::shared_ptr<robot_behavior::SearchShootArea>(new robot_behavior::SearchShootArea());
-  striker_ = std::shared_ptr<robot_behavior::Striker>(new robot_behavior::Striker());
+  search_ = search_pool_.make();
+  striker_ = striker_pool_.make();
   behaviors_are_assigned_ = false;
 }
 void Offensive::stop(double time)
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "strategy.h"
+#include <core/object_pool.h>
 
 #include <robot_behavior/striker.h>
 #include <robot_behavior/search_shoot_area.h>
@@ -35,6 +36,8 @@ private:
   bool is_closest_;
   std::shared_ptr<robot_behavior::SearchShootArea> search_;
   std::shared_ptr<robot_behavior::Striker> striker_;
+  ObjectPool<robot_behavior::SearchShootArea> search_pool_;
+  ObjectPool<robot_behavior::Striker> striker_pool_;
 
   rhoban_geometry::Point relative2absolute(double x, double y) const;
 
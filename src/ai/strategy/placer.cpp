@@ -63,20 +63,20 @@ void Placer::assignBehaviorToRobots(
   {
     if (haveToManageTheGoalie())
     {
-      robot_behavior::ConsignFollower* follower =
-          robot_behavior::Factory::fixedConsignFollower(goalie_linear_position_, goalie_angular_position_);
+      std::shared_ptr<robot_behavior::ConsignFollower> follower = robot_behavior::Factory::fixedConsignFollower(
+          follower_pool_, goalie_linear_position_, goalie_angular_position_);
       follower->avoidTheBall(true);
-      assign_behavior(getGoalie(), std::shared_ptr<robot_behavior::RobotBehavior>(follower));
+      assign_behavior(getGoalie(), follower);
     }
 
     int nb_players = getPlayerIds().size();
     for (int i = 0; i < nb_players; i++)
     {
       int id = playerId(i);
-      robot_behavior::ConsignFollower* follower =
-          robot_behavior::Factory::fixedConsignFollower(player_positions_[id].first, player_positions_[id].second);
+      std::shared_ptr<robot_behavior::ConsignFollower> follower = robot_behavior::Factory::fixedConsignFollower(
+          follower_pool_, player_positions_[id].first, player_positions_[id].second);
       follower->avoidTheBall(true);
-      assign_behavior(id, std::shared_ptr<robot_behavior::RobotBehavior>(follower));
+      assign_behavior(id, follower);
     }
     behavior_has_been_assigned = true;
   }
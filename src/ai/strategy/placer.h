@@ -23,6 +23,8 @@
 #include <string>
 #include <list>
 #include <robot_behavior/robot_behavior.h>
+#include <robot_behavior/factory.h>
+#include <core/object_pool.h>
 
 namespace rhoban_ssl
 {
@@ -46,6 +48,9 @@ private:
   std::pair<rhoban_geometry::Point, ContinuousAngle> starting_position_for_goalie_;
   bool goalie_is_defined_;
 
+  // the robots are placed again at each referee command
+  ObjectPool<robot_behavior::NavigationInsideTheField> follower_pool_;
+
 public:
   virtual bool getStartingPositionForGoalie(rhoban_geometry::Point& linear_position,
                                             ContinuousAngle& angular_position) const;
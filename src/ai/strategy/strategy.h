@@ -84,6 +84,20 @@ public:
   virtual void pause(double time){};
   virtual void resume(double time){};
 
+  /*
+   * Anytime decision: runs one short step of the refinement of the
+   * decision of the strategy and returns true if it can still be refined.
+   *
+   * The manager calls it after update() until the time budget of the tick
+   * is spent (see ai::Config::refinement_budget), and the unfinished
+   * refinement goes on at the next tick. assignBehaviorToRobots() uses
+   * the best decision found so far.
+   */
+  virtual bool refine(double time)
+  {
+    return false;
+  };
+
   /*
    * Return a list of position where it is recommended to place a
    * robot before starting the strategy.
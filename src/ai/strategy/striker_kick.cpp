@@ -65,7 +65,7 @@ void StrikerKick::start(double time)
   DEBUG("START PREPARE KICKOFF");
   behaviors_are_assigned_ = false;
 
-  slow_striker_ = std::shared_ptr<robot_behavior::SlowStriker>(new robot_behavior::SlowStriker());
+  slow_striker_ = slow_striker_pool_.make();
 }
 void StrikerKick::stop(double time)
 {
@@ -21,6 +21,7 @@
 
 #include <robot_behavior/slow_striker.h>
 #include "strategy.h"
+#include <core/object_pool.h>
 
 namespace rhoban_ssl
 {
@@ -31,6 +32,7 @@ class StrikerKick : public Strategy
 private:
   bool behaviors_are_assigned_;
   std::shared_ptr<robot_behavior::SlowStriker> slow_striker_;
+  ObjectPool<robot_behavior::SlowStriker> slow_striker_pool_;
 
 public:
   StrikerKick();
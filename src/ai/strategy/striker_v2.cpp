@@ -65,7 +65,7 @@ void StrikerV2::start(double time)
   DEBUG("START PREPARE KICKOFF");
   behaviors_are_assigned_ = false;
 
-  striker_ = std::shared_ptr<robot_behavior::Striker>(new robot_behavior::Striker());
+  striker_ = striker_pool_.make();
 }
 void StrikerV2::stop(double time)
 {
@@ -21,6 +21,7 @@
 
 #include <robot_behavior/striker.h>
 #include "strategy.h"
+#include <core/object_pool.h>
 
 namespace rhoban_ssl
 {
@@ -31,6 +32,7 @@ class StrikerV2 : public Strategy
 private:
   bool behaviors_are_assigned_;
   std::shared_ptr<robot_behavior::Striker> striker_;
+  ObjectPool<robot_behavior::Striker> striker_pool_;
 
 public:
   StrikerV2();
@@ -32,8 +32,6 @@ class Caterpillar : public Strategy
 private:
   bool behaviors_are_assigned_;
 
-  int CATERPILLAR_SIZE = 6;
-
   std::shared_ptr<robot_behavior::beginner::GotoBall> head_ball_;
   std::shared_ptr<robot_behavior::GoToXY> head_path_;
 
@@ -45,6 +43,8 @@ private:
   int path_index_;
 
 public:
+  static constexpr int CATERPILLAR_SIZE = 6;
+
   Caterpillar();
   Caterpillar(std::vector<rhoban_geometry::Point> path);
   virtual ~Caterpillar();
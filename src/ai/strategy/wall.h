@@ -20,6 +20,8 @@
 #pragma once
 
 #include "strategy.h"
+#include <core/object_pool.h>
+#include <robot_behavior/defender/defensive_wall.h>
 
 namespace rhoban_ssl
 {
@@ -29,6 +31,7 @@ class Wall : public Strategy
 {
 private:
   bool behaviors_are_assigned_;
+  ObjectPool<robot_behavior::DefensiveWall> wall_pool_;
 
 public:
   Wall();
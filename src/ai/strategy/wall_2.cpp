@@ -118,11 +118,11 @@ void Wall_2::assignBehaviorToRobots(
 {
   if (not(behaviors_are_assigned_) && (is_closest_0_ == false && is_closest_1_ == false))
   {
-    std::shared_ptr<robot_behavior::RobotBehavior> wall1(new robot_behavior::DefensiveWall(1));
-    static_cast<robot_behavior::DefensiveWall*>(wall1.get())->declareWallRobotId(0, 2);
+    std::shared_ptr<robot_behavior::DefensiveWall> wall1 = wall_pool_.make(1);
+    wall1->declareWallRobotId(0, 2);
 
-    std::shared_ptr<robot_behavior::RobotBehavior> wall2(new robot_behavior::DefensiveWall(1));
-    static_cast<robot_behavior::DefensiveWall*>(wall2.get())->declareWallRobotId(1, 2);
+    std::shared_ptr<robot_behavior::DefensiveWall> wall2 = wall_pool_.make(1);
+    wall2->declareWallRobotId(1, 2);
 
     assert(getPlayerIds().size() == 2);
 
@@ -134,15 +134,13 @@ void Wall_2::assignBehaviorToRobots(
 
   if (is_closest_0_ == true && is_closest_1_ == false && striker_are_assigned_0 == true)
   {
-    std::shared_ptr<robot_behavior::RobotBehavior> striker0(new robot_behavior::Striker_todo_rectum());
-    assign_behavior(playerId(0), striker0);
+    assign_behavior(playerId(0), striker_pool_.make());
     striker_are_assigned_0 = true;
     behaviors_are_assigned_ = false;
   }
   if (is_closest_0_ == false && is_closest_1_ == true && striker_are_assigned_1 == true)
   {
-    std::shared_ptr<robot_behavior::RobotBehavior> striker1(new robot_behavior::Striker_todo_rectum());
-    assign_behavior(playerId(1), striker1);
+    assign_behavior(playerId(1), striker_pool_.make());
     striker_are_assigned_1 = true;
     behaviors_are_assigned_ = false;
   }
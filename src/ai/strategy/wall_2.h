@@ -20,6 +20,9 @@
 #pragma once
 
 #include "strategy.h"
+#include <core/object_pool.h>
+#include <robot_behavior/defender/defensive_wall.h>
+#include <robot_behavior/Striker_todo_rectum.h>
 
 namespace rhoban_ssl
 {
@@ -35,6 +38,9 @@ private:
   bool is_closest_0_ = false;
   bool is_closest_1_= false;
 
+  ObjectPool<robot_behavior::DefensiveWall> wall_pool_;
+  ObjectPool<robot_behavior::Striker_todo_rectum> striker_pool_;
+
 public:
   Wall_2();
   virtual ~Wall_2();
@@ -92,26 +92,21 @@ void Wall2Passif::update(double time)
 void Wall2Passif::assignBehaviorToRobots(
     std::function<void(int, std::shared_ptr<robot_behavior::RobotBehavior>)> assign_behavior, double time, double dt)
 {
-  std::shared_ptr<robot_behavior::RobotBehavior> wall1(new robot_behavior::DefensiveWall(1));
-  static_cast<robot_behavior::DefensiveWall*>(wall1.get())->declareWallRobotId(0, 2);
-
-  std::shared_ptr<robot_behavior::RobotBehavior> wall2(new robot_behavior::DefensiveWall(1));
-  static_cast<robot_behavior::DefensiveWall*>(wall2.get())->declareWallRobotId(1, 2);
-
   if (not(behaviors_are_assigned_))
   {
     assert(getPlayerIds().size() == 2);
 
+    std::shared_ptr<robot_behavior::DefensiveWall> wall1 = wall_pool_.make(1);
+    wall1->declareWallRobotId(0, 2);
+
+    std::shared_ptr<robot_behavior::DefensiveWall> wall2 = wall_pool_.make(1);
+    wall2->declareWallRobotId(1, 2);
+
     assign_behavior(playerId(0), wall1);
     assign_behavior(playerId(1), wall2);
 
     behaviors_are_assigned_ = true;
   }
-  else
-  {
-    assign_behavior(playerId(0), wall1);
-    assign_behavior(playerId(1), wall2);
-  }
 }
 
 // We declare here the starting positions that are used to :
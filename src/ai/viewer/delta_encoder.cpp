@@ -0,0 +1,227 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "delta_encoder.h"
+#include <cmath>
+#include <cstring>
+
+namespace rhoban_ssl
+{
+namespace viewer
+{
+namespace
+{
+inline int32_t quantize(double value, double scale)
+{
+  return static_cast<int32_t>(std::lround(value * scale));
+}
+
+bool operator==(const DeltaEncoder::QuantizedRobot& a, const DeltaEncoder::QuantizedRobot& b)
+{
+  return a.x == b.x && a.y == b.y && a.dir == b.dir && a.vx == b.vx && a.vy == b.vy && a.vtheta == b.vtheta;
+}
+
+bool operator==(const DeltaEncoder::RobotStatus& a, const DeltaEncoder::RobotStatus& b)
+{
+  return a.is_present == b.is_present && std::strcmp(a.behavior, b.behavior) == 0 && a.alive == b.alive &&
+         a.voltage == b.voltage && a.cap_volt == b.cap_volt && a.ir_triggered == b.ir_triggered &&
+         a.driver_error == b.driver_error;
+}
+
+bool operator==(const DeltaEncoder::QuantizedBall& a, const DeltaEncoder::QuantizedBall& b)
+{
+  return a.x == b.x && a.y == b.y && a.vx == b.vx && a.vy == b.vy;
+}
+}  // namespace
+
+DeltaEncoder::DeltaEncoder(unsigned int keyframe_period)
+  : keyframe_period_(keyframe_period), frame_(0), has_previous_(false), annotations_hash_(0), nb_keyframes_(0)
+{
+}
+
+void DeltaEncoder::reset()
+{
+  has_previous_ = false;
+}
+
+unsigned long DeltaEncoder::nbKeyframes() const
+{
+  return nb_keyframes_;
+}
+
+DeltaEncoder::QuantizedRobot DeltaEncoder::quantize(const snapshot::Robot& robot)
+{
+  QuantizedRobot q;
+  q.x = viewer::quantize(robot.x, 1000.0);
+  q.y = viewer::quantize(robot.y, 1000.0);
+  q.dir = viewer::quantize(robot.orientation, 1000.0);
+  q.vx = viewer::quantize(robot.vx, 100.0);
+  q.vy = viewer::quantize(robot.vy, 100.0);
+  q.vtheta = viewer::quantize(robot.vtheta, 100.0);
+  return q;
+}
+
+DeltaEncoder::RobotStatus DeltaEncoder::status(const snapshot::Robot& robot, bool has_ai)
+{
+  RobotStatus s;
+  s.is_present = robot.is_present;
+  snapshot::copyName(s.behavior, has_ai ? robot.behavior : "noai");
+  s.alive = robot.electronics.alive;
+  s.voltage = viewer::quantize(robot.electronics.voltage, 10.0);
+  s.cap_volt = viewer::quantize(robot.electronics.cap_volt, 1.0);
+  s.ir_triggered = robot.electronics.ir_triggered;
+  s.driver_error = robot.electronics.driver_error;
+  return s;
+}
+
+DeltaEncoder::QuantizedBall DeltaEncoder::quantize(const snapshot::Ball& ball)
+{
+  QuantizedBall q;
+  q.x = viewer::quantize(ball.x, 1000.0);
+  q.y = viewer::quantize(ball.y, 1000.0);
+  q.vx = viewer::quantize(ball.vx, 100.0);
+  q.vy = viewer::quantize(ball.vy, 100.0);
+  return q;
+}
+
+void DeltaEncoder::encode(const ViewerSnapshot& snapshot, const viewer_proto::GamePacket& game, bool force_keyframe,
+                          viewer_proto::DeltaPacket& delta)
+{
+  bool keyframe = force_keyframe || !has_previous_ || (keyframe_period_ > 0 && frame_ % keyframe_period_ == 0);
+  if (keyframe)
+  {
+    // the next keyframe is one period after this one.
+    frame_ = 0;
+    nb_keyframes_++;
+  }
+  delta.set_keyframe(keyframe);
+  delta.set_frame(frame_);
+
+  // game description, without the statistics and the clocks that change every frame: the client
+  // gets their new values with the next change of the game or the next keyframe.
+  viewer_proto::GamePacket stable_game = game;
+  viewer_proto::Informations& informations = *stable_game.mutable_information();
+  informations.clear_packetspersecond();
+  informations.clear_snapshotduration();
+  informations.clear_serializationduration();
+  informations.clear_supersededsnapshots();
+  informations.clear_refinementduration();
+  informations.clear_refinementpending();
+  informations.clear_json();
+  informations.clear_protobuf();
+  informations.clear_delta();
+  informations.clear_clients();
+  informations.clear_radio();
+  stable_game.mutable_referee()->clear_stageremainingtime();
+  for (viewer_proto::TeamInfo* team : { stable_game.mutable_allies(), stable_game.mutable_opponents() })
+  {
+    team->clear_timeoutremainingtime();
+    team->clear_yellowcardtimes();
+  }
+  std::string game_bytes = stable_game.SerializeAsString();
+  if (keyframe || game_bytes != game_)
+  {
+    *delta.mutable_game() = game;
+    game_.swap(game_bytes);
+  }
+
+  for (uint team_id = 0; team_id < 2; team_id++)
+  {
+    bool ally_info = (team_id == Ally);
+    for (uint rid = 0; rid < ai::Config::NB_OF_ROBOTS_BY_TEAM; rid++)
+    {
+      const snapshot::Robot& robot = snapshot.teams[team_id].bots[rid];
+
+      QuantizedRobot q = quantize(robot);
+      if (keyframe || !(q == robots_[team_id][rid]))
+      {
+        viewer_proto::QuantizedRobot& proto_robot = *delta.add_robot();
+        proto_robot.set_robot_id(robot.number);
+        proto_robot.set_isally(ally_info);
+        proto_robot.set_x(q.x);
+        proto_robot.set_y(q.y);
+        proto_robot.set_dir(q.dir);
+        proto_robot.set_vx(q.vx);
+        proto_robot.set_vy(q.vy);
+        proto_robot.set_vtheta(q.vtheta);
+        robots_[team_id][rid] = q;
+      }
+
+      RobotStatus s = status(robot, snapshot.ai.has_ai);
+      if (keyframe || !(s == status_[team_id][rid]))
+      {
+        viewer_proto::Robot& proto_status = *delta.add_status();
+        proto_status.set_robot_id(robot.number);
+        proto_status.set_isally(ally_info);
+        proto_status.set_ispresent(robot.is_present);
+        proto_status.set_x(robot.x);
+        proto_status.set_y(robot.y);
+        proto_status.set_dir(robot.orientation);
+        proto_status.set_time(robot.time);
+        if (ally_info)
+        {
+          proto_status.set_behavior(s.behavior);
+          if (!snapshot.informations.simulation)
+          {
+            const snapshot::Electronics& electronics = robot.electronics;
+            viewer_proto::Electronics& proto_electronics = *proto_status.mutable_electronics();
+            proto_electronics.set_alive(electronics.alive);
+            proto_electronics.set_voltage(electronics.voltage);
+            proto_electronics.set_capvolt(electronics.cap_volt);
+            proto_electronics.set_irtriggered(electronics.ir_triggered);
+            proto_electronics.set_odometryx(electronics.odometry_x);
+            proto_electronics.set_odometryy(electronics.odometry_y);
+            proto_electronics.set_odometryorientation(electronics.odometry_orientation);
+            proto_electronics.set_drivererror(electronics.driver_error);
+          }
+        }
+        status_[team_id][rid] = s;
+      }
+    }
+  }
+
+  QuantizedBall ball = quantize(snapshot.ball);
+  if (keyframe || !(ball == ball_))
+  {
+    delta.set_ballchanged(true);
+    viewer_proto::QuantizedBall& proto_ball = *delta.mutable_ball();
+    proto_ball.set_x(ball.x);
+    proto_ball.set_y(ball.y);
+    proto_ball.set_vx(ball.vx);
+    proto_ball.set_vy(ball.vy);
+    ball_ = ball;
+  }
+
+  if (snapshot.ai.has_ai)
+  {
+    uint64_t annotations_hash = snapshot.annotations.hash();
+    delta.set_annotationshash(annotations_hash);
+    if (keyframe || annotations_hash != annotations_hash_)
+    {
+      snapshot.annotations.toProtobuf(*delta.mutable_annotations());
+      annotations_hash_ = annotations_hash;
+    }
+  }
+
+  has_previous_ = true;
+  frame_++;
+}
+
+}  // namespace viewer
+}  // namespace rhoban_ssl
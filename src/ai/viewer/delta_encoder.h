@@ -0,0 +1,118 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "viewer_snapshot.h"
+#include <delta_packet.pb.h>
+#include <cstdint>
+#include <string>
+
+namespace rhoban_ssl
+{
+namespace viewer
+{
+/**
+ * @brief The DeltaEncoder turns successive snapshots into keyframes and deltas.
+ *
+ * It remembers what has been sent (at the quantization precision) and only
+ * puts in a delta the robots, the ball, the game description and the annotations
+ * that changed since the previous frame:
+ *  - positions are sent in millimeters and angles in milliradians,
+ *  - velocities in centimeters by second and angular velocities in centiradians by second,
+ *  - the annotations are sent as a 64 bits hash when they did not change.
+ *
+ * A keyframe contains everything, it is sent every keyframe_period frames
+ * or when requested (a new client), so a client that misses a delta recovers quickly.
+ */
+class DeltaEncoder
+{
+public:
+  static constexpr unsigned int DEFAULT_KEYFRAME_PERIOD = 60;
+
+  struct QuantizedRobot
+  {
+    int32_t x;
+    int32_t y;
+    int32_t dir;
+    int32_t vx;
+    int32_t vy;
+    int32_t vtheta;
+  };
+
+  struct RobotStatus
+  {
+    bool is_present;
+    char behavior[snapshot::NAME_SIZE];
+    bool alive;
+    int voltage;   // decivolts
+    int cap_volt;  // volts
+    bool ir_triggered;
+    bool driver_error;
+  };
+
+  struct QuantizedBall
+  {
+    int32_t x;
+    int32_t y;
+    int32_t vx;
+    int32_t vy;
+  };
+
+private:
+  unsigned int keyframe_period_;
+  unsigned int frame_;
+  bool has_previous_;
+
+  QuantizedRobot robots_[2][ai::Config::NB_OF_ROBOTS_BY_TEAM];
+  RobotStatus status_[2][ai::Config::NB_OF_ROBOTS_BY_TEAM];
+  QuantizedBall ball_;
+  std::string game_;
+  uint64_t annotations_hash_;
+
+  unsigned long nb_keyframes_;
+
+public:
+  DeltaEncoder(unsigned int keyframe_period = DEFAULT_KEYFRAME_PERIOD);
+
+  /**
+   * @brief Fills a delta (or a keyframe) from a snapshot.
+   *
+   * @param snapshot the snapshot to encode
+   * @param game the full game description of the snapshot, only copied in the delta
+   * when its content changed (the statistics and the clocks that change every frame are ignored)
+   * @param force_keyframe true to send everything
+   * @param delta the packet to fill
+   */
+  void encode(const ViewerSnapshot& snapshot, const viewer_proto::GamePacket& game, bool force_keyframe,
+              viewer_proto::DeltaPacket& delta);
+
+  /**
+   * @brief Forgets what has been sent, the next frame will be a keyframe.
+   */
+  void reset();
+
+  unsigned long nbKeyframes() const;
+
+  static QuantizedRobot quantize(const snapshot::Robot& robot);
+  static RobotStatus status(const snapshot::Robot& robot, bool has_ai);
+  static QuantizedBall quantize(const snapshot::Ball& ball);
+};
+
+}  // namespace viewer
+}  // namespace rhoban_ssl
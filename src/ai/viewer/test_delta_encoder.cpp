@@ -0,0 +1,134 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+
+#include "delta_encoder.h"
+
+using namespace rhoban_ssl::viewer;
+
+namespace
+{
+viewer_proto::GamePacket game(double time)
+{
+  viewer_proto::GamePacket game;
+  game.mutable_field()->set_fieldlength(12.0);
+  game.mutable_allies()->set_name("ally");
+  game.mutable_allies()->set_timeoutremainingtime(300 - time);
+  game.mutable_allies()->add_yellowcardtimes(120 - time);
+  game.mutable_opponents()->set_name("opponent");
+  game.mutable_referee()->set_stage("NORMAL_FIRST_HALF");
+  game.mutable_referee()->set_stageremainingtime(600 - time);
+  viewer_proto::Informations& informations = *game.mutable_information();
+  informations.set_packetspersecond(60.0 + time);
+  informations.set_snapshotduration(0.001 * time);
+  informations.set_serializationduration(0.002 * time);
+  informations.mutable_delta()->set_bytes(100 + time);
+  return game;
+}
+}  // namespace
+
+TEST(test_delta_encoder, game_is_sent_when_it_changes)
+{
+  ViewerSnapshot snapshot = ViewerSnapshot();
+  DeltaEncoder encoder(0);
+
+  viewer_proto::DeltaPacket delta;
+  encoder.encode(snapshot, game(0), false, delta);
+  EXPECT_TRUE(delta.keyframe());
+  EXPECT_TRUE(delta.has_game());
+
+  // only the statistics and the clocks change
+  for (int time = 1; time < 10; ++time)
+  {
+    delta.Clear();
+    encoder.encode(snapshot, game(time), false, delta);
+    EXPECT_FALSE(delta.keyframe());
+    EXPECT_FALSE(delta.has_game()) << "time " << time;
+  }
+
+  viewer_proto::GamePacket scored = game(10);
+  scored.mutable_allies()->set_score(1);
+  delta.Clear();
+  encoder.encode(snapshot, scored, false, delta);
+  ASSERT_TRUE(delta.has_game());
+  EXPECT_EQ(delta.game().allies().score(), 1u);
+  // the whole game is sent, with the current clocks
+  EXPECT_EQ(delta.game().referee().stageremainingtime(), 590);
+
+  delta.Clear();
+  encoder.encode(snapshot, scored, false, delta);
+  EXPECT_FALSE(delta.has_game());
+}
+
+TEST(test_delta_encoder, keyframes)
+{
+  ViewerSnapshot snapshot = ViewerSnapshot();
+  DeltaEncoder encoder(4);
+
+  for (int frame = 0; frame < 9; ++frame)
+  {
+    viewer_proto::DeltaPacket delta;
+    encoder.encode(snapshot, game(0), false, delta);
+    EXPECT_EQ(delta.keyframe(), frame % 4 == 0);
+    EXPECT_EQ(delta.has_game(), frame % 4 == 0);
+    EXPECT_EQ(delta.ballchanged(), frame % 4 == 0);
+  }
+  EXPECT_EQ(encoder.nbKeyframes(), 3u);
+
+  viewer_proto::DeltaPacket delta;
+  encoder.encode(snapshot, game(0), true, delta);
+  EXPECT_TRUE(delta.keyframe());
+  EXPECT_EQ(encoder.nbKeyframes(), 4u);
+}
+
+TEST(test_delta_encoder, only_the_changes_are_sent)
+{
+  ViewerSnapshot snapshot = ViewerSnapshot();
+  DeltaEncoder encoder(0);
+  viewer_proto::DeltaPacket delta;
+  encoder.encode(snapshot, game(0), false, delta);
+
+  // below the quantization
+  snapshot.ball.x = 0.0004;
+  snapshot.teams[rhoban_ssl::Ally].bots[2].x = 0.0004;
+  delta.Clear();
+  encoder.encode(snapshot, game(0), false, delta);
+  EXPECT_FALSE(delta.ballchanged());
+  EXPECT_EQ(delta.robot_size(), 0);
+
+  snapshot.ball.x = 1.0;
+  snapshot.teams[rhoban_ssl::Ally].bots[2].number = 2;
+  snapshot.teams[rhoban_ssl::Ally].bots[2].y = -0.5;
+  delta.Clear();
+  encoder.encode(snapshot, game(0), false, delta);
+  EXPECT_TRUE(delta.ballchanged());
+  EXPECT_EQ(delta.ball().x(), 1000);
+  ASSERT_EQ(delta.robot_size(), 1);
+  EXPECT_EQ(delta.robot(0).robot_id(), 2u);
+  EXPECT_TRUE(delta.robot(0).isally());
+  EXPECT_EQ(delta.robot(0).y(), -500);
+  EXPECT_EQ(delta.status_size(), 0);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
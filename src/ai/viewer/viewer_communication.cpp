@@ -21,13 +21,20 @@
 #include <manager/factory.h>
 #include <core/collection.h>
 #include <annotations/annotations.h>
+#include <com/ai_commander.h>
+#include <algorithm>
+#include <chrono>
 
 namespace rhoban_ssl
 {
 namespace viewer
 {
-ViewerCommunication::ViewerCommunication(ai::AI* ai) : ai_(ai), last_sending_time_(Data::get()->time.now())
+ViewerCommunication::ViewerCommunication(ai::AI* ai)
+  : ai_(ai), last_sending_time_(Data::get()->time.now()), described_manager_(nullptr), last_snapshot_time_(0.0)
 {
+  ai_description_.has_ai = false;
+  ai_description_.nb_strategies_used = 0;
+  ai_description_.nb_strategies = 0;
 }
 
 bool ViewerCommunication::runTask()
@@ -137,10 +144,7 @@ void ViewerCommunication::processIncomingPackets()
                             << "intrument " << n.instrument << std::endl
                             << "duration " << n.duration_in_ms << std::endl
                             << std::endl);
-      if (Data::get()->commander->real_ != nullptr)
-      {
-        Data::get()->commander->real_->addMusicPacket(n.robot_number, parseNoteToMusicPacket(n));
-      }
+      Data::get()->commander->addMusicPacket(n.robot_number, parseNoteToMusicPacket(n));
     }
     else
     {
@@ -153,198 +157,189 @@ void ViewerCommunication::processIncomingPackets()
 
 void ViewerCommunication::sendViewerPackets()
 {
+  using std::chrono::high_resolution_clock;
+  high_resolution_clock::time_point start = high_resolution_clock::now();
+
+  ViewerSnapshot& snapshot = serializer_.backBuffer();
+  snapshot.time = Data::get()->time.now();
+  snapshot.we_are_blue = ai::Config::we_are_blue;
+  snapshot.robot_radius = ai::Config::robot_radius;
+
   // GlobalData status
-  viewer::ViewerDataGlobal::get().packets_to_send.push(fieldPacket());
-  viewer::ViewerDataGlobal::get().packets_to_send.push(ballPacket());
-  viewer::ViewerDataGlobal::get().packets_to_send.push(teamsPacket());
-  viewer::ViewerDataGlobal::get().packets_to_send.push(refereePacket());
-  viewer::ViewerDataGlobal::get().packets_to_send.push(informationsPacket());
-  viewer::ViewerDataGlobal::get().packets_to_send.push(aiPacket());
-  viewer::ViewerDataGlobal::get().packets_to_send.push(annotationsPacket());
+  fillField(snapshot);
+  fillBall(snapshot);
+  fillTeams(snapshot);
+  fillReferee(snapshot);
+  fillInformations(snapshot);
+  fillAi(snapshot);
+  fillAnnotations(snapshot);
+
+  serializer_.publish();
+
+  last_snapshot_time_ =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(high_resolution_clock::now() - start).count() / 1e9;
 }
 
-Json::Value ViewerCommunication::fieldPacket()
+void ViewerCommunication::fillField(ViewerSnapshot& snapshot)
 {
-  Json::Value packet;
   const data::Field& field = Data::get()->field;
 
-  packet["field"]["length"] = field.field_length;
-  packet["field"]["width"] = field.field_width;
-  packet["field"]["boundary_width"] = field.boundary_width;
-  packet["field"]["goal"]["width"] = field.goal_width;
-  packet["field"]["goal"]["depth"] = field.goal_depth;
-  packet["field"]["penalty_area"]["width"] = field.penalty_area_width;
-  packet["field"]["penalty_area"]["depth"] = field.penalty_area_depth;
-  packet["field"]["circle"]["x"] = field.circle_center.getCenter().getX();
-  packet["field"]["circle"]["y"] = field.circle_center.getCenter().getY();
-  packet["field"]["circle"]["radius"] = field.circle_center.getRadius();
-
-  return packet;
+  snapshot.field.length = field.field_length;
+  snapshot.field.width = field.field_width;
+  snapshot.field.boundary_width = field.boundary_width;
+  snapshot.field.goal_width = field.goal_width;
+  snapshot.field.goal_depth = field.goal_depth;
+  snapshot.field.penalty_area_width = field.penalty_area_width;
+  snapshot.field.penalty_area_depth = field.penalty_area_depth;
+  snapshot.field.circle_x = field.circle_center.getCenter().getX();
+  snapshot.field.circle_y = field.circle_center.getCenter().getY();
+  snapshot.field.circle_radius = field.circle_center.getRadius();
 }
 
-Json::Value ViewerCommunication::ballPacket()
+void ViewerCommunication::fillBall(ViewerSnapshot& snapshot)
 {
-  Json::Value packet;
-
-  const rhoban_geometry::Point& ball_position = Data::get()->ball.getMovement().linearPosition(Data::get()->time.now());
-  packet["ball"]["position"]["x"] = ball_position.getX();
-  packet["ball"]["position"]["y"] = ball_position.getY();
+  const rhoban_geometry::Point& ball_position = Data::get()->ball.getMovement().linearPosition(snapshot.time);
+  snapshot.ball.x = ball_position.getX();
+  snapshot.ball.y = ball_position.getY();
 
-  const Vector2d& ball_velocity = Data::get()->ball.getMovement().linearVelocity(Data::get()->time.now());
-  packet["ball"]["velocity"]["x"] = ball_velocity.getX();
-  packet["ball"]["velocity"]["y"] = ball_velocity.getY();
+  const Vector2d& ball_velocity = Data::get()->ball.getMovement().linearVelocity(snapshot.time);
+  snapshot.ball.vx = ball_velocity.getX();
+  snapshot.ball.vy = ball_velocity.getY();
 
-  packet["ball"]["radius"] = ai::Config::ball_radius;
-
-  return packet;
+  snapshot.ball.radius = ai::Config::ball_radius;
 }
 
-Json::Value ViewerCommunication::teamsPacket()
+void ViewerCommunication::fillTeams(ViewerSnapshot& snapshot)
 {
-  Json::Value packet;
-  double time = Data::get()->time.now();
+  double time = snapshot.time;
   const data::Referee& referee = Data::get()->referee;
 
-  const std::string blue_color = "#2393c6";
-  const std::string yellow_color = "#dbdd56";
-
   for (uint team_id = 0; team_id < 2; team_id++)
   {
     bool ally_info = (team_id == Ally);
-    std::string team = ally_info ? "allies" : "opponents";
+    const data::Referee::TeamInfo& info = referee.teams_info[team_id];
+    snapshot::Team& team = snapshot.teams[team_id];
 
     // referee informations
-    if (ally_info)
-    {
-      packet["teams"][team]["positive_axis"] = referee.allyOnPositiveHalf();
-    }
-    else
+    team.positive_axis = ally_info ? referee.allyOnPositiveHalf() : !referee.allyOnPositiveHalf();
+    snapshot::copyName(team.name, info.name);
+    team.score = info.score;
+    team.timeout_remaining_count = info.timeout_remaining_count;
+    team.timeout_remaining_time = info.timeout_remaining_time;
+    team.goalkeeper_number = info.goalkeeper_number;
+    team.yellow_cards_count = info.yellow_cards_count;
+    team.nb_yellow_card_times = std::min<uint>(info.yellow_card_times.size(), snapshot::MAX_YELLOW_CARDS);
+    for (uint i = 0; i < team.nb_yellow_card_times; ++i)
     {
-      packet["teams"][team]["positive_axis"] = !Data::get()->referee.allyOnPositiveHalf();
+      team.yellow_card_times[i] = info.yellow_card_times.at(i);
     }
-    packet["teams"][team]["name"] = referee.teams_info[team_id].name;
-    packet["teams"][team]["score"] = referee.teams_info[team_id].score;
-    packet["teams"][team]["timeout"]["remaincount"] = referee.teams_info[team_id].timeout_remaining_count;
-    packet["teams"][team]["timeout"]["remaining_time"] = referee.teams_info[team_id].timeout_remaining_time;
-    packet["teams"][team]["goalkeeper_number"] = referee.teams_info[team_id].goalkeeper_number;
-
-    packet["teams"][team]["cards"]["yellow"] = referee.teams_info[team_id].yellow_cards_count;
-    for (uint i = 0; i < referee.teams_info[team_id].yellow_card_times.size(); ++i)
-    {
-      packet["teams"][team]["cards"]["yellow"]["time"][i] = referee.teams_info[team_id].yellow_card_times.at(i);
-    }
-    packet["teams"][team]["cards"]["red"] = referee.teams_info[team_id].red_cards_count;
-    packet["teams"][team]["fouls"] = referee.teams_info[team_id].foul_counter;
-    packet["teams"][team]["max_allowed_bots"] = referee.teams_info[team_id].max_allowed_bots;
+    team.red_cards_count = info.red_cards_count;
+    team.foul_counter = info.foul_counter;
+    team.max_allowed_bots = info.max_allowed_bots;
 
     // robots informations
     for (uint rid = 0; rid < ai::Config::NB_OF_ROBOTS_BY_TEAM; rid++)
     {
       const data::Robot& current_robot = Data::get()->robots[team_id][rid];
       const rhoban_geometry::Point& robot_position = current_robot.getMovement().linearPosition(time);
-
-      packet["teams"][team]["bots"][rid]["number"] = current_robot.id;
-      packet["teams"][team]["bots"][rid]["time"] = current_robot.getMovement().lastTime();
-
-      packet["teams"][team]["bots"][rid]["position"]["x"] = robot_position.getX();
-      packet["teams"][team]["bots"][rid]["position"]["y"] = robot_position.getY();
-      packet["teams"][team]["bots"][rid]["position"]["orientation"] =
-          current_robot.getMovement().angularPosition(Data::get()->time.now()).value();
-
-      packet["teams"][team]["bots"][rid]["velocity"]["x"] =
-          current_robot.getMovement().linearVelocity(Data::get()->time.now()).getX();
-      packet["teams"][team]["bots"][rid]["velocity"]["y"] =
-          current_robot.getMovement().linearVelocity(Data::get()->time.now()).getY();
-      packet["teams"][team]["bots"][rid]["velocity"]["theta"] =
-          current_robot.getMovement().angularVelocity(Data::get()->time.now()).value();
-
-      // TO REMOVE
-      packet["teams"][team]["bots"][rid]["last_control"]["time"] = 0;
-      packet["teams"][team]["bots"][rid]["last_control"]["velocity"]["x"] = 0;
-      packet["teams"][team]["bots"][rid]["last_control"]["velocity"]["y"] = 0;
-      packet["teams"][team]["bots"][rid]["last_control"]["velocity"]["theta"] = 0;
-
-      packet["teams"][team]["bots"][rid]["radius"] = ai::Config::robot_radius;
-      packet["teams"][team]["bots"][rid]["is_present"] = current_robot.isActive();
+      const Vector2d& robot_velocity = current_robot.getMovement().linearVelocity(time);
+      snapshot::Robot& robot = team.bots[rid];
+
+      robot.number = current_robot.id;
+      robot.time = current_robot.getMovement().lastTime();
+      robot.x = robot_position.getX();
+      robot.y = robot_position.getY();
+      robot.orientation = current_robot.getMovement().angularPosition(time).value();
+      robot.vx = robot_velocity.getX();
+      robot.vy = robot_velocity.getY();
+      robot.vtheta = current_robot.getMovement().angularVelocity(time).value();
+      robot.is_present = current_robot.isActive();
 
       if (ally_info)
       {
-        packet["teams"][team]["bots"][rid]["color"] = (ai::Config::we_are_blue) ? blue_color : yellow_color;
-        packet["teams"][team]["bots"][rid]["behavior"] = ai_ == nullptr ? "noai" : ai_->getRobotBehaviorOf(rid);
-        packet["teams"][team]["bots"][rid]["strategy"] = ai_ == nullptr ? "noai" : ai_->getStrategyOf(rid);
+        if (ai_ != nullptr)
+        {
+          snapshot::copyName(robot.behavior, ai_->getRobotBehaviorOf(rid));
+        }
 
         if (!ai::Config::is_in_simulation)
         {
-          // Activate electronics.
-          packet["teams"][team]["bots"][rid]["electronics"]["alive"] = current_robot.isOk();
-          packet["teams"][team]["bots"][rid]["electronics"]["voltage"] = current_robot.electronics.voltage;
-          packet["teams"][team]["bots"][rid]["electronics"]["cap_volt"] = current_robot.electronics.cap_volt;
-          packet["teams"][team]["bots"][rid]["electronics"]["ir_triggered"] = current_robot.infraRed();
-          packet["teams"][team]["bots"][rid]["electronics"]["odometry"]["x"] = current_robot.electronics.xpos;
-          packet["teams"][team]["bots"][rid]["electronics"]["odometry"]["y"] = current_robot.electronics.ypos;
-          packet["teams"][team]["bots"][rid]["electronics"]["odometry"]["orientation"] = current_robot.electronics.ang;
-          packet["teams"][team]["bots"][rid]["electronics"]["errors"]["driver"] = current_robot.driverError();
+          robot.electronics.alive = current_robot.isOk();
+          robot.electronics.voltage = current_robot.electronics.voltage;
+          robot.electronics.cap_volt = current_robot.electronics.cap_volt;
+          robot.electronics.ir_triggered = current_robot.infraRed();
+          robot.electronics.odometry_x = current_robot.electronics.xpos;
+          robot.electronics.odometry_y = current_robot.electronics.ypos;
+          robot.electronics.odometry_orientation = current_robot.electronics.ang;
+          robot.electronics.driver_error = current_robot.driverError();
         }
       }
-      else
-      {
-        packet["teams"][team]["bots"][rid]["color"] = (!ai::Config::we_are_blue) ? blue_color : yellow_color;
-      }
     }
   }
-  return packet;
-}
-
-Json::Value ViewerCommunication::refereePacket()
-{
-  Json::Value packet;
-
-  packet["referee"]["stage"]["value"] = Data::get()->referee.getCurrentStageName();
-  packet["referee"]["stage"]["remaining_time"] = Data::get()->referee.stage_time_left;
-  packet["referee"]["state"] = Data::get()->referee.getCurrentStateName();
-
-  return packet;
 }
 
-Json::Value ViewerCommunication::informationsPacket()
+void ViewerCommunication::fillReferee(ViewerSnapshot& snapshot)
 {
-  Json::Value packet;
-
-  packet["informations"]["simulation"] = ai::Config::is_in_simulation;
-  packet["informations"]["packets_per_second"] = 1. / Data::get()->time.now() - last_sending_time_;
-
-  // todo
-  // packet["informatons"]["ping"] = ai::Config::we_are_blue;
-
-  return packet;
+  snapshot.referee.stage = Data::get()->referee.current_stage;
+  snapshot.referee.stage_time_left = Data::get()->referee.stage_time_left;
+  snapshot.referee.command = Data::get()->referee.current_command;
 }
 
-Json::Value ViewerCommunication::aiPacket()
+void ViewerCommunication::fillInformations(ViewerSnapshot& snapshot)
 {
-  Json::Value packet;
-
-  const std::vector<std::string>& available_managers = list2vector(manager::Factory::availableManagers());
-  for (uint i = 0; i < available_managers.size(); i++)
+  snapshot.informations.simulation = ai::Config::is_in_simulation;
+  snapshot.informations.packets_per_second = 1. / (snapshot.time - last_sending_time_);
+  snapshot.informations.snapshot_duration = last_snapshot_time_;
+  snapshot.informations.serialization_duration = serializer_.lastSerializationTime();
+  snapshot.informations.superseded_snapshots = serializer_.nbSuperseded();
+  snapshot.informations.refinement_duration = 0.0;
+  snapshot.informations.refinement_budget = ai::Config::refinement_budget;
+  snapshot.informations.refinement_pending = false;
+  if (ai_ != nullptr && ai_->getCurrentManager())
   {
-    packet["ai"]["managers"]["availables"][i]["name"] = available_managers.at(i);
+    const AnytimeScheduler::Stats& refinement = ai_->getCurrentManager()->refinementStats();
+    snapshot.informations.refinement_duration = refinement.last_duration;
+    snapshot.informations.refinement_pending = refinement.pending;
   }
-  // todo
-  packet["ai"]["managers"]["current"]["name"] = ai_ == nullptr ? "noai" : ai_->getCurrentManager().get()->name();
 
-  for (uint i = 0; ai_ != nullptr && i < ai_->getCurrentManager().get()->getAvailableStrategies().size(); ++i)
+  control::Commander* commander = Data::get()->commander;
+  snapshot.informations.has_radio = (commander != nullptr && commander->hasRadio());
+  if (snapshot.informations.has_radio)
   {
-    packet["ai"]["managers"]["current"]["strategies_used"][i]["name"] =
-        ai_->getCurrentManager().get()->getAvailableStrategies().at(i);
+    for (unsigned int id = 0; id < MAX_ROBOTS; id++)
+    {
+      snapshot.informations.radio[id] = commander->radioStats(id);
+    }
   }
+}
 
-  // we send all strategies in manual manager
-  for (uint i = 0; ai_ != nullptr && i < ai_->getManualManager().get()->getAvailableStrategies().size(); ++i)
+void ViewerCommunication::fillAi(ViewerSnapshot& snapshot)
+{
+  ai_description_.has_ai = (ai_ != nullptr);
+  if (ai_ != nullptr && ai_->getCurrentManager().get() != described_manager_)
   {
-    std::string strat_name = ai_->getManualManager().get()->getAvailableStrategies().at(i);
-    packet["ai"]["strategies"][i]["name"] = strat_name;
-    packet["ai"]["strategies"][i]["bots_required"] = ai_->getManualManager().get()->getStrategy(strat_name).minRobots();
+    // the lists of strategies only change with the manager.
+    described_manager_ = ai_->getCurrentManager().get();
+    snapshot::copyName(ai_description_.current_manager, described_manager_->name());
+
+    const std::vector<std::string>& strategies_used = described_manager_->getAvailableStrategies();
+    ai_description_.nb_strategies_used = std::min<uint>(strategies_used.size(), snapshot::MAX_STRATEGIES);
+    for (uint i = 0; i < ai_description_.nb_strategies_used; ++i)
+    {
+      snapshot::copyName(ai_description_.strategies_used[i], strategies_used.at(i));
+    }
+
+    // we send all strategies in manual manager
+    const std::vector<std::string>& strategies = ai_->getManualManager().get()->getAvailableStrategies();
+    ai_description_.nb_strategies = std::min<uint>(strategies.size(), snapshot::MAX_STRATEGIES);
+    for (uint i = 0; i < ai_description_.nb_strategies; ++i)
+    {
+      snapshot::copyName(ai_description_.strategies[i], strategies.at(i));
+      // the strategies constructed on demand are not constructed to be described
+      ai_description_.strategies_bots_required[i] = ai_->getManualManager().get()->minRobots(strategies.at(i));
+    }
   }
-  return packet;
+  snapshot.ai = ai_description_;
 }
 
 void ViewerCommunication::processBotsControlBot(const Json::Value& packet)
@@ -372,11 +367,11 @@ void ViewerCommunication::processBotsControlBot(const Json::Value& packet)
   }
 }
 
-Json::Value ViewerCommunication::annotationsPacket()
+void ViewerCommunication::fillAnnotations(ViewerSnapshot& snapshot)
 {
-  if (ai_ == nullptr)
-    return Json::Value();
-  return ai_->getAnnotations();
+  snapshot.annotations.clear();
+  if (ai_ != nullptr)
+    ai_->collectAnnotations(snapshot.annotations);
 }
 
 ViewerCommunication::note ViewerCommunication::parseNoteFromJson(const Json::Value& packet)
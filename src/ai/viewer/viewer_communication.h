@@ -20,6 +20,7 @@
 
 #include <execution_manager.h>
 #include <ai.h>
+#include "viewer_serializer.h"
 
 namespace rhoban_ssl
 {
@@ -28,6 +29,9 @@ namespace viewer
 /**
  * @brief The ViewerCommunication task process the incomming packets
  * from viewer clients and send informations of the game and the ia.
+ *
+ * The task only copies the state of the game in a ViewerSnapshot, the json packets
+ * are built outside of the control loop by the ViewerSerializer.
  */
 class ViewerCommunication : public Task
 {
@@ -46,6 +50,22 @@ private:
    */
   double sending_delay = 0.016;
 
+  /**
+   * @brief Converts the snapshots into packets in its own thread.
+   */
+  ViewerSerializer serializer_;
+
+  /**
+   * @brief Description of the managers and strategies, updated only when the manager changes.
+   */
+  snapshot::Ai ai_description_;
+  manager::Manager* described_manager_;
+
+  /**
+   * @brief Duration in seconds of the last snapshot made in the control loop.
+   */
+  double last_snapshot_time_;
+
 public:
   ViewerCommunication(ai::AI* ai);
 
@@ -57,13 +77,13 @@ private:
   void processIncomingPackets();
   void sendViewerPackets();
 
-  Json::Value fieldPacket();
-  Json::Value ballPacket();
-  Json::Value teamsPacket();
-  Json::Value refereePacket();
-  Json::Value informationsPacket();
-  Json::Value aiPacket();
-  Json::Value annotationsPacket();
+  void fillField(ViewerSnapshot& snapshot);
+  void fillBall(ViewerSnapshot& snapshot);
+  void fillTeams(ViewerSnapshot& snapshot);
+  void fillReferee(ViewerSnapshot& snapshot);
+  void fillInformations(ViewerSnapshot& snapshot);
+  void fillAi(ViewerSnapshot& snapshot);
+  void fillAnnotations(ViewerSnapshot& snapshot);
 
   struct note
   {
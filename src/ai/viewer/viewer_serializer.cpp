@@ -0,0 +1,615 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "viewer_serializer.h"
+#include <viewer_server.h>
+#include <manager/factory.h>
+#include <core/collection.h>
+#include <ssl_referee.pb.h>
+#include <chrono>
+
+namespace rhoban_ssl
+{
+namespace viewer
+{
+ViewerSerializer::ViewerSerializer()
+  : back_(&buffers_[0])
+  , pending_(&buffers_[1])
+  , front_(&buffers_[2])
+  , has_pending_(false)
+  , running_(true)
+  , nb_serialized_(0)
+  , nb_superseded_(0)
+  , last_serialization_time_(0.0)
+{
+  for (int i = 0; i < ViewerPacket::NB_ENCODINGS; ++i)
+  {
+    last_frame_bytes_[i] = 0;
+    last_frame_duration_[i] = 0.0;
+  }
+  thread_ = new std::thread([this]() { this->run(); });
+}
+
+ViewerSerializer::~ViewerSerializer()
+{
+  running_ = false;
+  cond_.notify_one();
+  thread_->join();
+  delete thread_;
+}
+
+ViewerSnapshot& ViewerSerializer::backBuffer()
+{
+  return *back_;
+}
+
+void ViewerSerializer::publish()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (has_pending_)
+    {
+      nb_superseded_++;
+    }
+    std::swap(back_, pending_);
+    has_pending_ = true;
+  }
+  cond_.notify_one();
+}
+
+unsigned long ViewerSerializer::nbSerialized() const
+{
+  return nb_serialized_;
+}
+
+unsigned long ViewerSerializer::nbSuperseded() const
+{
+  return nb_superseded_;
+}
+
+double ViewerSerializer::lastSerializationTime() const
+{
+  return last_serialization_time_;
+}
+
+void ViewerSerializer::requestKeyframe()
+{
+  delta_encoder_.reset();
+}
+
+void ViewerSerializer::run()
+{
+  using std::chrono::high_resolution_clock;
+  std::vector<ViewerPacket> packets;
+  while (running_)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (!has_pending_ && running_)
+      {
+        cond_.wait(lock);
+      }
+      if (!running_)
+        break;
+      std::swap(front_, pending_);
+      has_pending_ = false;
+    }
+
+    high_resolution_clock::time_point start = high_resolution_clock::now();
+
+    if (ViewerDataGlobal::get().keyframe_requested.exchange(false))
+    {
+      requestKeyframe();
+    }
+    for (int encoding = 0; encoding < ViewerPacket::NB_ENCODINGS; ++encoding)
+    {
+      if (ViewerDataGlobal::get().hasClients(static_cast<ViewerPacket::Encoding>(encoding)))
+      {
+        serialize(*front_, static_cast<ViewerPacket::Encoding>(encoding), packets);
+      }
+    }
+    for (ViewerPacket& packet : packets)
+    {
+      ViewerDataGlobal::get().packets_to_send.push(packet);
+    }
+    packets.clear();
+
+    last_serialization_time_ =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(high_resolution_clock::now() - start).count() / 1e9;
+    nb_serialized_++;
+  }
+}
+
+void ViewerSerializer::serialize(ViewerSnapshot& snapshot, ViewerPacket::Encoding encoding,
+                                 std::vector<ViewerPacket>& packets)
+{
+  using std::chrono::high_resolution_clock;
+  high_resolution_clock::time_point start = high_resolution_clock::now();
+  size_t first_packet = packets.size();
+
+  if (encoding == ViewerPacket::PROTOBUF)
+  {
+    serializeProtobuf(snapshot, packets);
+  }
+  else if (encoding == ViewerPacket::PROTOBUF_DELTA)
+  {
+    serializeDelta(snapshot, packets);
+  }
+  else
+  {
+    serializeJson(snapshot, packets);
+  }
+
+  unsigned int bytes = 0;
+  for (size_t i = first_packet; i < packets.size(); ++i)
+  {
+    // the clients rate limits keep or skip the packets of a frame together.
+    packets[i].frame_start = (i == first_packet);
+    bytes += packets[i].payload.size();
+  }
+  last_frame_bytes_[encoding] = bytes;
+  last_frame_duration_[encoding] =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(high_resolution_clock::now() - start).count() / 1e9;
+}
+
+void ViewerSerializer::serializeJson(ViewerSnapshot& snapshot, std::vector<ViewerPacket>& packets)
+{
+  packets.push_back(fieldPacket(snapshot));
+  packets.push_back(ballPacket(snapshot));
+  packets.push_back(teamsPacket(snapshot));
+  packets.push_back(refereePacket(snapshot));
+  packets.push_back(informationsPacket(snapshot));
+  packets.push_back(aiPacket(snapshot));
+  packets.push_back(annotationsPacket(snapshot));
+}
+
+void ViewerSerializer::serializeProtobuf(ViewerSnapshot& snapshot, std::vector<ViewerPacket>& packets)
+{
+  viewer_proto::AIPacket game;
+  fillGame(snapshot, *game.mutable_game());
+  packets.push_back(ViewerPacket(ViewerPacket::PROTOBUF, game.SerializeAsString()));
+
+  viewer_proto::AIPacket entities;
+  fillEntities(snapshot, *entities.mutable_entities());
+  packets.push_back(ViewerPacket(ViewerPacket::PROTOBUF, entities.SerializeAsString()));
+
+  if (snapshot.ai.has_ai)
+  {
+    viewer_proto::AIPacket annotations;
+    snapshot.annotations.toProtobuf(*annotations.mutable_annotations());
+    packets.push_back(ViewerPacket(ViewerPacket::PROTOBUF, annotations.SerializeAsString()));
+  }
+}
+
+void ViewerSerializer::serializeDelta(ViewerSnapshot& snapshot, std::vector<ViewerPacket>& packets)
+{
+  viewer_proto::GamePacket game;
+  fillGame(snapshot, game);
+
+  viewer_proto::AIPacket delta;
+  delta_encoder_.encode(snapshot, game, false, *delta.mutable_delta());
+  packets.push_back(ViewerPacket(ViewerPacket::PROTOBUF_DELTA, delta.SerializeAsString()));
+  packets.back().keyframe = delta.delta().keyframe();
+}
+
+Json::Value ViewerSerializer::fieldPacket(const ViewerSnapshot& snapshot)
+{
+  Json::Value packet;
+  const snapshot::Field& field = snapshot.field;
+
+  packet["field"]["length"] = field.length;
+  packet["field"]["width"] = field.width;
+  packet["field"]["boundary_width"] = field.boundary_width;
+  packet["field"]["goal"]["width"] = field.goal_width;
+  packet["field"]["goal"]["depth"] = field.goal_depth;
+  packet["field"]["penalty_area"]["width"] = field.penalty_area_width;
+  packet["field"]["penalty_area"]["depth"] = field.penalty_area_depth;
+  packet["field"]["circle"]["x"] = field.circle_x;
+  packet["field"]["circle"]["y"] = field.circle_y;
+  packet["field"]["circle"]["radius"] = field.circle_radius;
+
+  return packet;
+}
+
+Json::Value ViewerSerializer::ballPacket(const ViewerSnapshot& snapshot)
+{
+  Json::Value packet;
+
+  packet["ball"]["position"]["x"] = snapshot.ball.x;
+  packet["ball"]["position"]["y"] = snapshot.ball.y;
+  packet["ball"]["velocity"]["x"] = snapshot.ball.vx;
+  packet["ball"]["velocity"]["y"] = snapshot.ball.vy;
+  packet["ball"]["radius"] = snapshot.ball.radius;
+
+  return packet;
+}
+
+Json::Value ViewerSerializer::teamsPacket(const ViewerSnapshot& snapshot)
+{
+  Json::Value packet;
+
+  const std::string blue_color = "#2393c6";
+  const std::string yellow_color = "#dbdd56";
+
+  for (uint team_id = 0; team_id < 2; team_id++)
+  {
+    bool ally_info = (team_id == Ally);
+    std::string team = ally_info ? "allies" : "opponents";
+    const snapshot::Team& team_info = snapshot.teams[team_id];
+
+    // referee informations
+    packet["teams"][team]["positive_axis"] = team_info.positive_axis;
+    packet["teams"][team]["name"] = team_info.name;
+    packet["teams"][team]["score"] = team_info.score;
+    packet["teams"][team]["timeout"]["remaincount"] = team_info.timeout_remaining_count;
+    packet["teams"][team]["timeout"]["remaining_time"] = team_info.timeout_remaining_time;
+    packet["teams"][team]["goalkeeper_number"] = team_info.goalkeeper_number;
+
+    packet["teams"][team]["cards"]["yellow"] = team_info.yellow_cards_count;
+    for (uint i = 0; i < team_info.nb_yellow_card_times; ++i)
+    {
+      packet["teams"][team]["cards"]["yellow"]["time"][i] = team_info.yellow_card_times[i];
+    }
+    packet["teams"][team]["cards"]["red"] = team_info.red_cards_count;
+    packet["teams"][team]["fouls"] = team_info.foul_counter;
+    packet["teams"][team]["max_allowed_bots"] = team_info.max_allowed_bots;
+
+    // robots informations
+    for (uint rid = 0; rid < ai::Config::NB_OF_ROBOTS_BY_TEAM; rid++)
+    {
+      const snapshot::Robot& robot = team_info.bots[rid];
+
+      packet["teams"][team]["bots"][rid]["number"] = robot.number;
+      packet["teams"][team]["bots"][rid]["time"] = robot.time;
+
+      packet["teams"][team]["bots"][rid]["position"]["x"] = robot.x;
+      packet["teams"][team]["bots"][rid]["position"]["y"] = robot.y;
+      packet["teams"][team]["bots"][rid]["position"]["orientation"] = robot.orientation;
+
+      packet["teams"][team]["bots"][rid]["velocity"]["x"] = robot.vx;
+      packet["teams"][team]["bots"][rid]["velocity"]["y"] = robot.vy;
+      packet["teams"][team]["bots"][rid]["velocity"]["theta"] = robot.vtheta;
+
+      // TO REMOVE
+      packet["teams"][team]["bots"][rid]["last_control"]["time"] = 0;
+      packet["teams"][team]["bots"][rid]["last_control"]["velocity"]["x"] = 0;
+      packet["teams"][team]["bots"][rid]["last_control"]["velocity"]["y"] = 0;
+      packet["teams"][team]["bots"][rid]["last_control"]["velocity"]["theta"] = 0;
+
+      packet["teams"][team]["bots"][rid]["radius"] = snapshot.robot_radius;
+      packet["teams"][team]["bots"][rid]["is_present"] = robot.is_present;
+
+      if (ally_info)
+      {
+        packet["teams"][team]["bots"][rid]["color"] = (snapshot.we_are_blue) ? blue_color : yellow_color;
+        packet["teams"][team]["bots"][rid]["behavior"] = snapshot.ai.has_ai ? robot.behavior : "noai";
+        packet["teams"][team]["bots"][rid]["strategy"] = snapshot.ai.has_ai ? "Work in progress" : "noai";
+
+        if (!snapshot.informations.simulation)
+        {
+          // Activate electronics.
+          const snapshot::Electronics& electronics = robot.electronics;
+          packet["teams"][team]["bots"][rid]["electronics"]["alive"] = electronics.alive;
+          packet["teams"][team]["bots"][rid]["electronics"]["voltage"] = electronics.voltage;
+          packet["teams"][team]["bots"][rid]["electronics"]["cap_volt"] = electronics.cap_volt;
+          packet["teams"][team]["bots"][rid]["electronics"]["ir_triggered"] = electronics.ir_triggered;
+          packet["teams"][team]["bots"][rid]["electronics"]["odometry"]["x"] = electronics.odometry_x;
+          packet["teams"][team]["bots"][rid]["electronics"]["odometry"]["y"] = electronics.odometry_y;
+          packet["teams"][team]["bots"][rid]["electronics"]["odometry"]["orientation"] =
+              electronics.odometry_orientation;
+          packet["teams"][team]["bots"][rid]["electronics"]["errors"]["driver"] = electronics.driver_error;
+        }
+      }
+      else
+      {
+        packet["teams"][team]["bots"][rid]["color"] = (!snapshot.we_are_blue) ? blue_color : yellow_color;
+      }
+    }
+  }
+  return packet;
+}
+
+Json::Value ViewerSerializer::refereePacket(const ViewerSnapshot& snapshot)
+{
+  Json::Value packet;
+
+  packet["referee"]["stage"]["value"] = ::Referee::Stage_Name(static_cast<Referee_Stage>(snapshot.referee.stage));
+  packet["referee"]["stage"]["remaining_time"] = snapshot.referee.stage_time_left;
+  packet["referee"]["state"] = ::Referee::Command_Name(static_cast<Referee_Command>(snapshot.referee.command));
+
+  return packet;
+}
+
+Json::Value ViewerSerializer::informationsPacket(const ViewerSnapshot& snapshot)
+{
+  Json::Value packet;
+
+  packet["informations"]["simulation"] = snapshot.informations.simulation;
+  packet["informations"]["packets_per_second"] = snapshot.informations.packets_per_second;
+  packet["informations"]["snapshot_duration"] = snapshot.informations.snapshot_duration;
+  packet["informations"]["serialization_duration"] = snapshot.informations.serialization_duration;
+  packet["informations"]["superseded_snapshots"] = Json::UInt64(snapshot.informations.superseded_snapshots);
+  packet["informations"]["refinement"]["duration"] = snapshot.informations.refinement_duration;
+  packet["informations"]["refinement"]["budget"] = snapshot.informations.refinement_budget;
+  packet["informations"]["refinement"]["pending"] = snapshot.informations.refinement_pending;
+  packet["informations"]["encodings"]["json"]["bytes"] = last_frame_bytes_[ViewerPacket::JSON];
+  packet["informations"]["encodings"]["json"]["duration"] = last_frame_duration_[ViewerPacket::JSON];
+  packet["informations"]["encodings"]["protobuf"]["bytes"] = last_frame_bytes_[ViewerPacket::PROTOBUF];
+  packet["informations"]["encodings"]["protobuf"]["duration"] = last_frame_duration_[ViewerPacket::PROTOBUF];
+  packet["informations"]["encodings"]["delta"]["bytes"] = last_frame_bytes_[ViewerPacket::PROTOBUF_DELTA];
+  packet["informations"]["encodings"]["delta"]["duration"] = last_frame_duration_[ViewerPacket::PROTOBUF_DELTA];
+
+  const std::vector<ViewerClientStats> clients = ViewerDataGlobal::get().clientsStats();
+  for (uint i = 0; i < clients.size(); ++i)
+  {
+    packet["informations"]["clients"][i]["encoding"] = clients[i].encoding;
+    packet["informations"]["clients"][i]["max_frames_per_second"] = clients[i].max_frames_per_second;
+    packet["informations"]["clients"][i]["packets_sent"] = Json::UInt64(clients[i].nb_packets_sent);
+    packet["informations"]["clients"][i]["frames_skipped"] = Json::UInt64(clients[i].nb_frames_skipped);
+    packet["informations"]["clients"][i]["frames_dropped"] = Json::UInt64(clients[i].nb_frames_dropped);
+    packet["informations"]["clients"][i]["packets_dropped"] = Json::UInt64(clients[i].nb_packets_dropped);
+    packet["informations"]["clients"][i]["queued"] = clients[i].queued;
+  }
+
+  if (snapshot.informations.has_radio)
+  {
+    uint i = 0;
+    for (uint id = 0; id < MAX_ROBOTS; ++id)
+    {
+      const RadioTelemetry::RobotStats& link = snapshot.informations.radio[id];
+      if (link.commands == 0)
+        continue;
+      Json::Value& radio = packet["informations"]["radio"][i++];
+      radio["robot_id"] = id;
+      radio["commands"] = Json::UInt64(link.commands);
+      radio["answers"] = Json::UInt64(link.answers);
+      radio["missed"] = Json::UInt64(link.missed);
+      radio["loss_rate"] = link.lossRate();
+      radio["rtt"]["last"] = link.last_rtt;
+      radio["rtt"]["mean"] = link.mean_rtt;
+      radio["rtt"]["max"] = link.max_rtt;
+      radio["status_age"] = link.status_age;
+      radio["voltage"]["value"] = link.voltage.value;
+      radio["voltage"]["slope"] = link.voltage.slope;
+      radio["cap_volt"]["value"] = link.cap_volt.value;
+      radio["cap_volt"]["slope"] = link.cap_volt.slope;
+      for (uint bin = 0; bin < RadioTelemetry::NB_RTT_BINS; ++bin)
+      {
+        radio["rtt"]["histogram"][bin] = Json::UInt64(link.rtt_histogram[bin]);
+      }
+      for (uint bin = 0; bin < RadioTelemetry::NB_AGE_BINS; ++bin)
+      {
+        radio["age_histogram"][bin] = Json::UInt64(link.age_histogram[bin]);
+      }
+    }
+  }
+
+  // todo
+  // packet["informatons"]["ping"] = ai::Config::we_are_blue;
+
+  return packet;
+}
+
+Json::Value ViewerSerializer::aiPacket(const ViewerSnapshot& snapshot)
+{
+  Json::Value packet;
+  const snapshot::Ai& ai = snapshot.ai;
+
+  const std::vector<std::string>& available_managers = list2vector(manager::Factory::availableManagers());
+  for (uint i = 0; i < available_managers.size(); i++)
+  {
+    packet["ai"]["managers"]["availables"][i]["name"] = available_managers.at(i);
+  }
+  // todo
+  packet["ai"]["managers"]["current"]["name"] = ai.has_ai ? ai.current_manager : "noai";
+
+  for (uint i = 0; i < ai.nb_strategies_used; ++i)
+  {
+    packet["ai"]["managers"]["current"]["strategies_used"][i]["name"] = ai.strategies_used[i];
+  }
+
+  // we send all strategies in manual manager
+  for (uint i = 0; i < ai.nb_strategies; ++i)
+  {
+    packet["ai"]["strategies"][i]["name"] = ai.strategies[i];
+    packet["ai"]["strategies"][i]["bots_required"] = ai.strategies_bots_required[i];
+  }
+  return packet;
+}
+
+Json::Value ViewerSerializer::annotationsPacket(ViewerSnapshot& snapshot)
+{
+  if (!snapshot.ai.has_ai)
+    return Json::Value();
+
+  Json::Value packet;
+  packet["annotations"] = snapshot.annotations.toJson();
+  return packet;
+}
+
+void ViewerSerializer::fillGame(const ViewerSnapshot& snapshot, viewer_proto::GamePacket& game)
+{
+  viewer_proto::Field& field = *game.mutable_field();
+  field.set_fieldlength(snapshot.field.length);
+  field.set_fieldwidth(snapshot.field.width);
+  field.set_goalwidth(snapshot.field.goal_width);
+  field.set_goaldepth(snapshot.field.goal_depth);
+  field.set_boundarywidth(snapshot.field.boundary_width);
+  field.set_penaltyareadepth(snapshot.field.penalty_area_depth);
+  field.set_penaltyareawidth(snapshot.field.penalty_area_width);
+  field.set_radiuscircle(snapshot.field.circle_radius);
+  field.set_circlex(snapshot.field.circle_x);
+  field.set_circley(snapshot.field.circle_y);
+
+  viewer_proto::Informations& informations = *game.mutable_information();
+  informations.set_isblue(snapshot.we_are_blue);
+  informations.set_issimulation(snapshot.informations.simulation);
+  informations.set_packetspersecond(snapshot.informations.packets_per_second);
+  informations.set_snapshotduration(snapshot.informations.snapshot_duration);
+  informations.set_serializationduration(snapshot.informations.serialization_duration);
+  informations.set_supersededsnapshots(snapshot.informations.superseded_snapshots);
+  informations.set_refinementduration(snapshot.informations.refinement_duration);
+  informations.set_refinementbudget(snapshot.informations.refinement_budget);
+  informations.set_refinementpending(snapshot.informations.refinement_pending);
+  informations.mutable_json()->set_bytes(last_frame_bytes_[ViewerPacket::JSON]);
+  informations.mutable_json()->set_duration(last_frame_duration_[ViewerPacket::JSON]);
+  informations.mutable_protobuf()->set_bytes(last_frame_bytes_[ViewerPacket::PROTOBUF]);
+  informations.mutable_protobuf()->set_duration(last_frame_duration_[ViewerPacket::PROTOBUF]);
+  informations.mutable_delta()->set_bytes(last_frame_bytes_[ViewerPacket::PROTOBUF_DELTA]);
+  informations.mutable_delta()->set_duration(last_frame_duration_[ViewerPacket::PROTOBUF_DELTA]);
+  for (const ViewerClientStats& client : ViewerDataGlobal::get().clientsStats())
+  {
+    viewer_proto::ClientStats& stats = *informations.add_clients();
+    stats.set_encoding(client.encoding);
+    stats.set_maxframespersecond(client.max_frames_per_second);
+    stats.set_packetssent(client.nb_packets_sent);
+    stats.set_framesskipped(client.nb_frames_skipped);
+    stats.set_framesdropped(client.nb_frames_dropped);
+    stats.set_packetsdropped(client.nb_packets_dropped);
+    stats.set_queued(client.queued);
+  }
+  if (snapshot.informations.has_radio)
+  {
+    for (uint id = 0; id < MAX_ROBOTS; ++id)
+    {
+      const RadioTelemetry::RobotStats& link = snapshot.informations.radio[id];
+      if (link.commands == 0)
+        continue;
+      viewer_proto::RadioLink& radio = *informations.add_radio();
+      radio.set_robotid(id);
+      radio.set_commands(link.commands);
+      radio.set_answers(link.answers);
+      radio.set_missed(link.missed);
+      radio.set_lossrate(link.lossRate());
+      radio.set_lastrtt(link.last_rtt);
+      radio.set_meanrtt(link.mean_rtt);
+      radio.set_maxrtt(link.max_rtt);
+      radio.set_statusage(link.status_age);
+      radio.set_voltage(link.voltage.value);
+      radio.set_voltageslope(link.voltage.slope);
+      radio.set_capvolt(link.cap_volt.value);
+      radio.set_capvoltslope(link.cap_volt.slope);
+      for (uint bin = 0; bin < RadioTelemetry::NB_RTT_BINS; ++bin)
+      {
+        radio.add_rtthistogram(link.rtt_histogram[bin]);
+      }
+      for (uint bin = 0; bin < RadioTelemetry::NB_AGE_BINS; ++bin)
+      {
+        radio.add_agehistogram(link.age_histogram[bin]);
+      }
+    }
+  }
+
+  for (uint team_id = 0; team_id < 2; team_id++)
+  {
+    const snapshot::Team& team_info = snapshot.teams[team_id];
+    viewer_proto::TeamInfo& team = (team_id == Ally) ? *game.mutable_allies() : *game.mutable_opponents();
+
+    team.set_name(team_info.name);
+    team.set_positiveaxis(team_info.positive_axis);
+    team.set_score(team_info.score);
+    team.set_timeoutremainingcount(team_info.timeout_remaining_count);
+    team.set_timeoutremainingtime(team_info.timeout_remaining_time);
+    team.set_goalkeepernumber(team_info.goalkeeper_number);
+    team.set_yellowcards(team_info.yellow_cards_count);
+    for (uint i = 0; i < team_info.nb_yellow_card_times; ++i)
+    {
+      team.add_yellowcardtimes(team_info.yellow_card_times[i]);
+    }
+    team.set_redcards(team_info.red_cards_count);
+    team.set_fouls(team_info.foul_counter);
+    team.set_maxallowedbots(team_info.max_allowed_bots);
+  }
+
+  viewer_proto::Referee& referee = *game.mutable_referee();
+  referee.set_stage(::Referee::Stage_Name(static_cast<Referee_Stage>(snapshot.referee.stage)));
+  referee.set_stageremainingtime(snapshot.referee.stage_time_left);
+  referee.set_state(::Referee::Command_Name(static_cast<Referee_Command>(snapshot.referee.command)));
+
+  const snapshot::Ai& ai_description = snapshot.ai;
+  viewer_proto::Ai& ai = *game.mutable_ai();
+  for (const std::string& manager_name : manager::Factory::availableManagers())
+  {
+    ai.add_availablemanagers(manager_name);
+  }
+  ai.set_currentmanager(ai_description.has_ai ? ai_description.current_manager : "noai");
+  for (uint i = 0; i < ai_description.nb_strategies_used; ++i)
+  {
+    ai.add_strategiesused(ai_description.strategies_used[i]);
+  }
+  for (uint i = 0; i < ai_description.nb_strategies; ++i)
+  {
+    viewer_proto::Strategy& strategy = *ai.add_strategies();
+    strategy.set_name(ai_description.strategies[i]);
+    strategy.set_botsrequired(ai_description.strategies_bots_required[i]);
+  }
+}
+
+void ViewerSerializer::fillEntities(const ViewerSnapshot& snapshot, viewer_proto::EntityPacket& entities)
+{
+  entities.set_robotradius(snapshot.robot_radius);
+
+  viewer_proto::Ball& ball = *entities.mutable_ball();
+  ball.set_x(snapshot.ball.x);
+  ball.set_y(snapshot.ball.y);
+  ball.set_vx(snapshot.ball.vx);
+  ball.set_vy(snapshot.ball.vy);
+  ball.set_radius(snapshot.ball.radius);
+
+  for (uint team_id = 0; team_id < 2; team_id++)
+  {
+    bool ally_info = (team_id == Ally);
+    for (uint rid = 0; rid < ai::Config::NB_OF_ROBOTS_BY_TEAM; rid++)
+    {
+      const snapshot::Robot& robot = snapshot.teams[team_id].bots[rid];
+      viewer_proto::Robot& proto_robot = *entities.add_robot();
+
+      proto_robot.set_robot_id(robot.number);
+      proto_robot.set_x(robot.x);
+      proto_robot.set_y(robot.y);
+      proto_robot.set_dir(robot.orientation);
+      proto_robot.set_isally(ally_info);
+      proto_robot.set_ispresent(robot.is_present);
+      proto_robot.set_vx(robot.vx);
+      proto_robot.set_vy(robot.vy);
+      proto_robot.set_vtheta(robot.vtheta);
+      proto_robot.set_time(robot.time);
+
+      if (ally_info)
+      {
+        proto_robot.set_behavior(snapshot.ai.has_ai ? robot.behavior : "noai");
+        if (!snapshot.informations.simulation)
+        {
+          const snapshot::Electronics& electronics = robot.electronics;
+          viewer_proto::Electronics& proto_electronics = *proto_robot.mutable_electronics();
+          proto_electronics.set_alive(electronics.alive);
+          proto_electronics.set_voltage(electronics.voltage);
+          proto_electronics.set_capvolt(electronics.cap_volt);
+          proto_electronics.set_irtriggered(electronics.ir_triggered);
+          proto_electronics.set_odometryx(electronics.odometry_x);
+          proto_electronics.set_odometryy(electronics.odometry_y);
+          proto_electronics.set_odometryorientation(electronics.odometry_orientation);
+          proto_electronics.set_drivererror(electronics.driver_error);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace viewer
+}  // namespace rhoban_ssl
@@ -0,0 +1,151 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include "viewer_snapshot.h"
+#include "delta_encoder.h"
+#include <viewer_server.h>
+#include <ai_packet.pb.h>
+#include <json/json.h>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+namespace rhoban_ssl
+{
+namespace viewer
+{
+/**
+ * @brief The ViewerSerializer turns the snapshots produced by the control thread
+ * into viewer packets in its own thread.
+ *
+ * The snapshots are exchanged with a triple buffer:
+ *  - the control thread fills the back buffer and publishes it,
+ *  - the serializer thread takes the last published buffer.
+ *
+ * If the serializer is late, the pending snapshot is replaced by the new one
+ * (the viewer only needs the last state), so the control thread never waits.
+ *
+ * A snapshot is only serialized in the encodings used by the connected clients
+ * (json text packets, binary viewer_proto::AIPacket or keyframes and deltas).
+ */
+class ViewerSerializer
+{
+private:
+  ViewerSnapshot buffers_[3];
+
+  ViewerSnapshot* back_;
+  ViewerSnapshot* pending_;
+  ViewerSnapshot* front_;
+  bool has_pending_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+
+  std::atomic<bool> running_;
+  std::thread* thread_;
+
+  std::atomic<unsigned long> nb_serialized_;
+  std::atomic<unsigned long> nb_superseded_;
+  std::atomic<double> last_serialization_time_;
+
+  /**
+   * @brief Size in bytes and duration in seconds of the last frame in each encoding.
+   */
+  unsigned int last_frame_bytes_[ViewerPacket::NB_ENCODINGS];
+  double last_frame_duration_[ViewerPacket::NB_ENCODINGS];
+
+  DeltaEncoder delta_encoder_;
+
+  void run();
+
+  void serializeJson(ViewerSnapshot& snapshot, std::vector<ViewerPacket>& packets);
+  void serializeProtobuf(ViewerSnapshot& snapshot, std::vector<ViewerPacket>& packets);
+  void serializeDelta(ViewerSnapshot& snapshot, std::vector<ViewerPacket>& packets);
+
+  Json::Value fieldPacket(const ViewerSnapshot& snapshot);
+  Json::Value ballPacket(const ViewerSnapshot& snapshot);
+  Json::Value teamsPacket(const ViewerSnapshot& snapshot);
+  Json::Value refereePacket(const ViewerSnapshot& snapshot);
+  Json::Value informationsPacket(const ViewerSnapshot& snapshot);
+  Json::Value aiPacket(const ViewerSnapshot& snapshot);
+  Json::Value annotationsPacket(ViewerSnapshot& snapshot);
+
+  void fillGame(const ViewerSnapshot& snapshot, viewer_proto::GamePacket& game);
+  void fillEntities(const ViewerSnapshot& snapshot, viewer_proto::EntityPacket& entities);
+
+public:
+  /**
+   * @brief Constructor, launches the serialization thread.
+   */
+  ViewerSerializer();
+
+  /**
+   * @brief Stops and joins the serialization thread.
+   */
+  ~ViewerSerializer();
+
+  /**
+   * @brief Returns the snapshot that the control thread can fill.
+   *
+   * It must only be used by the control thread, and until the next call to publish().
+   */
+  ViewerSnapshot& backBuffer();
+
+  /**
+   * @brief Hands the back buffer over to the serializer thread.
+   *
+   * This call never blocks on the serialization.
+   */
+  void publish();
+
+  /**
+   * @brief Converts a snapshot in packets of the given encoding.
+   *
+   * It is called by the serializer thread, it is public to measure the encodings.
+   * @param snapshot the snapshot to convert
+   * @param encoding the encoding of the packets
+   * @param packets the vector that receives the packets
+   */
+  void serialize(ViewerSnapshot& snapshot, ViewerPacket::Encoding encoding, std::vector<ViewerPacket>& packets);
+
+  /**
+   * @brief Number of snapshots turned into packets.
+   */
+  unsigned long nbSerialized() const;
+
+  /**
+   * @brief Number of snapshots replaced by a newer one before being serialized.
+   */
+  unsigned long nbSuperseded() const;
+
+  /**
+   * @brief Duration in seconds of the last serialization (done outside the control thread).
+   */
+  double lastSerializationTime() const;
+
+  /**
+   * @brief Requests a keyframe for the next delta frame (serializer thread only).
+   */
+  void requestKeyframe();
+};
+
+}  // namespace viewer
+}  // namespace rhoban_ssl
@@ -0,0 +1,180 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <config.h>
+#include <annotations/annotations.h>
+#include <radio_telemetry.h>
+#include <cstring>
+#include <string>
+
+namespace rhoban_ssl
+{
+namespace viewer
+{
+namespace snapshot
+{
+static constexpr unsigned int NAME_SIZE = 48;
+static constexpr unsigned int MAX_YELLOW_CARDS = 8;
+static constexpr unsigned int MAX_STRATEGIES = 96;
+
+/**
+ * @brief Copy a string in a fixed size buffer, truncating it if needed.
+ */
+template <unsigned int N>
+inline void copyName(char (&dst)[N], const std::string& src)
+{
+  std::strncpy(dst, src.c_str(), N - 1);
+  dst[N - 1] = '\0';
+}
+
+struct Field
+{
+  double length;
+  double width;
+  double boundary_width;
+  double goal_width;
+  double goal_depth;
+  double penalty_area_width;
+  double penalty_area_depth;
+  double circle_x;
+  double circle_y;
+  double circle_radius;
+};
+
+struct Ball
+{
+  double x;
+  double y;
+  double vx;
+  double vy;
+  double radius;
+};
+
+struct Electronics
+{
+  bool alive;
+  double voltage;
+  double cap_volt;
+  bool ir_triggered;
+  double odometry_x;
+  double odometry_y;
+  double odometry_orientation;
+  bool driver_error;
+};
+
+struct Robot
+{
+  unsigned int number;
+  double time;
+  double x;
+  double y;
+  double orientation;
+  double vx;
+  double vy;
+  double vtheta;
+  bool is_present;
+  char behavior[NAME_SIZE];
+  Electronics electronics;
+};
+
+struct Team
+{
+  bool positive_axis;
+  char name[NAME_SIZE];
+  unsigned int score;
+  unsigned int timeout_remaining_count;
+  unsigned int timeout_remaining_time;
+  unsigned int goalkeeper_number;
+  unsigned int yellow_cards_count;
+  unsigned int nb_yellow_card_times;
+  unsigned int yellow_card_times[MAX_YELLOW_CARDS];
+  unsigned int red_cards_count;
+  int foul_counter;
+  int max_allowed_bots;
+  Robot bots[ai::Config::NB_OF_ROBOTS_BY_TEAM];
+};
+
+struct Referee
+{
+  int stage;
+  int stage_time_left;
+  int command;
+};
+
+struct Informations
+{
+  bool simulation;
+  double packets_per_second;
+  // durations in seconds of the previous snapshot (control thread) and serialization (viewer thread)
+  double snapshot_duration;
+  double serialization_duration;
+  unsigned long superseded_snapshots;
+  // anytime refinement of the strategies during the last tick (see AnytimeScheduler)
+  double refinement_duration;
+  double refinement_budget;
+  bool refinement_pending;
+  // radio link of each robot, only with the real robots
+  bool has_radio;
+  RadioTelemetry::RobotStats radio[MAX_ROBOTS];
+};
+
+/**
+ * @brief Description of the managers and strategies.
+ *
+ * This part only changes when the manager changes, the ViewerCommunication
+ * caches it and copies it in each snapshot.
+ */
+struct Ai
+{
+  bool has_ai;
+  char current_manager[NAME_SIZE];
+  unsigned int nb_strategies_used;
+  char strategies_used[MAX_STRATEGIES][NAME_SIZE];
+  unsigned int nb_strategies;
+  char strategies[MAX_STRATEGIES][NAME_SIZE];
+  int strategies_bots_required[MAX_STRATEGIES];
+};
+}  // namespace snapshot
+
+/**
+ * @brief The ViewerSnapshot struct contains everything the viewer needs for one frame.
+ *
+ * It is filled by the control thread with plain copies of the data (no json, no allocations)
+ * and is turned into packets by the ViewerSerializer thread.
+ *
+ * Annotations are plain shape records taken from the annotations arena,
+ * so copying them does not allocate either.
+ */
+struct ViewerSnapshot
+{
+  double time;
+  bool we_are_blue;
+  double robot_radius;
+  snapshot::Field field;
+  snapshot::Ball ball;
+  snapshot::Team teams[2];
+  snapshot::Referee referee;
+  snapshot::Informations informations;
+  snapshot::Ai ai;
+  annotations::Annotations annotations;
+};
+
+}  // namespace viewer
+}  // namespace rhoban_ssl
@@ -139,6 +139,7 @@ bool DetectionPacketAnalyzer::runTask()
         }
 
         current.camera_id_ = int(frame.camera_id());
+        Data::get()->latency.addVisionSample(frame.camera_id(), now - current.t_capture_);
         // invalidate previous data
         for (auto& i : current.balls_)
           i.confidence_ = -1;
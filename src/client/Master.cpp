@@ -4,6 +4,7 @@
 #include <signal.h>
 #include <assert.h>
 #include <execution_manager.h>
+#include <cstring>
 
 namespace rhoban_ssl
 {
@@ -26,12 +27,18 @@ Master::Robot::Robot()
 }
 
 Master::Master(std::string port, unsigned int baudrate)
+  : running(true), receivedAnswer(false), thread(nullptr), back(0), middle(1), front(2), nbPublished(0), nbSuperseded(0)
 {
   // em();
 
-  shouldSend = false;
-  shouldSendParams = false;
-  running = true;
+  for (Frame& frame : frames)
+  {
+    frame.size = 0;
+    frame.nbRobots = 0;
+  }
+  stats = { 0, 0, 0, 0.0, 0.0, 0.0, 0 };
+  lastSend = rhoban_utils::TimeStamp::now();
+
   try
   {
     std::cout << "Opening serial port: " << port << " baudrate: " << baudrate << std::endl;
@@ -60,16 +67,18 @@ Master::Master(std::string port, unsigned int baudrate)
       rhoban_ssl::ExecutionManager::getManager().shutdown();
     }
   });
-
-  tmpPacket = "";
-  tmpNbRobots = 0;
-  packet = "";
-  nbRobots = 0;
-  lastSend = rhoban_utils::TimeStamp::now();
 }
 
 Master::~Master()
 {
+  // Gives some time to the communication thread to send the last published frame
+  // (usually the stop of all the robots).
+  rhoban_utils::TimeStamp start = rhoban_utils::TimeStamp::now();
+  while (running && (middle.load() & FRESH) && diffSec(start, rhoban_utils::TimeStamp::now()) < 2 * ANSWER_TIMEOUT)
+  {
+    usleep(100);
+  }
+
   stop();
   if (thread != nullptr)
   {
@@ -108,55 +117,58 @@ void Master::stop()
 
 void Master::send()
 {
-  if (tmpPacket.size() > 0)
+  Frame& frame = frames[back];
+  if (frame.nbRobots > 0)
   {  // There is something to send
-    // Waiting to either have received an answer from the last send() or reached the
-    // overall cycle timeout
-    bool waiting = true;
-    while (waiting)
+    frame.published = rhoban_utils::TimeStamp::now();
+
+    // Publishing never waits for the link: the communication thread takes the latest frame
+    // when the answer to the previous one has been received (or after the timeout).
+    uint8_t previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+    if (previous & FRESH)
     {
-      mutex.lock();
-      if (receivedAnswer)
-      {
-        waiting = false;
-      }
-      else
-      {
-        // XXX: This timeout should be adjusted
-        if (diffSec(lastSend, rhoban_utils::TimeStamp::now()) > 0.03)
-        {
-          waiting = false;
-        }
-      }
-      mutex.unlock();
-      usleep(100);
+      nbSuperseded++;
     }
-
-    // XXX: Did we finished the last send cycle?
-    // We should wait either the timeout or the reception is over
-    packet = tmpPacket;
-    nbRobots = tmpNbRobots;
-    tmpPacket.clear();
-    tmpNbRobots = 0;
-    receivedAnswer = false;
-    lastSend = rhoban_utils::TimeStamp::now();
-    shouldSend = true;
+    nbPublished++;
+    back = previous & INDEX;
+    frames[back].size = 0;
+    frames[back].nbRobots = 0;
   }
 }
 
-void Master::addPacket(int robot, int instruction, char* packet, size_t len)
+Master::SendStats Master::sendStats()
 {
-  std::string data(packet, len);
-  tmpPacket += (char)robot;
-  tmpPacket += (char)instruction;
-  tmpPacket += data;
+  std::lock_guard<std::mutex> lock(statsMutex);
+  SendStats result = stats;
+  result.published = nbPublished;
+  result.superseded = nbSuperseded;
+  return result;
+}
 
-  // Padding to complete until PACKET_SIZE
-  for (size_t k = 0; k < PACKET_SIZE - len - 1; k++)
+void Master::setAnswerCallback(std::function<void(double)> callback)
+{
+  answerCallback = callback;
+}
+
+void Master::addPacket(int robot, int instruction, char* packet, size_t len)
+{
+  Frame& frame = frames[back];
+  if (frame.nbRobots == MAX_ROBOTS)
   {
-    tmpPacket += (char)0;
+    std::cerr << "Master: too many packets in the frame, packet for robot " << robot << " ignored" << std::endl;
+    return;
   }
-  tmpNbRobots++;
+
+  uint8_t* data = frame.data + frame.size;
+  data[0] = (uint8_t)robot;
+  data[1] = (uint8_t)instruction;
+  memcpy(data + 2, packet, len);
+
+  // Padding to complete until PACKET_SIZE
+  memset(data + 2 + len, 0, PACKET_SIZE - len - 1);
+
+  frame.size += PACKET_SIZE + 1;
+  frame.nbRobots++;
 }
 
 void Master::addRobotPacket(int robot, struct packet_master robotPacket)
@@ -181,20 +193,54 @@ void Master::updateRobot(uint id, packet_robot& r)
   mutex.unlock();
 }
 
-void Master::sendPacket()
+bool Master::robotPresence(uint id, double& age)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  age = robots[id].age();
+  return robots[id].present;
+}
+
+bool Master::takeFrame()
+{
+  if ((middle.load(std::memory_order_acquire) & FRESH) == 0)
+    return false;
+
+  uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+  front = previous & INDEX;
+  return true;
+}
+
+void Master::sendPacket(const Frame& frame)
 {
-  uint8_t data[packet.size() + 4];
+  uint8_t data[sizeof(frame.data) + 4];
   data[0] = 0xaa;
   data[1] = 0x55;
-  data[2] = nbRobots;
+  data[2] = frame.nbRobots;
+  memcpy((void*)(data + 3), frame.data, frame.size);
+  data[frame.size + 3] = 0xff;
+
+  uint8_t robotIds[MAX_ROBOTS];
+  for (size_t k = 0; k < frame.nbRobots; k++)
+  {
+    robotIds[k] = frame.data[k * (PACKET_SIZE + 1)];
+  }
+  telemetry.frameSent(robotIds, frame.nbRobots);
 
-  memcpy((void*)(data + 3), packet.c_str(), packet.size());
-  data[sizeof(data) - 1] = 0xff;
   receivedAnswer = false;
-  mutex.unlock();
+  lastSend = rhoban_utils::TimeStamp::now();
 
   // Sending the data
-  serial->write(data, sizeof(data));
+  serial->write(data, frame.size + 4);
+
+  double latency = diffSec(frame.published, lastSend);
+  std::lock_guard<std::mutex> lock(statsMutex);
+  stats.sent++;
+  stats.lastLatency = latency;
+  stats.meanLatency += (latency - stats.meanLatency) / stats.sent;
+  if (latency > stats.maxLatency)
+  {
+    stats.maxLatency = latency;
+  }
 }
 
 void Master::execute()
@@ -202,6 +248,12 @@ void Master::execute()
   int state = 0;
   unsigned int pos = 0;
   size_t nb_robots = 0;
+  // the last frame sent has not been answered
+  bool waitingAnswer = false;
+  // an answer has been received since the last frame was sent
+  bool answeredSinceSend = false;
+  // the last frame was sent on timeout: the next answer may be the one of the previous frame
+  bool lateAnswerExpected = false;
   uint8_t temp[1024];
 
   serial->write("master\nmaster\nmaster\n");
@@ -282,13 +334,15 @@ void Master::execute()
             }
             */
             // Received message from USB, reading the status of each robot
+            uint8_t answered[MAX_ROBOTS];
+            size_t nb_answered = 0;
             mutex.lock();
-            receivedAnswer = true;
             for (size_t k = 0; k < nb_robots; k++)
             {
               int robot_id = temp[k * (1 + sizeof(struct packet_robot))];
               if (robot_id < MAX_ROBOTS)
               {
+                answered[nb_answered++] = robot_id;
                 memcpy(&robots[robot_id].status, &temp[k * (1 + sizeof(struct packet_robot)) + 1],
                        sizeof(struct packet_robot));
                 robots[robot_id].present = true;
@@ -296,21 +350,48 @@ void Master::execute()
               }
             }
             mutex.unlock();
+            answeredSinceSend = true;
+            if (lateAnswerExpected)
+            {
+              // the late answer of the previous frame or the answer of the last one (the previous frame was
+              // lost): it is not credited to the last frame, but the radio is free, the next frame can be
+              // sent without waiting for a second timeout
+              lateAnswerExpected = false;
+              receivedAnswer = true;
+              std::lock_guard<std::mutex> lock(statsMutex);
+              stats.lateAnswers++;
+            }
+            else
+            {
+              telemetry.frameAnswered(answered, nb_answered, diffSec(lastSend, rhoban_utils::TimeStamp::now()));
+              receivedAnswer = true;
+              if (waitingAnswer)
+              {
+                waitingAnswer = false;
+                if (answerCallback)
+                {
+                  answerCallback(diffSec(frames[front].published, rhoban_utils::TimeStamp::now()));
+                }
+              }
+            }
           }
           state = 0;
         }
       }
     }
 
-    mutex.lock();
-    if (shouldSend)
+    // The link is ready when the previous frame has been answered or is too old.
+    if (receivedAnswer || diffSec(lastSend, rhoban_utils::TimeStamp::now()) > ANSWER_TIMEOUT)
     {
-      shouldSend = false;
-      sendPacket();
-    }
-    else
-    {
-      mutex.unlock();
+      if (takeFrame())
+      {
+        // Only one answer is attributed to the previous frame: if it has already been received,
+        // a frame lost by the radio doesn't make the answers of the next frames late.
+        lateAnswerExpected = waitingAnswer && not(answeredSinceSend);
+        answeredSinceSend = false;
+        sendPacket(frames[front]);
+        waitingAnswer = true;
+      }
     }
   }
   std::cout << "Thread communication with robots CLOSED" << std::endl;
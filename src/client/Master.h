@@ -3,15 +3,57 @@
 #include <string>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <functional>
 #include <serial/serial.h>
 #include <rhoban_utils/timing/time_stamp.h>
 #include "structs.h"
+#include "radio_telemetry.h"
 
 namespace rhoban_ssl
 {
+/**
+ * @brief Communication with the robots through the USB radio card.
+ *
+ * The control thread builds a frame with the add*Packet methods and publishes it
+ * with send(), which never blocks. The frames are exchanged through a lock-free
+ * triple buffer: the communication thread (execute()) always takes the latest
+ * published frame and writes it when the link is ready, i.e. when the answer to
+ * the previous frame has been received or after ANSWER_TIMEOUT.
+ *
+ * A frame published while the previous one is still waiting for the link is
+ * superseded: it is never sent, only the latest commands matter.
+ */
 class Master
 {
 public:
+  /**
+   * @brief Maximum time in seconds to wait for the answer to a frame before sending the next one.
+   */
+  static constexpr double ANSWER_TIMEOUT = 0.03;
+
+  struct Frame
+  {
+    uint8_t data[MAX_ROBOTS * (PACKET_SIZE + 1)];
+    size_t size;
+    size_t nbRobots;
+    rhoban_utils::TimeStamp published;
+  };
+
+  struct SendStats
+  {
+    unsigned long published;
+    unsigned long sent;
+    unsigned long superseded;
+    // delay between the publication of a frame and its write on the serial port (seconds)
+    double lastLatency;
+    double meanLatency;
+    double maxLatency;
+    // first answers received after a timeout: late answers of the frame that timed out, or answers of the
+    // next frame when the previous one was lost. They are not credited to a frame but make the link ready.
+    unsigned long lateAnswers;
+  };
+
   struct Robot
   {
     Robot();
@@ -33,12 +75,24 @@ public:
   // Stop the master
   void stop();
 
-  // Send the packet(s)
+  // Publish the packet(s), they will be sent by the communication thread
   void send();
 
+  // Counters of the published, sent and superseded frames and of the late answers
+  SendStats sendStats();
+
+  // Called by the communication thread when a frame is answered, with the delay in seconds
+  // between its publication and its answer. It must be set before the first send().
+  // The answers don't identify their frame: after a frame has been sent on timeout, the first
+  // answer may be the late answer of the previous frame, it is only counted in the late answers.
+  void setAnswerCallback(std::function<void(double)> callback);
+
   // Master packets and statuses
   struct Robot robots[MAX_ROBOTS];
 
+  // Round-trip times, missed answers and status ages of each robot
+  RadioTelemetry telemetry;
+
   // Add packet in the list of commands to send
   void addRobotPacket(int robot, struct packet_master robotPacket);
   void addParamPacket(int robot, struct packet_params params);
@@ -46,23 +100,43 @@ public:
 
   void updateRobot(uint id, struct packet_robot& r);
 
+  /**
+   * @brief Tells if the robot has answered, with the age in seconds of its last answer.
+   *
+   * The presence and the age are written by the communication thread, they are read under its lock.
+   */
+  bool robotPresence(uint id, double& age);
+
 protected:
-  bool running;
-  bool shouldSend;
-  bool shouldSendParams;
-  bool receivedAnswer;
+  static constexpr uint8_t FRESH = 0x4;
+  static constexpr uint8_t INDEX = 0x3;
+
+  std::atomic<bool> running;
+  std::atomic<bool> receivedAnswer;
   rhoban_utils::TimeStamp lastSend;
 
   serial::Serial* serial;
   std::thread* thread;
   std::mutex mutex;
-  std::string tmpPacket;
-  size_t tmpNbRobots;
-  std::string packet;
-  size_t nbRobots;
+
+  // Triple buffer: the control thread fills frames[back], the communication thread
+  // sends frames[front], middle holds the index of the last published frame and
+  // the FRESH bit when it has not been taken yet.
+  Frame frames[3];
+  uint8_t back;
+  std::atomic<uint8_t> middle;
+  uint8_t front;
+
+  std::atomic<unsigned long> nbPublished;
+  std::atomic<unsigned long> nbSuperseded;
+  std::mutex statsMutex;
+  SendStats stats;
+
+  std::function<void(double)> answerCallback;
 
   void execute();
   void addPacket(int robot, int instruction, char* packet, size_t len);
-  void sendPacket();
+  bool takeFrame();
+  void sendPacket(const Frame& frame);
 };
 }  // namespace rhoban_ssl
@@ -4,11 +4,21 @@
 
 namespace rhoban_ssl
 {
-SimClient::SimClient() : broadcast(-1, SSL_SIM_PORT)
+SimClient::SimClient()
+  : broadcast(-1, SSL_SIM_PORT)
+  , stats({ 0, 0, 0, 0.0, 0.0 })
+  , windowStart(rhoban_utils::TimeStamp::now())
+  , windowPackets(0)
+  , windowBytes(0)
 {
 }
 
-SimClient::SimClient(std::string port) : broadcast(-1, stoi(port))
+SimClient::SimClient(std::string port)
+  : broadcast(-1, stoi(port))
+  , stats({ 0, 0, 0, 0.0, 0.0 })
+  , windowStart(rhoban_utils::TimeStamp::now())
+  , windowPackets(0)
+  , windowBytes(0)
 {
 }
 
@@ -46,31 +56,74 @@ void SimClient::moveRobot(bool yellow, int id, double x, double y, double theta,
 
 void SimClient::send(bool yellow, int id, double x, double y, double theta, double kickX, double kickZ, bool spin)
 {
-  // Building packet
-  grSim_Packet packet;
-  packet.mutable_commands()->set_isteamyellow(yellow);
-  packet.mutable_commands()->set_timestamp(0.0);
-  grSim_Robot_Command* command = packet.mutable_commands()->add_robot_commands();
+  beginCommands(yellow);
+  grSim_Robot_Command& command = addCommand();
 
   // Appending data
-  command->set_id(id);
-  command->set_wheelsspeed(false);
-  command->set_veltangent(x);
-  command->set_velnormal(y);
-  command->set_velangular(theta);
-  command->set_kickspeedx(kickX);
-  command->set_kickspeedz(kickZ);
-  command->set_spinner(spin);
+  command.set_id(id);
+  command.set_wheelsspeed(false);
+  command.set_veltangent(x);
+  command.set_velnormal(y);
+  command.set_velangular(theta);
+  command.set_kickspeedx(kickX);
+  command.set_kickspeedz(kickZ);
+  command.set_spinner(spin);
 
-  sendPacket(packet);
+  sendCommands();
+}
+
+void SimClient::beginCommands(bool yellow)
+{
+  // Clear() keeps the robot commands allocated for the next batch
+  commands.mutable_commands()->mutable_robot_commands()->Clear();
+  commands.mutable_commands()->set_isteamyellow(yellow);
+  commands.mutable_commands()->set_timestamp(0.0);
+}
+
+grSim_Robot_Command& SimClient::addCommand()
+{
+  return *commands.mutable_commands()->add_robot_commands();
 }
 
-void SimClient::sendPacket(grSim_Packet& packet)
+void SimClient::sendCommands()
+{
+  if (commands.commands().robot_commands_size() > 0)
+  {
+    sendPacket(commands);
+  }
+}
+
+void SimClient::sendPacket(const grSim_Packet& packet)
 {
   // Broadcasting the packet
-  size_t len = packet.ByteSize();
-  unsigned char buffer[len];
-  packet.SerializeToArray(buffer, len);
-  broadcast.broadcastMessage(buffer, len);
+  size_t len = packet.ByteSizeLong();
+  if (buffer.size() < len)
+  {
+    buffer.resize(len);
+  }
+  packet.SerializeWithCachedSizesToArray(buffer.data());
+  broadcast.broadcastMessage(buffer.data(), len);
+
+  stats.packets++;
+  stats.bytes += len;
+  stats.last_size = len;
+  windowPackets++;
+  windowBytes += len;
+
+  rhoban_utils::TimeStamp now = rhoban_utils::TimeStamp::now();
+  double elapsed = diffSec(windowStart, now);
+  if (elapsed >= 1.0)
+  {
+    stats.packets_per_second = windowPackets / elapsed;
+    stats.bytes_per_second = windowBytes / elapsed;
+    windowStart = now;
+    windowPackets = 0;
+    windowBytes = 0;
+  }
+}
+
+const SimClient::SendStats& SimClient::sendStats() const
+{
+  return stats;
 }
 }  // namespace rhoban_ssl
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include <rhoban_utils/sockets/udp_broadcast.h>
+#include <rhoban_utils/timing/time_stamp.h>
 #include "grSim_Packet.pb.h"
 #include "grSim_Commands.pb.h"
 #include "grSim_Replacement.pb.h"
@@ -15,6 +17,16 @@ namespace rhoban_ssl
 class SimClient
 {
 public:
+  struct SendStats
+  {
+    unsigned long packets;
+    unsigned long bytes;
+    size_t last_size;
+    // measured on the last complete second
+    double packets_per_second;
+    double bytes_per_second;
+  };
+
   SimClient();
 
   SimClient(std::string port);
@@ -55,9 +67,43 @@ public:
       // Robot kick
       double kickX, double kickZ, bool spin);
 
-  void sendPacket(grSim_Packet& packet);
+  void sendPacket(const grSim_Packet& packet);
+
+  /**
+   * Starts a batch of robot commands, all the commands of a tick are sent in one packet.
+   *
+   * The packet and its robot commands are reused from a batch to the next one.
+   *
+   * @param yellow Are the robots yellow ?
+   */
+  void beginCommands(bool yellow);
+
+  /**
+   * Adds a robot command to the current batch
+   *
+   * @return the command to fill (id and velocities)
+   */
+  grSim_Robot_Command& addCommand();
+
+  /**
+   * Sends the current batch in a single packet (nothing is sent if it is empty).
+   */
+  void sendCommands();
+
+  /**
+   * Number, size and rate of the packets sent to the simulator.
+   */
+  const SendStats& sendStats() const;
 
 protected:
   rhoban_utils::UDPBroadcast broadcast;
+
+  grSim_Packet commands;
+  std::vector<unsigned char> buffer;
+
+  SendStats stats;
+  rhoban_utils::TimeStamp windowStart;
+  unsigned long windowPackets;
+  unsigned long windowBytes;
 };
 }  // namespace rhoban_ssl
@@ -0,0 +1,104 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <vector>
+#include <cassert>
+#include <cstddef>
+
+/**
+ * @brief A fixed capacity FIFO that drops its oldest element when it is full.
+ *
+ * The storage is allocated once. It is not thread safe.
+ */
+template <typename T>
+class BoundedRing
+{
+public:
+  explicit BoundedRing(size_t capacity) : items_(capacity), head_(0), size_(0)
+  {
+    assert(capacity > 0);
+  }
+
+  size_t capacity() const
+  {
+    return items_.size();
+  }
+
+  size_t size() const
+  {
+    return size_;
+  }
+
+  bool empty() const
+  {
+    return size_ == 0;
+  }
+
+  bool full() const
+  {
+    return size_ == items_.size();
+  }
+
+  /**
+   * @brief Adds an item at the end.
+   *
+   * @param dropped receives the oldest item if the ring was full
+   * @return true if the oldest item has been dropped
+   */
+  bool push(const T& item, T& dropped)
+  {
+    bool drop = full();
+    if (drop)
+    {
+      dropped = items_[head_];
+      popFront();
+    }
+    items_[(head_ + size_) % items_.size()] = item;
+    size_++;
+    return drop;
+  }
+
+  T& front()
+  {
+    assert(!empty());
+    return items_[head_];
+  }
+
+  void popFront()
+  {
+    assert(!empty());
+    items_[head_] = T();
+    head_ = (head_ + 1) % items_.size();
+    size_--;
+  }
+
+  void clear()
+  {
+    while (!empty())
+    {
+      popFront();
+    }
+  }
+
+private:
+  std::vector<T> items_;
+  size_t head_;
+  size_t size_;
+};
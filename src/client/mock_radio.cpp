@@ -0,0 +1,205 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "mock_radio.h"
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdexcept>
+#include <termios.h>
+#include <unistd.h>
+
+namespace rhoban_ssl
+{
+MockRadio::MockRadio(const Settings& settings)
+  : settings_(settings)
+  , master_fd_(-1)
+  , slave_fd_(-1)
+  , running_(true)
+  , thread_(nullptr)
+  , random_(settings.seed)
+  , nb_frames_(0)
+  , nb_answers_(0)
+  , nb_lost_(0)
+{
+  master_fd_ = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master_fd_ < 0 || grantpt(master_fd_) != 0 || unlockpt(master_fd_) != 0)
+  {
+    throw std::runtime_error("MockRadio: can't create a pseudo-terminal");
+  }
+  port_ = ptsname(master_fd_);
+
+  // The slave side stays open (otherwise the master side reads fail until Master opens it)
+  // and is set in raw mode like a serial port.
+  slave_fd_ = open(port_.c_str(), O_RDWR | O_NOCTTY);
+  if (slave_fd_ < 0)
+  {
+    throw std::runtime_error("MockRadio: can't open " + port_);
+  }
+  struct termios tio;
+  tcgetattr(slave_fd_, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(slave_fd_, TCSANOW, &tio);
+
+  thread_ = new std::thread([this]() { this->run(); });
+}
+
+MockRadio::~MockRadio()
+{
+  running_ = false;
+  if (thread_ != nullptr)
+  {
+    thread_->join();
+    delete thread_;
+  }
+  close(slave_fd_);
+  close(master_fd_);
+}
+
+const std::string& MockRadio::port() const
+{
+  return port_;
+}
+
+unsigned long MockRadio::nbFrames() const
+{
+  return nb_frames_;
+}
+
+unsigned long MockRadio::nbAnswers() const
+{
+  return nb_answers_;
+}
+
+unsigned long MockRadio::nbLost() const
+{
+  return nb_lost_;
+}
+
+void MockRadio::answer(const uint8_t* robots, size_t nb_robots)
+{
+  nb_frames_++;
+
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  if (uniform(random_) < settings_.loss)
+  {
+    nb_lost_++;
+    return;
+  }
+
+  Answer answer;
+  double delay = settings_.delay + settings_.jitter * uniform(random_);
+  answer.due = std::chrono::steady_clock::now() +
+               std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(delay));
+
+  answer.bytes.push_back(0xaa);
+  answer.bytes.push_back(0x55);
+  answer.bytes.push_back(nb_robots);
+  for (size_t k = 0; k < nb_robots; k++)
+  {
+    uint8_t robot_id = robots[k * (PACKET_SIZE + 1)];
+    const struct packet_master* order =
+        reinterpret_cast<const struct packet_master*>(&robots[k * (PACKET_SIZE + 1) + 2]);
+
+    struct packet_robot status;
+    std::memset(&status, 0, sizeof(status));
+    status.id = robot_id;
+    status.status = STATUS_OK;
+    status.cap_volt = (order->actions & ACTION_CHARGE) ? 180 : 0;
+    status.voltage = 160;
+
+    answer.bytes.push_back(robot_id);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&status);
+    answer.bytes.insert(answer.bytes.end(), bytes, bytes + sizeof(status));
+  }
+  answer.bytes.push_back(0xff);
+
+  answers_.push(std::move(answer));
+}
+
+void MockRadio::run()
+{
+  int state = 0;
+  size_t pos = 0;
+  size_t nb_robots = 0;
+  uint8_t robots[MAX_ROBOTS * (PACKET_SIZE + 1)];
+  uint8_t buffer[1024];
+
+  while (running_)
+  {
+    // wakes up for the next answer, or at least every 10 ms to check running_
+    int timeout = 10;
+    if (!answers_.empty())
+    {
+      auto wait = std::chrono::duration_cast<std::chrono::microseconds>(answers_.top().due -
+                                                                        std::chrono::steady_clock::now());
+      timeout = std::max<int>(0, std::min<int>(timeout, wait.count() / 1000));
+    }
+
+    struct pollfd fd = { master_fd_, POLLIN, 0 };
+    if (poll(&fd, 1, timeout) > 0 && (fd.revents & POLLIN))
+    {
+      ssize_t n = read(master_fd_, buffer, sizeof(buffer));
+      for (ssize_t k = 0; k < n; k++)
+      {
+        uint8_t c = buffer[k];
+        // same framing as Master::execute, in the other direction
+        if (state == 0)
+        {
+          if (c == 0xaa)
+            state++;
+        }
+        else if (state == 1)
+        {
+          state = (c == 0x55) ? 2 : 0;
+        }
+        else if (state == 2)
+        {
+          nb_robots = c;
+          pos = 0;
+          state = (nb_robots <= MAX_ROBOTS) ? 3 : 0;
+        }
+        else if (pos < nb_robots * (PACKET_SIZE + 1))
+        {
+          robots[pos++] = c;
+        }
+        else
+        {
+          if (c == 0xff)
+          {
+            answer(robots, nb_robots);
+          }
+          state = 0;
+        }
+      }
+    }
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    while (!answers_.empty() && answers_.top().due <= now)
+    {
+      const std::vector<uint8_t>& bytes = answers_.top().bytes;
+      if (write(master_fd_, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size()))
+      {
+        nb_answers_++;
+      }
+      answers_.pop();
+    }
+  }
+}
+
+}  // namespace rhoban_ssl
@@ -0,0 +1,102 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "structs.h"
+
+namespace rhoban_ssl
+{
+/**
+ * @brief A fake mainboard behind a pseudo-terminal, to run Master without the USB base station.
+ *
+ * It reads the frames written by Master::sendPacket (0xaa 0x55, number of robots,
+ * the robot packets, 0xff) and answers with a status frame (packet_robot) for each
+ * robot of the frame, like the mainboard firmware.
+ *
+ * An answer is sent after delay + a uniform random jitter, or is lost with
+ * the given probability.
+ *
+ * Master can open the pseudo-terminal with the path given by port().
+ */
+class MockRadio
+{
+public:
+  struct Settings
+  {
+    // seconds
+    double delay;
+    double jitter;
+    // probability to not answer a frame
+    double loss;
+    unsigned int seed;
+  };
+
+  explicit MockRadio(const Settings& settings);
+  ~MockRadio();
+
+  /**
+   * @brief Path of the pseudo-terminal to give to Master.
+   */
+  const std::string& port() const;
+
+  unsigned long nbFrames() const;
+  unsigned long nbAnswers() const;
+  unsigned long nbLost() const;
+
+private:
+  struct Answer
+  {
+    std::chrono::steady_clock::time_point due;
+    std::vector<uint8_t> bytes;
+
+    bool operator<(const Answer& other) const
+    {
+      // the earliest answer on top of the priority queue
+      return due > other.due;
+    }
+  };
+
+  Settings settings_;
+  int master_fd_;
+  int slave_fd_;
+  std::string port_;
+
+  std::atomic<bool> running_;
+  std::thread* thread_;
+
+  std::mt19937 random_;
+  std::priority_queue<Answer> answers_;
+
+  std::atomic<unsigned long> nb_frames_;
+  std::atomic<unsigned long> nb_answers_;
+  std::atomic<unsigned long> nb_lost_;
+
+  void run();
+  void answer(const uint8_t* robots, size_t nb_robots);
+};
+
+}  // namespace rhoban_ssl
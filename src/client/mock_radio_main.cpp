@@ -0,0 +1,34 @@
+#include <iostream>
+#include <csignal>
+#include <unistd.h>
+#include <tclap/CmdLine.h>
+#include "mock_radio.h"
+
+static volatile bool running = true;
+
+void stop(int)
+{
+  running = false;
+}
+
+int main(int argc, char** argv)
+{
+  TCLAP::CmdLine cmd("Fake mainboard on a pseudo-terminal", ' ', "0.0", true);
+  TCLAP::ValueArg<double> delay("d", "delay", "Answer delay (ms)", false, 2.0, "double", cmd);
+  TCLAP::ValueArg<double> jitter("j", "jitter", "Maximum random extra delay (ms)", false, 1.0, "double", cmd);
+  TCLAP::ValueArg<double> loss("l", "loss", "Probability to lose an answer", false, 0.0, "double", cmd);
+  cmd.parse(argc, argv);
+
+  signal(SIGINT, stop);
+
+  rhoban_ssl::MockRadio radio({ delay.getValue() / 1000, jitter.getValue() / 1000, loss.getValue(), 42 });
+  std::cout << "Mock radio listening on " << radio.port() << std::endl;
+
+  while (running)
+  {
+    sleep(1);
+    std::cout << radio.nbFrames() << " frames, " << radio.nbAnswers() << " answers, " << radio.nbLost() << " lost"
+              << std::endl;
+  }
+  return 0;
+}
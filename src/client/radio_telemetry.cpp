@@ -0,0 +1,221 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "radio_telemetry.h"
+#include <cstring>
+
+namespace rhoban_ssl
+{
+constexpr unsigned int RadioTelemetry::NB_RTT_BINS;
+constexpr unsigned int RadioTelemetry::NB_AGE_BINS;
+const double RadioTelemetry::AGE_BINS[NB_AGE_BINS - 1] = { 0.01, 0.02, 0.05, 0.1, 0.2, 0.5, 1.0 };
+
+namespace
+{
+// time constant of the voltage smoothing, and duration of the windows used for the slopes (seconds)
+constexpr double TREND_SMOOTHING = 2.0;
+constexpr double TREND_WINDOW = 10.0;
+// weight of a new answer in the smoothed round-trip time
+constexpr double RTT_SMOOTHING = 0.05;
+}  // namespace
+
+void RadioTelemetry::Trend::reset()
+{
+  value = 0.0;
+  slope = 0.0;
+  initialized = false;
+  last_time = 0.0;
+  window_time = 0.0;
+  window_value = 0.0;
+}
+
+void RadioTelemetry::Trend::update(double time, double sample)
+{
+  if (!initialized)
+  {
+    value = sample;
+    slope = 0.0;
+    last_time = time;
+    window_time = time;
+    window_value = sample;
+    initialized = true;
+    return;
+  }
+
+  double dt = time - last_time;
+  if (dt <= 0.0)
+    return;
+  last_time = time;
+  double alpha = dt / (TREND_SMOOTHING + dt);
+  value += alpha * (sample - value);
+
+  if (time - window_time >= TREND_WINDOW)
+  {
+    slope = (value - window_value) / (time - window_time) * 60.0;
+    window_time = time;
+    window_value = value;
+  }
+}
+
+double RadioTelemetry::RobotStats::lossRate() const
+{
+  unsigned long expected = answers + missed;
+  return (expected > 0) ? double(missed) / expected : 0.0;
+}
+
+RadioTelemetry::RadioTelemetry() : waiting_answer_(false), smoothed_rtt_(0.0)
+{
+  for (unsigned int id = 0; id < MAX_ROBOTS; ++id)
+  {
+    RobotStats& robot = robots_[id];
+    std::memset(&robot, 0, sizeof(robot));
+    robot.voltage.reset();
+    robot.cap_volt.reset();
+    pending_[id] = false;
+  }
+}
+
+void RadioTelemetry::missPending()
+{
+  for (unsigned int id = 0; id < MAX_ROBOTS; ++id)
+  {
+    if (pending_[id])
+    {
+      robots_[id].missed++;
+      pending_[id] = false;
+    }
+  }
+}
+
+void RadioTelemetry::frameSent(const uint8_t* robot_ids, size_t nb_robots)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (waiting_answer_)
+  {
+    missPending();
+  }
+  for (size_t k = 0; k < nb_robots; ++k)
+  {
+    if (robot_ids[k] < MAX_ROBOTS)
+    {
+      pending_[robot_ids[k]] = true;
+      robots_[robot_ids[k]].commands++;
+    }
+  }
+  waiting_answer_ = true;
+}
+
+void RadioTelemetry::frameAnswered(const uint8_t* robot_ids, size_t nb_robots, double rtt)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!waiting_answer_)
+    return;
+
+  unsigned int bin = static_cast<unsigned int>(rtt * 1000);
+  if (bin >= NB_RTT_BINS)
+    bin = NB_RTT_BINS - 1;
+
+  for (size_t k = 0; k < nb_robots; ++k)
+  {
+    uint8_t id = robot_ids[k];
+    if (id < MAX_ROBOTS && pending_[id])
+    {
+      RobotStats& robot = robots_[id];
+      pending_[id] = false;
+      robot.answers++;
+      robot.last_rtt = rtt;
+      robot.mean_rtt += (rtt - robot.mean_rtt) / robot.answers;
+      if (rtt > robot.max_rtt)
+        robot.max_rtt = rtt;
+      robot.rtt_histogram[bin]++;
+    }
+  }
+  if (nb_robots > 0)
+  {
+    smoothed_rtt_ = (smoothed_rtt_ > 0.0) ? smoothed_rtt_ + RTT_SMOOTHING * (rtt - smoothed_rtt_) : rtt;
+  }
+
+  // the robots of the frame absent from the answer
+  missPending();
+  waiting_answer_ = false;
+}
+
+void RadioTelemetry::sampleStatus(unsigned int robot_id, double time, double age, const struct packet_robot& status)
+{
+  if (robot_id >= MAX_ROBOTS)
+    return;
+
+  unsigned int bin = 0;
+  while (bin < NB_AGE_BINS - 1 && age > AGE_BINS[bin])
+    bin++;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  RobotStats& robot = robots_[robot_id];
+  robot.status_age = age;
+  robot.age_histogram[bin]++;
+  // only the fresh statuses carry new voltages
+  if (age <= AGE_BINS[NB_AGE_BINS - 2])
+  {
+    robot.voltage.update(time, status.voltage / 10.0);
+    robot.cap_volt.update(time, status.cap_volt);
+  }
+}
+
+RadioTelemetry::RobotStats RadioTelemetry::robotStats(unsigned int robot_id)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return robots_[robot_id];
+}
+
+double RadioTelemetry::smoothedRtt()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return smoothed_rtt_;
+}
+
+void RadioTelemetry::writeCsvHeader(std::ostream& out)
+{
+  out << "time,robot,commands,answers,missed,loss_rate,last_rtt,mean_rtt,max_rtt,status_age,voltage,voltage_slope,"
+         "cap_volt,cap_volt_slope";
+  for (unsigned int bin = 0; bin < NB_AGE_BINS; ++bin)
+  {
+    out << ",age_" << bin;
+  }
+  out << std::endl;
+}
+
+void RadioTelemetry::writeCsv(std::ostream& out, double time)
+{
+  for (unsigned int id = 0; id < MAX_ROBOTS; ++id)
+  {
+    RobotStats robot = robotStats(id);
+    if (robot.commands == 0)
+      continue;
+    out << time << "," << id << "," << robot.commands << "," << robot.answers << "," << robot.missed << ","
+        << robot.lossRate() << "," << robot.last_rtt << "," << robot.mean_rtt << "," << robot.max_rtt << ","
+        << robot.status_age << "," << robot.voltage.value << "," << robot.voltage.slope << "," << robot.cap_volt.value
+        << "," << robot.cap_volt.slope;
+    for (unsigned int bin = 0; bin < NB_AGE_BINS; ++bin)
+    {
+      out << "," << robot.age_histogram[bin];
+    }
+    out << std::endl;
+  }
+}
+
+}  // namespace rhoban_ssl
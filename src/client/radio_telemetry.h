@@ -0,0 +1,133 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <mutex>
+#include <ostream>
+#include "structs.h"
+
+namespace rhoban_ssl
+{
+/**
+ * @brief Health of the radio link of each robot.
+ *
+ * The communication thread of Master records, for each frame, the robots it
+ * addresses and the robots that answer: round-trip time (write of the frame to
+ * answer) and missed answers. The control thread records the age of the last
+ * status of each robot and its battery and capacitor voltages, which are
+ * smoothed to show their trend.
+ *
+ * All the methods can be called from any thread.
+ */
+class RadioTelemetry
+{
+public:
+  // 1 ms bins, the last one counts the round-trip times above NB_RTT_BINS-1 ms
+  static constexpr unsigned int NB_RTT_BINS = 32;
+  // upper bounds (seconds) of the status age bins, the last bin is unbounded
+  static constexpr unsigned int NB_AGE_BINS = 8;
+  static const double AGE_BINS[NB_AGE_BINS - 1];
+
+  /**
+   * @brief Exponentially smoothed value and its slope, in units per minute.
+   */
+  struct Trend
+  {
+    double value;
+    double slope;
+
+    bool initialized;
+    double last_time;
+    double window_time;
+    double window_value;
+
+    void reset();
+    void update(double time, double sample);
+  };
+
+  struct RobotStats
+  {
+    unsigned long commands;
+    unsigned long answers;
+    unsigned long missed;
+
+    // seconds
+    double last_rtt;
+    double mean_rtt;
+    double max_rtt;
+    unsigned long rtt_histogram[NB_RTT_BINS];
+
+    double status_age;
+    unsigned long age_histogram[NB_AGE_BINS];
+
+    // volts
+    Trend voltage;
+    Trend cap_volt;
+
+    double lossRate() const;
+  };
+
+  RadioTelemetry();
+
+  /**
+   * @brief A frame addressing the given robots has been written.
+   *
+   * The robots of the previous frame that did not answer are counted as missed.
+   */
+  void frameSent(const uint8_t* robot_ids, size_t nb_robots);
+
+  /**
+   * @brief The answer to the last frame has been received.
+   * @param robot_ids the robots present in the answer
+   * @param rtt the delay in seconds between the write of the frame and its answer
+   */
+  void frameAnswered(const uint8_t* robot_ids, size_t nb_robots, double rtt);
+
+  /**
+   * @brief Records the status of a robot as seen by the control thread.
+   * @param time the time of the sample in seconds
+   * @param age the age of the status in seconds
+   */
+  void sampleStatus(unsigned int robot_id, double time, double age, const struct packet_robot& status);
+
+  RobotStats robotStats(unsigned int robot_id);
+
+  /**
+   * @brief Exponentially smoothed round-trip time of all the robots (seconds), 0 before the first answer.
+   */
+  double smoothedRtt();
+
+  /**
+   * @brief Writes one csv line by robot (see writeCsvHeader()).
+   */
+  void writeCsv(std::ostream& out, double time);
+  static void writeCsvHeader(std::ostream& out);
+
+private:
+  std::mutex mutex_;
+  RobotStats robots_[MAX_ROBOTS];
+
+  bool pending_[MAX_ROBOTS];
+  bool waiting_answer_;
+  double smoothed_rtt_;
+
+  void missPending();
+};
+
+}  // namespace rhoban_ssl
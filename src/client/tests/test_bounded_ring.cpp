@@ -0,0 +1,81 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <bounded_ring.h>
+
+TEST(test_bounded_ring, fifo)
+{
+  BoundedRing<int> ring(3);
+  int dropped = -1;
+
+  EXPECT_TRUE(ring.empty());
+  EXPECT_FALSE(ring.push(1, dropped));
+  EXPECT_FALSE(ring.push(2, dropped));
+  EXPECT_EQ(ring.size(), 2u);
+  EXPECT_EQ(ring.front(), 1);
+  ring.popFront();
+  EXPECT_EQ(ring.front(), 2);
+  ring.popFront();
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(dropped, -1);
+}
+
+TEST(test_bounded_ring, drop_oldest)
+{
+  BoundedRing<int> ring(3);
+  int dropped = -1;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_FALSE(ring.push(i, dropped));
+  }
+  EXPECT_TRUE(ring.full());
+
+  EXPECT_TRUE(ring.push(3, dropped));
+  EXPECT_EQ(dropped, 0);
+  EXPECT_TRUE(ring.push(4, dropped));
+  EXPECT_EQ(dropped, 1);
+  EXPECT_EQ(ring.size(), 3u);
+
+  for (int i = 2; i < 5; ++i)
+  {
+    EXPECT_EQ(ring.front(), i);
+    ring.popFront();
+  }
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(test_bounded_ring, clear)
+{
+  BoundedRing<int> ring(2);
+  int dropped;
+  ring.push(1, dropped);
+  ring.push(2, dropped);
+  ring.clear();
+  EXPECT_TRUE(ring.empty());
+  EXPECT_FALSE(ring.push(3, dropped));
+  EXPECT_EQ(ring.front(), 3);
+}
+
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
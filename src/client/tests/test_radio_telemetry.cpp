@@ -0,0 +1,80 @@
+/*
+    This file is part of SSL.
+
+    Copyright 2019 Schmitz Etienne (hello@etienne-schmitz.com)
+
+    SSL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    SSL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with SSL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <radio_telemetry.h>
+
+using namespace rhoban_ssl;
+
+TEST(test_radio_telemetry, round_trip_and_missed_answers)
+{
+  RadioTelemetry telemetry;
+  const uint8_t frame[] = { 0, 1, 2 };
+  const uint8_t answer[] = { 0, 2 };
+
+  telemetry.frameSent(frame, 3);
+  telemetry.frameAnswered(answer, 2, 0.004);
+
+  EXPECT_EQ(telemetry.robotStats(0).answers, 1u);
+  EXPECT_EQ(telemetry.robotStats(1).missed, 1u);
+  EXPECT_DOUBLE_EQ(telemetry.robotStats(2).last_rtt, 0.004);
+  EXPECT_EQ(telemetry.robotStats(2).rtt_histogram[4], 1u);
+
+  // no answer before the next frame: the whole frame is missed
+  telemetry.frameSent(frame, 3);
+  telemetry.frameSent(frame, 3);
+  telemetry.frameAnswered(answer, 2, 0.010);
+
+  RadioTelemetry::RobotStats robot = telemetry.robotStats(0);
+  EXPECT_EQ(robot.commands, 3u);
+  EXPECT_EQ(robot.answers, 2u);
+  EXPECT_EQ(robot.missed, 1u);
+  EXPECT_DOUBLE_EQ(robot.max_rtt, 0.010);
+  EXPECT_DOUBLE_EQ(robot.lossRate(), 1.0 / 3.0);
+  EXPECT_EQ(telemetry.robotStats(1).missed, 3u);
+  EXPECT_EQ(telemetry.robotStats(3).commands, 0u);
+}
+
+TEST(test_radio_telemetry, status_age_and_voltage_trend)
+{
+  RadioTelemetry telemetry;
+  struct packet_robot status;
+  std::memset(&status, 0, sizeof(status));
+  status.cap_volt = 180;
+
+  // battery losing 0.1 V per second, sampled at 100 Hz
+  for (int i = 0; i <= 3000; ++i)
+  {
+    double t = i * 0.01;
+    status.voltage = static_cast<uint8_t>(200 - t);
+    telemetry.sampleStatus(0, t, 0.005, status);
+  }
+  telemetry.sampleStatus(0, 30.0, 0.3, status);
+
+  RadioTelemetry::RobotStats robot = telemetry.robotStats(0);
+  EXPECT_DOUBLE_EQ(robot.status_age, 0.3);
+  EXPECT_EQ(robot.age_histogram[0], 3001u);
+  EXPECT_EQ(robot.age_histogram[5], 1u);
+  // the smoothing lags by about 2 s
+  EXPECT_NEAR(robot.voltage.value, 17.2, 0.15);
+  EXPECT_NEAR(robot.voltage.slope, -6.0, 0.3);
+  EXPECT_NEAR(robot.cap_volt.value, 180.0, 1e-9);
+  EXPECT_DOUBLE_EQ(robot.cap_volt.slope, 0.0);
+}
@@ -1,15 +1,137 @@
 #include "viewer_server.h"
 #include <assert.h>
 #include <algorithm>
+#include <chrono>
 
 namespace rhoban_ssl
 {
 namespace viewer
 {
+ViewerPacket::ViewerPacket() : encoding(JSON), frame_start(true), keyframe(false)
+{
+}
+
+ViewerPacket::ViewerPacket(const Json::Value& packet)
+  : encoding(JSON), payload(Json::FastWriter().write(packet)), frame_start(true), keyframe(false)
+{
+}
+
+ViewerPacket::ViewerPacket(Encoding encoding, std::string payload)
+  : encoding(encoding), payload(std::move(payload)), frame_start(true), keyframe(false)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ViewerClient::ViewerClient(struct lws* wsi, ViewerPacket::Encoding encoding, size_t ring_capacity,
+                           double max_frames_per_second)
+  : wsi(wsi)
+  , encoding(encoding)
+  , ring(ring_capacity)
+  , max_frames_per_second(max_frames_per_second)
+  , last_frame_time(-1.0)
+  , accepting_frame(false)
+  , waiting_keyframe(true)
+  , stats({ encoding, max_frames_per_second, 0, 0, 0, 0, 0 })
+{
+}
+
+void ViewerClient::push(const std::shared_ptr<const ViewerPacket>& packet, double now)
+{
+  if (packet->encoding != encoding)
+    return;
+
+  if (packet->frame_start)
+  {
+    if (encoding == ViewerPacket::PROTOBUF_DELTA)
+    {
+      if (waiting_keyframe && !packet->keyframe)
+      {
+        accepting_frame = false;
+        stats.nb_frames_skipped++;
+        return;
+      }
+      waiting_keyframe = false;
+      accepting_frame = true;
+    }
+    else
+    {
+      accepting_frame = (max_frames_per_second <= 0.0 || last_frame_time < 0.0 ||
+                         now - last_frame_time >= 1.0 / max_frames_per_second);
+      if (!accepting_frame)
+      {
+        stats.nb_frames_skipped++;
+        return;
+      }
+      last_frame_time = now;
+    }
+  }
+  if (!accepting_frame)
+    return;
+
+  std::shared_ptr<const ViewerPacket> dropped;
+  if (ring.push(packet, dropped))
+  {
+    stats.nb_packets_dropped++;
+    if (dropped->frame_start)
+    {
+      stats.nb_frames_dropped++;
+    }
+    if (encoding == ViewerPacket::PROTOBUF_DELTA)
+    {
+      // the next deltas are useless without the dropped one.
+      stats.nb_packets_dropped += ring.size();
+      ring.clear();
+      accepting_frame = false;
+      waiting_keyframe = true;
+      ViewerDataGlobal::get().keyframe_requested = true;
+    }
+  }
+}
+
+bool ViewerClient::applySettings(const char* message, size_t len)
+{
+  Json::Value root;
+  Json::Reader reader;
+  if (!reader.parse(message, message + len, root) || !root.isObject() || !root.isMember("viewer_client"))
+    return false;
+
+  const Json::Value& settings = root["viewer_client"];
+  if (settings.isMember("max_frames_per_second"))
+  {
+    max_frames_per_second = settings["max_frames_per_second"].asDouble();
+    stats.max_frames_per_second = max_frames_per_second;
+  }
+  return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 ViewerDataGlobal ViewerDataGlobal::instance_;
 
-ViewerDataGlobal::ViewerDataGlobal() : client_connected(false)
+ViewerDataGlobal::ViewerDataGlobal() : client_connected(false), keyframe_requested(false)
 {
+  for (int i = 0; i < ViewerPacket::NB_ENCODINGS; ++i)
+  {
+    clients_by_encoding[i] = 0;
+  }
+}
+
+bool ViewerDataGlobal::hasClients(ViewerPacket::Encoding encoding) const
+{
+  return clients_by_encoding[encoding] > 0;
+}
+
+std::vector<ViewerClientStats> ViewerDataGlobal::clientsStats()
+{
+  std::lock_guard<std::mutex> lock(clients_stats_mutex_);
+  return clients_stats_;
+}
+
+void ViewerDataGlobal::setClientsStats(const std::vector<ViewerClientStats>& stats)
+{
+  std::lock_guard<std::mutex> lock(clients_stats_mutex_);
+  clients_stats_ = stats;
 }
 
 ViewerDataGlobal& ViewerDataGlobal::get()
@@ -17,20 +139,22 @@ ViewerDataGlobal& ViewerDataGlobal::get()
   return ViewerDataGlobal::instance_;
 }
 
-void ViewerDataGlobal::parseAndStorePacketFromClient(char* packet_received)
+void ViewerDataGlobal::parseAndStorePacketFromClient(const char* packet_received, size_t len)
 {
   Json::Value root;
   Json::Reader reader;
-  assert(reader.parse(packet_received, root));
+  assert(reader.parse(packet_received, packet_received + len, root));
   received_packets.push(root);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 std::atomic<bool> ViewerServer::running_(true);
-std::vector<struct lws*> ViewerServer::clients_;
+std::vector<ViewerClient*> ViewerServer::clients_;
+size_t ViewerServer::ring_capacity_ = 64;
+double ViewerServer::max_frames_per_second_ = 0.0;
 struct lws_context* ViewerServer::context_;
-lws_protocols ViewerServer::protocols_[2];
+lws_protocols ViewerServer::protocols_[ViewerPacket::NB_ENCODINGS + 1];
 
 uint ViewerServer::instance_counter_ = 0;
 
@@ -40,37 +164,73 @@ void ViewerServer::run()
   sigemptyset(&set);
   assert(pthread_sigmask(SIG_SETMASK, &set, NULL) == 0);
   std::cout << "Thread viewer server STARTED" << std::endl;
+  std::vector<ViewerClientStats> stats;
   while (viewer::ViewerServer::running_)
   {
-    if (clients_.size() > 0)
-    {
-      viewer::ViewerDataGlobal::get().client_connected = true;
-      if (!ViewerDataGlobal::get().packets_to_send.empty())
-        lws_callback_on_writable(clients_.at(0));
-    }
-    else
+    dispatchPackets();
+
+    stats.clear();
+    for (ViewerClient* client : clients_)
     {
-      viewer::ViewerDataGlobal::get().client_connected = false;
+      if (!client->ring.empty())
+        lws_callback_on_writable(client->wsi);
+      client->stats.queued = client->ring.size();
+      stats.push_back(client->stats);
     }
+    viewer::ViewerDataGlobal::get().client_connected = (clients_.size() > 0);
+    viewer::ViewerDataGlobal::get().setClientsStats(stats);
+
     lws_service(viewer::ViewerServer::context_, 10);
   }
   std::cout << "Thread viewer server CLOSED" << std::endl;
 }
 
-ViewerServer::ViewerServer(int port) : thread_launched_(false)
+void ViewerServer::dispatchPackets()
 {
+  std::queue<ViewerPacket> packets = ViewerDataGlobal::get().packets_to_send.getAndclear();
+  double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  while (!packets.empty())
+  {
+    // serialized once, shared by all the clients.
+    std::shared_ptr<const ViewerPacket> packet = std::make_shared<const ViewerPacket>(std::move(packets.front()));
+    packets.pop();
+    for (ViewerClient* client : clients_)
+    {
+      client->push(packet, now);
+    }
+  }
+}
+
+ViewerServer::ViewerServer(int port, size_t ring_capacity, double max_frames_per_second) : thread_launched_(false)
+{
+  ring_capacity_ = ring_capacity;
+  max_frames_per_second_ = max_frames_per_second;
+
   // prevent an invalid second instanciation of the task.
   instance_counter_++;
   assert(instance_counter_ < 2);
 
   // Set the protocols
+  // the id of the protocol is the encoding used by the client.
   protocols_[0] = { "viewer_protocol",
                     rhoban_ssl::viewer::ViewerServer::callback_viewer,
                     sizeof(per_session_data_minimal),
                     6000,
-                    0,
+                    ViewerPacket::JSON,
                     nullptr };
-  protocols_[1] = { nullptr, nullptr, 0, 0, 0, nullptr };
+  protocols_[1] = { "viewer_protocol_binary",
+                    rhoban_ssl::viewer::ViewerServer::callback_viewer,
+                    sizeof(per_session_data_minimal),
+                    6000,
+                    ViewerPacket::PROTOBUF,
+                    nullptr };
+  protocols_[2] = { "viewer_protocol_delta",
+                    rhoban_ssl::viewer::ViewerServer::callback_viewer,
+                    sizeof(per_session_data_minimal),
+                    6000,
+                    ViewerPacket::PROTOBUF_DELTA,
+                    nullptr };
+  protocols_[3] = { nullptr, nullptr, 0, 0, 0, nullptr };
 
   struct lws_context_creation_info info;
   memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
@@ -110,36 +270,58 @@ int ViewerServer::callback_http_dummy(struct lws*, enum lws_callback_reasons, vo
   return 0;
 }
 
-int ViewerServer::callback_viewer(struct lws* wsi, enum lws_callback_reasons reason, void*, void* in, size_t)
+int ViewerServer::callback_viewer(struct lws* wsi, enum lws_callback_reasons reason, void* user, void* in,
+                                  size_t len)
 {
+  per_session_data_minimal* pss = static_cast<per_session_data_minimal*>(user);
   switch (reason)
   {
     case LWS_CALLBACK_ESTABLISHED:
-      ViewerServer::clients_.push_back(wsi);
+      pss->encoding = lws_get_protocol(wsi)->id;
+      pss->client = new ViewerClient(wsi, static_cast<ViewerPacket::Encoding>(pss->encoding), ring_capacity_,
+                                     max_frames_per_second_);
+      viewer::ViewerDataGlobal::get().clients_by_encoding[pss->encoding]++;
+      if (pss->encoding == ViewerPacket::PROTOBUF_DELTA)
+      {
+        // a new client knows nothing, it needs a full frame.
+        viewer::ViewerDataGlobal::get().keyframe_requested = true;
+      }
+      ViewerServer::clients_.push_back(pss->client);
       return 0;
     case LWS_CALLBACK_RECEIVE:
-      std::cout << (char*)in << std::endl;
-      viewer::ViewerDataGlobal::get().parseAndStorePacketFromClient((char*)in);
+      if (!pss->client->applySettings(static_cast<const char*>(in), len))
+        viewer::ViewerDataGlobal::get().parseAndStorePacketFromClient(static_cast<const char*>(in), len);
       return 0;
     case LWS_CALLBACK_SERVER_WRITEABLE:
     {
-      Json::Value packet = rhoban_ssl::viewer::ViewerDataGlobal::get().packets_to_send.pop();
-      Json::FastWriter writer = Json::FastWriter();
-      std::string str_json = writer.write(packet);
-      unsigned char packet_send[str_json.size() + LWS_PRE];
-      std::copy(str_json.begin(), str_json.end(), packet_send + LWS_PRE);
-
-      if (lws_send_pipe_choked(wsi) == 0)
+      ViewerClient& client = *pss->client;
+      if (client.ring.empty() || lws_send_pipe_choked(wsi) != 0)
       {
-        lws_write(wsi, &packet_send[LWS_PRE], str_json.size(), LWS_WRITE_TEXT);
+        // the packets stay in the ring, the oldest ones are dropped if the client stays slow.
+        break;
       }
+      std::shared_ptr<const ViewerPacket> packet = client.ring.front();
+      client.ring.popFront();
+
+      client.write_buffer.resize(packet->payload.size() + LWS_PRE);
+      std::copy(packet->payload.begin(), packet->payload.end(), client.write_buffer.begin() + LWS_PRE);
+      lws_write(wsi, &client.write_buffer[LWS_PRE], packet->payload.size(),
+                packet->encoding == ViewerPacket::JSON ? LWS_WRITE_TEXT : LWS_WRITE_BINARY);
+      client.stats.nb_packets_sent++;
+
+      if (!client.ring.empty())
+        lws_callback_on_writable(wsi);
     }
     break;
     case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
       break;
     case LWS_CALLBACK_CLOSED:
-      ViewerServer::clients_.erase(std::remove(ViewerServer::clients_.begin(), ViewerServer::clients_.end(), wsi),
-                                   ViewerServer::clients_.end());
+      viewer::ViewerDataGlobal::get().clients_by_encoding[pss->encoding]--;
+      ViewerServer::clients_.erase(
+          std::remove(ViewerServer::clients_.begin(), ViewerServer::clients_.end(), pss->client),
+          ViewerServer::clients_.end());
+      delete pss->client;
+      pss->client = nullptr;
       break;
     default:
       break;
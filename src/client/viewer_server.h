@@ -6,7 +6,19 @@
 #include <json/json.h>
 #include <vector>
 #include <thread_queue.h>
+#include <bounded_ring.h>
 #include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace rhoban_ssl
+{
+namespace viewer
+{
+struct ViewerClient;
+}  // namespace viewer
+}  // namespace rhoban_ssl
+
 /**
  * @brief The per_session_data__minimal struct
  *
@@ -17,12 +29,123 @@ struct per_session_data_minimal
   struct per_session_data_minimal* pss_list;
   struct lws* wsi;
   int last;
+  /**
+   * @brief Encoding negotiated by the client with the websocket protocol name.
+   * @see rhoban_ssl::viewer::ViewerPacket::Encoding
+   */
+  int encoding;
+  /**
+   * @brief Send ring and counters of the client (created when the connection is established).
+   */
+  rhoban_ssl::viewer::ViewerClient* client;
 };
 
 namespace rhoban_ssl
 {
 namespace viewer
 {
+/**
+ * @brief A packet ready to be written on the websocket.
+ *
+ * The payload is already serialized, either as json text or
+ * as a binary viewer_proto::AIPacket (full frame or delta).
+ */
+struct ViewerPacket
+{
+  enum Encoding
+  {
+    JSON = 0,
+    PROTOBUF = 1,
+    PROTOBUF_DELTA = 2,
+    NB_ENCODINGS
+  };
+
+  Encoding encoding;
+  std::string payload;
+
+  /**
+   * @brief True for the first packet of a frame (a frame is the set of packets
+   * serialized from one snapshot), the rate limits keep or skip whole frames.
+   */
+  bool frame_start;
+
+  /**
+   * @brief True for a delta keyframe, a delta client that lost a frame waits for one.
+   */
+  bool keyframe;
+
+  ViewerPacket();
+
+  /**
+   * @brief Builds a json text packet.
+   *
+   * This constructor is implicit to keep pushing Json::Value in the queue.
+   */
+  ViewerPacket(const Json::Value& packet);
+
+  ViewerPacket(Encoding encoding, std::string payload);
+};
+
+/**
+ * @brief Counters of a viewer client, copied by the server thread for the other threads.
+ */
+struct ViewerClientStats
+{
+  int encoding;
+  double max_frames_per_second;
+  unsigned long nb_packets_sent;
+  unsigned long nb_frames_skipped;
+  unsigned long nb_frames_dropped;
+  unsigned long nb_packets_dropped;
+  unsigned int queued;
+};
+
+/**
+ * @brief A connected viewer and its bounded send ring.
+ *
+ * All the clients share the same serialized packets, the ring only holds pointers.
+ * When the client is slower than the AI, the oldest packets are dropped.
+ *
+ * A client can limit its frame rate (max_frames_per_second, 0 means no limit):
+ * the frames that come too early are skipped as a whole.
+ * The rate limit is not applied to delta clients since a delta can't be skipped:
+ * when a delta client loses a packet, its ring is emptied and it waits for the next keyframe.
+ *
+ * It is only used by the server thread.
+ */
+struct ViewerClient
+{
+  struct lws* wsi;
+  ViewerPacket::Encoding encoding;
+  BoundedRing<std::shared_ptr<const ViewerPacket>> ring;
+  std::vector<unsigned char> write_buffer;
+
+  double max_frames_per_second;
+  double last_frame_time;
+  bool accepting_frame;
+  bool waiting_keyframe;
+
+  ViewerClientStats stats;
+
+  ViewerClient(struct lws* wsi, ViewerPacket::Encoding encoding, size_t ring_capacity,
+               double max_frames_per_second);
+
+  /**
+   * @brief Queues a packet if it is for this client and if the rate limit accepts its frame.
+   * @param packet the shared serialized packet
+   * @param now time in seconds
+   */
+  void push(const std::shared_ptr<const ViewerPacket>& packet, double now);
+
+  /**
+   * @brief Applies the settings sent by the client.
+   *
+   * The settings are a json object {"viewer_client": {"max_frames_per_second": 10}}.
+   * @return true if the message contained the settings (it is not given to the AI)
+   */
+  bool applySettings(const char* message, size_t len);
+};
+
 /**
  * @brief The ViewerDataGlobal class contains all the data exchanged between the monitor and the ia
  * in the form of json packets.
@@ -49,7 +172,7 @@ public:
   /**
    * @brief Store all packets that will be send to clients.
    */
-  ThreadQueue<Json::Value> packets_to_send;
+  ThreadQueue<ViewerPacket> packets_to_send;
 
   /**
    * @brief All packet received from the viewer.
@@ -61,11 +184,43 @@ public:
    */
   std::atomic<bool> client_connected;
 
+  /**
+   * @brief Number of connected clients for each encoding.
+   *
+   * Packets are only serialized for the encodings that have clients.
+   */
+  std::atomic<int> clients_by_encoding[ViewerPacket::NB_ENCODINGS];
+
+  /**
+   * @brief Returns true if at least one client uses the encoding.
+   */
+  bool hasClients(ViewerPacket::Encoding encoding) const;
+
+  /**
+   * @brief Set when a delta client connects or loses a packet: the next delta frame must be a keyframe.
+   */
+  std::atomic<bool> keyframe_requested;
+
+  /**
+   * @brief Returns the counters of the connected clients.
+   */
+  std::vector<ViewerClientStats> clientsStats();
+
+  /**
+   * @brief Updated by the server thread.
+   */
+  void setClientsStats(const std::vector<ViewerClientStats>& stats);
+
   /**
    * @brief Parse and add store a packet send by the viewer.
-   * @param packet_received in char*.
+   * @param packet_received in char*, not NUL terminated.
+   * @param len the size of the packet.
    */
-  void parseAndStorePacketFromClient(char* packet_received);
+  void parseAndStorePacketFromClient(const char* packet_received, size_t len);
+
+private:
+  std::mutex clients_stats_mutex_;
+  std::vector<ViewerClientStats> clients_stats_;
 };
 
 /**
@@ -76,7 +231,13 @@ public:
  * A thread is launch when the task in created and when the execution manager removes it
  * the thread is automatically close.
  *
- * Currently only one client is supported.
+ * Several clients can be connected, each one has its own bounded send ring
+ * (@see ViewerClient) filled by the server thread from packets_to_send.
+ *
+ * The client chooses the encoding with the websocket protocol name:
+ * "viewer_protocol" for json text packets (default), "viewer_protocol_binary"
+ * for protobuf packets (@see viewer_proto/ai_packet.proto) and "viewer_protocol_delta"
+ * for keyframes and deltas (@see viewer_proto/delta_packet.proto).
  *
  * Plus, due to the use of libwebsockets all the communication process
  * must be handle in a single thread.
@@ -89,6 +250,21 @@ private:
 
   std::thread* thread;
 
+  /**
+   * @brief Capacity in packets of the send ring of each client.
+   */
+  static size_t ring_capacity_;
+
+  /**
+   * @brief Default frame rate limit of the clients (0 means no limit).
+   */
+  static double max_frames_per_second_;
+
+  /**
+   * @brief Gives the packets waiting in packets_to_send to the clients.
+   */
+  void dispatchPackets();
+
   /**
    * @brief thread loop
    *
@@ -110,9 +286,9 @@ private:
    * @brief The protocols structure.
    *
    * Use for register all protocols.
-   * The tab is set to three because we have only three protocols registred.
+   * The last protocol is the terminator of the list.
    */
-  static struct lws_protocols protocols_[2];
+  static struct lws_protocols protocols_[ViewerPacket::NB_ENCODINGS + 1];
 
   /**
    * @brief The context structure
@@ -137,8 +313,10 @@ public:
   /**
    * @brief Create and initialize context, protocols and websocket.
    * @param port
+   * @param ring_capacity capacity in packets of the send ring of each client
+   * @param max_frames_per_second default frame rate limit of the clients (0 means no limit)
    */
-  ViewerServer(int port);
+  ViewerServer(int port, size_t ring_capacity = 64, double max_frames_per_second = 0.0);
 
   /**
    * @brief ~ViewerServer
@@ -150,7 +328,7 @@ public:
   /**
    * @brief All clients used.
    */
-  static std::vector<struct lws*> clients_;
+  static std::vector<ViewerClient*> clients_;
 
   /**
    * @brief A dummy callback because the libwebsocket doesn't start if the http is not handled.
@@ -173,7 +351,7 @@ public:
    * @param len Length set for some callback reasons
    * @return 0 Boolean to say the callback has success.
    */
-  static int callback_viewer(struct lws* wsi, enum lws_callback_reasons reason, void*, void* in, size_t);
+  static int callback_viewer(struct lws* wsi, enum lws_callback_reasons reason, void* user, void* in, size_t);
 };
 
 }  // namespace viewer